@@ -0,0 +1,203 @@
+//	Objective: To implement the option class that is defined in the header file: AmericanApproxOption.hpp
+//
+// (c) Sudhansh Dua
+
+#include "AmericanApproxOption.hpp"
+#include <string>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+
+void AmericanApproxOption::init()					// Initialising all the default values
+{
+	//	Default values
+	T = 1.0;
+	r = 0.05;
+	sig = 0.2;
+	K = 100;
+	S = 100;
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+	method = AmericanApproximation::BaroneAdesiWhaley;
+
+	type = OptionType::Put;			//	Put option as the default: an American call on a stock with b >= r is never exercised early
+
+	//	Empty cache: a NaN maturity matches no key
+	cacheT = numeric_limits<double>::quiet_NaN();
+	cacheR = cacheSig = cacheB = criticalRatio = 0.0;
+	cacheType = type;
+}
+
+void AmericanApproxOption::copy(const AmericanApproxOption& option)
+{
+	method = option.method;
+
+	cacheT = option.cacheT;
+	cacheR = option.cacheR;
+	cacheSig = option.cacheSig;
+	cacheB = option.cacheB;
+	cacheType = option.cacheType;
+	criticalRatio = option.criticalRatio;
+}
+
+//	Constructors and destructor
+//	Default Constructor
+AmericanApproxOption::AmericanApproxOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+AmericanApproxOption::AmericanApproxOption(const AmericanApproxOption& option) : Option(option)
+{
+	copy(option);
+}
+
+//	Constructor that accepts values
+AmericanApproxOption::AmericanApproxOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const AmericanApproximation method1, const OptionType type1)
+	: Option(S1, K1, T1, r1, sig1, b1, type1), cacheT(numeric_limits<double>::quiet_NaN()), cacheR(0.0), cacheSig(0.0), cacheB(0.0),
+	cacheType(type1), criticalRatio(0.0), method(method1) {}
+
+//	Constructor that parses the option type from a string
+AmericanApproxOption::AmericanApproxOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const AmericanApproximation method1, const string& type1)
+	: AmericanApproxOption(S1, K1, T1, r1, sig1, b1, method1, ParseOptionType(type1)) {}
+
+//	Destructor
+AmericanApproxOption::~AmericanApproxOption() {}
+
+
+//	Assignment Operator
+AmericanApproxOption& AmericanApproxOption::operator = (const AmericanApproxOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	copy(option);
+	return *this;
+}
+
+
+//	Critical price cache
+double AmericanApproxOption::CriticalRatio() const
+{
+	if (!(cacheT == T && cacheR == r && cacheSig == sig && cacheB == b && cacheType == type))
+	{
+		criticalRatio = (type == OptionType::Call) ? BaroneAdesiWhaleyCritical<Call>(1.0, T, r, sig, b)
+			: BaroneAdesiWhaleyCritical<Put>(1.0, T, r, sig, b);
+		cacheT = T;
+		cacheR = r;
+		cacheSig = sig;
+		cacheB = b;
+		cacheType = type;
+	}
+	return criticalRatio;
+}
+
+
+// Functions that calculate the option price
+double AmericanApproxOption::Price() const
+{
+	if (method == AmericanApproximation::BjerksundStensland)
+	{
+		return AmericanApproxPrice(S, K, T, r, sig, b, type, method);
+	}
+
+	double critical = K * CriticalRatio();
+	return (type == OptionType::Call) ? BaroneAdesiWhaleyPrice<Call>(S, K, T, r, sig, b, critical)
+		: BaroneAdesiWhaleyPrice<Put>(S, K, T, r, sig, b, critical);
+}
+
+double AmericanApproxOption::CriticalPrice() const
+{
+	if (method == AmericanApproximation::BaroneAdesiWhaley)
+	{
+		return K * CriticalRatio();
+	}
+
+	//	Bjerksund-Stensland: the boundary I2 that applies at the start; for puts that of the transformed call
+	double beta, I1, I2;
+	if (type == OptionType::Call)
+	{
+		if (!EarlyExercise<Call>(r, b))
+		{
+			return numeric_limits<double>::infinity();
+		}
+		BjerksundStenslandBoundaries(K, T, r, sig, b, beta, I1, I2);
+		return I2;
+	}
+
+	if (!EarlyExercise<Put>(r, b))
+	{
+		return 0.0;
+	}
+	BjerksundStenslandBoundaries(K, T, r - b, sig, -b, beta, I1, I2);
+	return K * K / I2;
+}
+
+//	Price and sensitivities in one pass of the kernel on dual numbers (the Newton solve included)
+OptionGreeks AmericanApproxOption::Greeks() const
+{
+	return AutoGreeks([this](const GreeksDual& S1, const GreeksDual& T1, const GreeksDual& r1, const GreeksDual& sig1, const GreeksDual& b1)
+	{
+		if (method == AmericanApproximation::BjerksundStensland)
+		{
+			return (type == OptionType::Call) ? BjerksundStenslandPrice<Call>(S1, GreeksDual(K), T1, r1, sig1, b1)
+				: BjerksundStenslandPrice<Put>(S1, GreeksDual(K), T1, r1, sig1, b1);
+		}
+		return (type == OptionType::Call) ? BaroneAdesiWhaleyPrice<Call>(S1, GreeksDual(K), T1, r1, sig1, b1)
+			: BaroneAdesiWhaleyPrice<Put>(S1, GreeksDual(K), T1, r1, sig1, b1);
+	}, S, T, r, sig, b);
+}
+
+
+// Modifier functions
+void AmericanApproxOption::toggle()								//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+
+// Global Functions
+double AmericanApproxPrice(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const OptionType type, const AmericanApproximation method)
+{
+	if (method == AmericanApproximation::BjerksundStensland)
+	{
+		return (type == OptionType::Call) ? BjerksundStenslandPrice<Call>(S, K, T, r, sig, b) : BjerksundStenslandPrice<Put>(S, K, T, r, sig, b);
+	}
+	return (type == OptionType::Call) ? BaroneAdesiWhaleyPrice<Call>(S, K, T, r, sig, b) : BaroneAdesiWhaleyPrice<Put>(S, K, T, r, sig, b);
+}
+
+
+void BatchAmericanApprox(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, const size_t n, const AmericanApproximation method)
+{
+	if (method == AmericanApproximation::BjerksundStensland)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			price[i] = (isCall[i] != 0) ? BjerksundStenslandPrice<Call>(S[i], K[i], T[i], r[i], sig[i], b[i])
+				: BjerksundStenslandPrice<Put>(S[i], K[i], T[i], r[i], sig[i], b[i]);
+		}
+		return;
+	}
+
+	//	Critical price / K of the current run of contracts
+	double ratio = 0.0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		bool call = (isCall[i] != 0);
+		if (i == 0 || T[i] != T[i - 1] || r[i] != r[i - 1] || sig[i] != sig[i - 1] || b[i] != b[i - 1] || call != (isCall[i - 1] != 0))
+		{
+			ratio = call ? BaroneAdesiWhaleyCritical<Call>(1.0, T[i], r[i], sig[i], b[i]) : BaroneAdesiWhaleyCritical<Put>(1.0, T[i], r[i], sig[i], b[i]);
+		}
+
+		price[i] = call ? BaroneAdesiWhaleyPrice<Call>(S[i], K[i], T[i], r[i], sig[i], b[i], K[i] * ratio)
+			: BaroneAdesiWhaleyPrice<Put>(S[i], K[i], T[i], r[i], sig[i], b[i], K[i] * ratio);
+	}
+}
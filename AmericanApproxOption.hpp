@@ -0,0 +1,278 @@
+// Class that represents finite-maturity American options, priced by analytic approximations
+//
+// (c) Sudhansh Dua
+//
+//	Two closed-form approximations, fast enough to quote a whole American chain in microseconds:
+//	->	Barone-Adesi & Whaley (1987): the early exercise premium solves an approximate (quadratic) form of the
+//		Black-Scholes-Merton equation; the critical price S* above (calls) or below (puts) which the option is
+//		exercised is the root of a non-linear equation, found by Newton's method.
+//	->	Bjerksund & Stensland (2002): the value of exercising at a flat boundary over [0, t1] and another over [t1, T],
+//		with t1 = (sqrt(5) - 1) T / 2; in closed form with the bivariate normal distribution. More accurate than
+//		Barone-Adesi & Whaley for long maturities, and free of iterations.
+//	Both reduce to the European price when early exercise is never optimal (calls with b >= r, puts with r <= 0), and
+//	to the perpetual price (PerpetualAmericanOption) as T grows; for Bjerksund-Stensland only if the carry of the call
+//	(-b for puts, by the put-call transformation) is not negative, as its boundaries collapse once
+//	T > (2 sig / b)^2 otherwise (about 180 years at b = -3%, sig = 20%).
+//
+//	The critical price is homogeneous in the strike, S*(K) = K S*(1), so it is cached as the ratio S* / K, keyed on
+//	(T, r, sig, b, type): an option object solves it once and reprices for new spots (and strikes) without iterating,
+//	and BatchAmericanApprox solves it once for every run of contracts that share the key, e.g. an option chain.
+
+
+#ifndef AmericanApproxOption_HPP
+#define AmericanApproxOption_HPP
+
+#include "Option.hpp"
+#include <cstddef>
+#include <limits>
+#include <string>
+using namespace std;
+
+
+enum class AmericanApproximation { BaroneAdesiWhaley, BjerksundStensland };
+
+
+class AmericanApproxOption : public Option
+{
+private:
+	void init();											// Initialise all default values
+	void copy(const AmericanApproxOption& option);			//	copies all values
+
+	//	Barone-Adesi-Whaley critical price / K, and the (T, r, sig, b, type) it was solved for
+	mutable double cacheT, cacheR, cacheSig, cacheB;
+	mutable OptionType cacheType;
+	mutable double criticalRatio;
+
+	double CriticalRatio() const;							//	from the cache, solving on a miss
+
+public:
+	//	Member data
+	AmericanApproximation method;
+
+
+	//	Constructors and the destructor
+	AmericanApproxOption();												//	default constructor
+	AmericanApproxOption(const AmericanApproxOption& option);						//	Copy constructor
+	AmericanApproxOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+		const double& b1, const AmericanApproximation method1, const OptionType type1);	//	constructor that accepts values
+	AmericanApproxOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+		const double& b1, const AmericanApproximation method1, const string& type1);	//	"C" - call option, "P" - put option
+	~AmericanApproxOption();												//	destructor
+
+
+	//	Assignment operator
+	AmericanApproxOption& operator = (const AmericanApproxOption& option);
+
+
+	// Functions that calculate the option price
+	//	Price() updates the cache, so one object must not be priced from two threads at once
+	//	(PortfolioPricer prices every product on a single thread).
+	double Price() const;
+	double CriticalPrice() const;		//	spot at which immediate exercise becomes optimal (+inf / 0 if never)
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+
+//	Whether early exercise can be optimal: for calls if b < r, for puts if r > 0
+template <class Type, class Real>
+inline bool EarlyExercise(const Real& r, const Real& b)
+{
+	return (Type::type == OptionType::Call) ? (Value(b) < Value(r)) : (Value(r) > 0.0);
+}
+
+
+//	Barone-Adesi-Whaley critical price by Newton's method, from their starting value. The iteration stops one step after
+//	|f(S*)| < 1e-12 K, so that on dual numbers the derivatives are those of the exact root (implicit function theorem).
+template <class Type, class Real>
+inline Real BaroneAdesiWhaleyCritical(const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	const double phi = Type::phi;
+	if (!EarlyExercise<Type>(r, b))
+	{
+		return (phi > 0.0) ? Real(numeric_limits<double>::infinity()) : Real(0.0);
+	}
+
+	Real v2 = sig * sig;
+	Real sigSqrtT = sig * sqrt(T);
+	Real n = 2.0 * b / v2;
+	Real m = 2.0 * r / v2;
+	Real carry = exp((b - r) * T);
+	Real q = 0.5 * (-(n - 1.0) + phi * sqrt((n - 1.0) * (n - 1.0) + 4.0 * m / (1.0 - exp(-r * T))));
+
+	//	Starting value: between the strike and the perpetual critical price (h > 0 only for very long maturities, where
+	//	the perpetual price itself is the better start)
+	Real qInf = 0.5 * (-(n - 1.0) + phi * sqrt((n - 1.0) * (n - 1.0) + 4.0 * m));
+	Real sInf = K / (1.0 - 1.0 / qInf);
+	Real h = -(b * T + 2.0 * phi * sigSqrtT) * K / (sInf - K);
+	Real s = (h < 0.0) ? K + (sInf - K) * (1.0 - exp(h)) : sInf;
+
+	//	f(s) = phi (s - K) - European(s) - phi (1 - carry N(phi d1)) s / q
+	for (int i = 0; i < 100; ++i)
+	{
+		Real d1 = (log(s / K) + (b + 0.5 * v2) * T) / sigSqrtT;
+		Real Nd1 = Numerics::NormalCdf(phi * d1);
+		Real f = phi * (s - K) - VanillaPrice<Type>(s, K, T, r, sig, b) - phi * (1.0 - carry * Nd1) * s / q;
+		Real slope = phi - (phi * carry * Nd1 * (1.0 - 1.0 / q) + phi / q - carry * Numerics::NormalPdf(d1) / (q * sigSqrtT));
+
+		s = s - f / slope;
+		if (fabs(Value(f)) < 1e-12 * Value(K))
+		{
+			break;
+		}
+	}
+	return s;
+}
+
+//	Barone-Adesi-Whaley price for a given critical price
+template <class Type, class Real>
+inline Real BaroneAdesiWhaleyPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b,
+	const Real& critical)
+{
+	const double phi = Type::phi;
+	if (!EarlyExercise<Type>(r, b))
+	{
+		return VanillaPrice<Type>(S, K, T, r, sig, b);
+	}
+	if (phi * (S - critical) >= 0.0)
+	{
+		return phi * (S - K);			//	exercise
+	}
+
+	Real v2 = sig * sig;
+	Real n = 2.0 * b / v2;
+	Real m = 2.0 * r / v2;
+	Real q = 0.5 * (-(n - 1.0) + phi * sqrt((n - 1.0) * (n - 1.0) + 4.0 * m / (1.0 - exp(-r * T))));
+	Real d1 = (log(critical / K) + (b + 0.5 * v2) * T) / (sig * sqrt(T));
+	Real A = phi * (critical / q) * (1.0 - exp((b - r) * T) * Numerics::NormalCdf(phi * d1));
+
+	return VanillaPrice<Type>(S, K, T, r, sig, b) + A * pow(S / critical, q);
+}
+
+template <class Type, class Real>
+inline Real BaroneAdesiWhaleyPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	return BaroneAdesiWhaleyPrice<Type>(S, K, T, r, sig, b, BaroneAdesiWhaleyCritical<Type>(K, T, r, sig, b));
+}
+
+
+//	Bjerksund-Stensland building blocks: the value of a claim of S^gamma up to time T, knocked out at the flat boundary
+//	I (phi), and the same with the boundary I1 up to t1 and I2 from t1 to T (psi)
+template <class Real>
+inline Real BjerksundStenslandPhi(const Real& S, const Real& T, const Real& gamma, const Real& H, const Real& I, const Real& r,
+	const Real& sig, const Real& b)
+{
+	Real v2 = sig * sig;
+	Real sigSqrtT = sig * sqrt(T);
+	Real lambda = -r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2;
+	Real kappa = 2.0 * b / v2 + (2.0 * gamma - 1.0);
+	Real d = -(log(S / H) + (b + (gamma - 0.5) * v2) * T) / sigSqrtT;
+
+	return exp(lambda * T) * pow(S, gamma) * (Numerics::NormalCdf(d) - pow(I / S, kappa) * Numerics::NormalCdf(d - 2.0 * log(I / S) / sigSqrtT));
+}
+
+template <class Real>
+inline Real BjerksundStenslandPsi(const Real& S, const Real& T, const Real& gamma, const Real& H, const Real& I2, const Real& I1,
+	const Real& t1, const Real& r, const Real& sig, const Real& b, const double rho)
+{
+	Real v2 = sig * sig;
+	Real sigSqrtT = sig * sqrt(T);
+	Real sigSqrtT1 = sig * sqrt(t1);
+	Real mu = b + (gamma - 0.5) * v2;
+	Real lambda = -r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2;
+	Real kappa = 2.0 * b / v2 + (2.0 * gamma - 1.0);
+
+	Real e1 = (log(S / I1) + mu * t1) / sigSqrtT1;
+	Real e2 = (log(I2 * I2 / (S * I1)) + mu * t1) / sigSqrtT1;
+	Real e3 = (log(S / I1) - mu * t1) / sigSqrtT1;
+	Real e4 = (log(I2 * I2 / (S * I1)) - mu * t1) / sigSqrtT1;
+
+	Real f1 = (log(S / H) + mu * T) / sigSqrtT;
+	Real f2 = (log(I2 * I2 / (S * H)) + mu * T) / sigSqrtT;
+	Real f3 = (log(I1 * I1 / (S * H)) + mu * T) / sigSqrtT;
+	Real f4 = (log(S * I1 * I1 / (H * I2 * I2)) + mu * T) / sigSqrtT;
+
+	using Numerics::BivariateNormalCdf;
+	return exp(lambda * T) * pow(S, gamma) * (BivariateNormalCdf(-e1, -f1, rho) - pow(I2 / S, kappa) * BivariateNormalCdf(-e2, -f2, rho)
+		- pow(I1 / S, kappa) * BivariateNormalCdf(-e3, -f3, -rho) + pow(I1 / I2, kappa) * BivariateNormalCdf(-e4, -f4, -rho));
+}
+
+//	Exercise boundaries of the call: I1 over [0, t1] and I2 over [t1, T]
+template <class Real>
+inline void BjerksundStenslandBoundaries(const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b,
+	Real& beta, Real& I1, Real& I2)
+{
+	Real v2 = sig * sig;
+	Real t1 = 0.5 * (sqrt(5.0) - 1.0) * T;
+
+	beta = (0.5 - b / v2) + sqrt((b / v2 - 0.5) * (b / v2 - 0.5) + 2.0 * r / v2);
+	Real BInf = beta / (beta - 1.0) * K;
+	Real B0 = (r / (r - b) * K > K) ? r / (r - b) * K : K;
+
+	Real h1 = -(b * t1 + 2.0 * sig * sqrt(t1)) * K * K / ((BInf - B0) * B0);
+	Real h2 = -(b * T + 2.0 * sig * sqrt(T)) * K * K / ((BInf - B0) * B0);
+	I1 = B0 + (BInf - B0) * (1.0 - exp(h1));
+	I2 = B0 + (BInf - B0) * (1.0 - exp(h2));
+}
+
+template <class Real>
+inline Real BjerksundStenslandCall(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	if (!EarlyExercise<Call>(r, b))
+	{
+		return VanillaPrice<Call>(S, K, T, r, sig, b);
+	}
+
+	Real beta, I1, I2;
+	BjerksundStenslandBoundaries(K, T, r, sig, b, beta, I1, I2);
+	if (S >= I2)
+	{
+		return S - K;				//	exercise
+	}
+
+	const double rho = sqrt(0.5 * (sqrt(5.0) - 1.0));		//	sqrt(t1 / T)
+	Real t1 = 0.5 * (sqrt(5.0) - 1.0) * T;
+	Real alpha1 = (I1 - K) * pow(I1, -beta);
+	Real alpha2 = (I2 - K) * pow(I2, -beta);
+	Real one(1.0), zero(0.0);
+
+	return alpha2 * pow(S, beta) - alpha2 * BjerksundStenslandPhi(S, t1, beta, I2, I2, r, sig, b)
+		+ BjerksundStenslandPhi(S, t1, one, I2, I2, r, sig, b) - BjerksundStenslandPhi(S, t1, one, I1, I2, r, sig, b)
+		- K * BjerksundStenslandPhi(S, t1, zero, I2, I2, r, sig, b) + K * BjerksundStenslandPhi(S, t1, zero, I1, I2, r, sig, b)
+		+ alpha1 * BjerksundStenslandPhi(S, t1, beta, I1, I2, r, sig, b) - alpha1 * BjerksundStenslandPsi(S, T, beta, I1, I2, I1, t1, r, sig, b, rho)
+		+ BjerksundStenslandPsi(S, T, one, I1, I2, I1, t1, r, sig, b, rho) - BjerksundStenslandPsi(S, T, one, K, I2, I1, t1, r, sig, b, rho)
+		- K * BjerksundStenslandPsi(S, T, zero, I1, I2, I1, t1, r, sig, b, rho) + K * BjerksundStenslandPsi(S, T, zero, K, I2, I1, t1, r, sig, b, rho);
+}
+
+//	Compile-time kernel: BjerksundStenslandPrice<Call> or <Put>. Puts are priced by the put-call transformation
+//	P(S, K, T, r, sig, b) = C(K, S, T, r - b, sig, -b).
+template <class Type, class Real>
+inline Real BjerksundStenslandPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	if constexpr (Type::type == OptionType::Call)
+	{
+		return BjerksundStenslandCall(S, K, T, r, sig, b);
+	}
+	else
+	{
+		return BjerksundStenslandCall(K, S, T, r - b, sig, -b);
+	}
+}
+
+
+//	Price by the given approximation
+double AmericanApproxPrice(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const OptionType type, const AmericanApproximation method);
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call. For
+//	Barone-Adesi-Whaley the critical price is solved once for each run of consecutive contracts with the same
+//	(T, r, sig, b, type), so a chain sorted by expiry costs one Newton solve per expiry.
+void BatchAmericanApprox(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, const size_t n, const AmericanApproximation method);
+
+#endif
@@ -0,0 +1,267 @@
+//	Objective: To implement the option class that is defined in the header file: AmericanOption.hpp
+//
+// (c) Sudhansh Dua
+
+#include "AmericanOption.hpp"
+#include "Numerics.hpp"
+#include <string>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace Numerics;
+
+
+void AmericanOption::init()					// Initialising all the default values
+{
+	//	Default values
+	T = 1.0;
+	r = 0.05;
+	sig = 0.2;
+	K = 100;
+	S = 100;
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+
+	type = OptionType::Put;			//	Put option as the default: an American call on a stock with b >= r is never exercised early
+
+}
+
+//	Constructors and destructor
+//	Default Constructor
+AmericanOption::AmericanOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+AmericanOption::AmericanOption(const AmericanOption& option) : Option(option) {}
+
+//	Constructor that accepts values
+AmericanOption::AmericanOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const OptionType type1) : Option(S1, K1, T1, r1, sig1, b1, type1) {}
+
+//	Constructor that parses the option type from a string
+AmericanOption::AmericanOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const string& type1)
+	: AmericanOption(S1, K1, T1, r1, sig1, b1, ParseOptionType(type1)) {}
+
+//	Destructor
+AmericanOption::~AmericanOption() {}
+
+
+//	Assignment Operator
+AmericanOption& AmericanOption::operator = (const AmericanOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	return *this;
+}
+
+
+// Functions that calculate the option price
+double AmericanOption::Price() const
+{
+	return AmericanPDE(S, K, T, r, sig, b, type, FiniteDifferenceSettings()).Price;
+}
+
+FiniteDifferenceResult AmericanOption::Price(const FiniteDifferenceSettings& settings) const
+{
+	return AmericanPDE(S, K, T, r, sig, b, type, settings);
+}
+
+LatticeResult AmericanOption::Price(const LatticeSettings& settings) const
+{
+	return LatticePrice(S, K, T, r, sig, b, type, ExerciseType::American, settings);
+}
+
+
+// Modifier functions
+void AmericanOption::toggle()								//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+
+// Global Functions
+
+//	Contracts solved together, one per lane of the vectorised loops
+static const size_t Lanes = 16;
+
+//	Solves lanes [0, m) of the arrays; the lanes from m to Lanes repeat contract 0 and their results are dropped.
+//	work holds 5 (M + 1) Lanes doubles. Every array below is laid out as [node j][lane].
+OPTION_TARGET_CLONES
+static void SolveBlock(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, double* delta, double* gamma, double* theta, const size_t m,
+	const size_t M, const size_t N, const size_t R, const double width, double* work)
+{
+	const size_t c = M / 2;			//	node of the spot
+
+	double* V = work;								//	option values
+	double* payoff = V + (M + 1) * Lanes;			//	exercise values
+	double* rp = payoff + (M + 1) * Lanes;			//	eliminated right-hand side
+	double* invd = rp + (M + 1) * Lanes;			//	1 / eliminated diagonal
+	double* e = invd + (M + 1) * Lanes;				//	elimination factor
+
+	//	Lane parameters
+	double s0[Lanes], k[Lanes], phi[Lanes], dir[Lanes], dx[Lanes], dt[Lanes], rr[Lanes], carry[Lanes];
+	double alpha[Lanes], beta[Lanes], gam[Lanes], l[Lanes], xLow[Lanes];
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < Lanes; ++i)
+	{
+		size_t q = (i < m) ? i : 0;
+		double sq = sig[q] * FastSqrt(T[q]);
+
+		s0[i] = S[q];
+		k[i] = K[q];
+		rr[i] = r[q];
+		carry[i] = b[q];
+		phi[i] = (isCall[q] != 0) ? 1.0 : -1.0;
+		dir[i] = -phi[i];							//	x increases along the grid for puts and decreases for calls
+		dx[i] = 2.0 * width * sq / static_cast<double>(M);
+		dt[i] = T[q] / static_cast<double>(N);
+
+		double a = 0.5 * sig[q] * sig[q];
+		double mu = dir[i] * (b[q] - a);
+		alpha[i] = a / (dx[i] * dx[i]) - mu / (2.0 * dx[i]);
+		gam[i] = a / (dx[i] * dx[i]) + mu / (2.0 * dx[i]);
+		beta[i] = -2.0 * a / (dx[i] * dx[i]) - r[q];
+
+		l[i] = -0.5 * dt[i] * alpha[i];
+		xLow[i] = FastLog(S[q]) - dir[i] * static_cast<double>(c) * dx[i];
+	}
+
+	//	Payoff, which is also the value at expiry
+	for (size_t j = 0; j <= M; ++j)
+	{
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < Lanes; ++i)
+		{
+			double s = FastExp(xLow[i] + dir[i] * static_cast<double>(j) * dx[i]);
+			double p = phi[i] * (s - k[i]);
+			payoff[j * Lanes + i] = (p > 0.0) ? p : 0.0;
+			V[j * Lanes + i] = payoff[j * Lanes + i];
+			rp[j * Lanes + i] = 0.0;
+		}
+	}
+
+	//	A Crank-Nicolson step and an implicit Euler half step solve the same system (I - (dt / 2) L) V = rhs and differ
+	//	only in the right-hand side, so one elimination from the top of the grid serves both:
+	//		d'(M-1) = d,	d'(j) = d - u l / d'(j+1),	e(j) = u / d'(j+1)
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < Lanes; ++i)
+	{
+		invd[(M - 1) * Lanes + i] = 1.0 / (1.0 - 0.5 * dt[i] * beta[i]);
+		e[(M - 1) * Lanes + i] = 0.0;
+	}
+	for (size_t j = M - 2; j >= 1; --j)
+	{
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < Lanes; ++i)
+		{
+			double u = -0.5 * dt[i] * gam[i];
+			e[j * Lanes + i] = u * invd[(j + 1) * Lanes + i];
+			invd[j * Lanes + i] = 1.0 / ((1.0 - 0.5 * dt[i] * beta[i]) - e[j * Lanes + i] * l[i]);
+		}
+	}
+
+	//	Time stepping: 2R implicit Euler half steps, then N - R Crank-Nicolson steps
+	const size_t R1 = (R < N) ? R : N;
+	const size_t substeps = 2 * R1 + (N - R1);
+
+	double tau = 0.0;
+	double last[Lanes], h[Lanes];
+	for (size_t step = 0; step < substeps; ++step)
+	{
+		const bool implicit = (step < 2 * R1);
+		const double fraction = implicit ? 0.5 : 1.0;
+		const double explicitWeight = implicit ? 0.0 : 0.5;
+
+		tau += fraction;
+
+		//	Right-hand side and its elimination, from the top down (V(M) = 0: far out of the money)
+		for (size_t j = M - 1; j >= 1; --j)
+		{
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < Lanes; ++i)
+			{
+				double v = V[j * Lanes + i];
+				double lv = alpha[i] * V[(j - 1) * Lanes + i] + beta[i] * v + gam[i] * V[(j + 1) * Lanes + i];
+				double rhs = v + explicitWeight * dt[i] * lv;
+				rp[j * Lanes + i] = rhs - e[j * Lanes + i] * rp[(j + 1) * Lanes + i];
+			}
+		}
+
+		//	Deep in the money: the larger of exercise and the European value
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < Lanes; ++i)
+		{
+			double t = tau * dt[i];
+			double s = FastExp(xLow[i]);
+			double european = phi[i] * (s * FastExp((carry[i] - rr[i]) * t) - k[i] * FastExp(-rr[i] * t));
+			last[i] = V[c * Lanes + i];
+			h[i] = fraction * dt[i];
+			V[i] = (european > payoff[i]) ? european : payoff[i];
+			V[M * Lanes + i] = 0.0;
+		}
+
+		//	Back substitution from the exercise boundary outward (Brennan-Schwartz)
+		for (size_t j = 1; j < M; ++j)
+		{
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < Lanes; ++i)
+			{
+				double v = (rp[j * Lanes + i] - l[i] * V[(j - 1) * Lanes + i]) * invd[j * Lanes + i];
+				double ex = payoff[j * Lanes + i];
+				V[j * Lanes + i] = (v > ex) ? v : ex;
+			}
+		}
+	}
+
+	//	Greeks from the nodes around the spot
+	for (size_t i = 0; i < m; ++i)
+	{
+		double vm = V[(c - 1) * Lanes + i];
+		double v0 = V[c * Lanes + i];
+		double vp = V[(c + 1) * Lanes + i];
+
+		double vx = dir[i] * (vp - vm) / (2.0 * dx[i]);
+		double vxx = (vp - 2.0 * v0 + vm) / (dx[i] * dx[i]);
+
+		price[i] = v0;
+		delta[i] = vx / s0[i];
+		gamma[i] = (vxx - vx) / (s0[i] * s0[i]);
+		theta[i] = -(v0 - last[i]) / h[i];
+	}
+}
+
+
+void BatchAmericanPDE(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, double* delta, double* gamma, double* theta, const size_t n,
+	const FiniteDifferenceSettings& settings)
+{
+	const size_t M = (settings.SpaceSteps < 4) ? 4 : settings.SpaceSteps + (settings.SpaceSteps % 2);
+	const size_t N = (settings.TimeSteps < 1) ? 1 : settings.TimeSteps;
+
+	vector<double> work(5 * (M + 1) * Lanes);
+	for (size_t start = 0; start < n; start += Lanes)
+	{
+		const size_t m = (n - start < Lanes) ? n - start : Lanes;
+		SolveBlock(S + start, K + start, T + start, r + start, sig + start, b + start, isCall + start, price + start,
+			delta + start, gamma + start, theta + start, m, M, N, settings.RannacherSteps, settings.Width, work.data());
+	}
+}
+
+
+FiniteDifferenceResult AmericanPDE(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const OptionType type, const FiniteDifferenceSettings& settings)
+{
+	FiniteDifferenceResult result;
+	const int isCall = (type == OptionType::Call) ? 1 : 0;
+
+	BatchAmericanPDE(&S, &K, &T, &r, &sig, &b, &isCall, &result.Price, &result.Delta, &result.Gamma, &result.Theta, 1, settings);
+	return result;
+}
@@ -0,0 +1,96 @@
+// Class that represents finite-maturity American options, priced by finite differences
+//
+// (c) Sudhansh Dua
+//
+//	The Black-Scholes-Merton equation is solved backwards from expiry on a uniform grid in x = log(S), centred on the
+//	current spot, where its coefficients are constant:
+//		V_tau = (sig^2 / 2) V_xx + (b - sig^2 / 2) V_x - r V,	tau = time to expiry
+//	->	Crank-Nicolson time steps, with Rannacher start-up: the first steps are replaced by two implicit Euler
+//		half steps each, which damps the oscillations caused by the kink of the payoff
+//	->	early exercise by the Brennan & Schwartz (1977) method: the tridiagonal system is eliminated from the
+//		out-of-the-money end, and the back substitution runs from the exercise boundary outward, taking
+//		max(continuation, exercise) at every node. For a single exercise region at one end of the grid this solves
+//		the linear complementarity problem exactly, with no iteration (unlike projected SOR).
+//	->	calls are solved on the mirrored grid (x decreasing), so that for calls and puts alike the exercise region
+//		is at the start of the grid and one code path serves both
+//	Price, delta and gamma are read from the three nodes around the spot, and theta from the last time step.
+//
+//	BatchAmericanPDE solves many contracts at once: the contracts are the lanes of the inner, vectorised loop of
+//	every Thomas sweep, with their own grid spacing, time step and coefficients.
+
+
+#ifndef AmericanOption_HPP
+#define AmericanOption_HPP
+
+#include "Option.hpp"
+#include "Lattice.hpp"
+#include <cstddef>
+#include <string>
+using namespace std;
+
+
+//	Grid of the finite-difference engine: the error falls as (1 / SpaceSteps)^2 + (1 / TimeSteps)^2
+struct FiniteDifferenceSettings
+{
+	size_t SpaceSteps;			//	intervals in log(S); rounded up to an even number so that the spot is a node
+	size_t TimeSteps;			//	Crank-Nicolson steps to expiry
+	size_t RannacherSteps;		//	initial steps replaced by two implicit Euler half steps each
+	double Width;				//	the grid spans log(S) +/- Width * sig * sqrt(T)
+
+	FiniteDifferenceSettings() : SpaceSteps(400), TimeSteps(200), RannacherSteps(2), Width(5.0) {}
+};
+
+
+struct FiniteDifferenceResult
+{
+	double Price;
+	double Delta;
+	double Gamma;
+	double Theta;
+};
+
+
+class AmericanOption : public Option
+{
+private:
+	void init();											// Initialise all default values
+
+public:
+	//	Constructors and the destructor
+	AmericanOption();												//	default constructor
+	AmericanOption(const AmericanOption& option);						//	Copy constructor
+	AmericanOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);	//	constructor that accepts values
+	AmericanOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);	//	"C" - call option, "P" - put option
+	~AmericanOption();												//	destructor
+
+
+	//	Assignment operator
+	AmericanOption& operator = (const AmericanOption& option);
+
+
+	// Functions that calculate the option price
+	double Price() const;													//	on the default grid
+	FiniteDifferenceResult Price(const FiniteDifferenceSettings& settings) const;	//	price, delta, gamma and theta
+	LatticeResult Price(const LatticeSettings& settings) const;					//	the same on a tree (Lattice.hpp)
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+
+//	One contract; see BatchAmericanPDE
+FiniteDifferenceResult AmericanPDE(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const OptionType type, const FiniteDifferenceSettings& settings);
+
+//	Batch form with structure-of-arrays inputs and outputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a
+//	call. All contracts share the grid settings. The work space is allocated once per call.
+void BatchAmericanPDE(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, double* delta, double* gamma, double* theta, const size_t n,
+	const FiniteDifferenceSettings& settings);
+
+#endif
@@ -0,0 +1,233 @@
+//	Objective: To implement the option class that is defined in the header file: AsianArithmeticOption.hpp
+//
+// (c) Sudhansh Dua
+
+#include "AsianArithmeticOption.hpp"
+#include "AsianGeometricOption.hpp"
+#include "Numerics.hpp"
+#include <string>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace Numerics;
+
+
+void AsianArithmeticOption::init()					// Initialising all the default values
+{
+	//	Default values
+	T = 1.0;
+	r = 0.05;
+	sig = 0.2;
+	K = 100;
+	S = 100;
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+	fixings = 12;		//	monthly fixings
+
+	type = OptionType::Call;			//	Call option as the default
+
+}
+
+void AsianArithmeticOption::copy(const AsianArithmeticOption& option)
+{
+	fixings = option.fixings;
+}
+
+//	Constructors and destructor
+//	Default Constructor
+AsianArithmeticOption::AsianArithmeticOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+AsianArithmeticOption::AsianArithmeticOption(const AsianArithmeticOption& option) : Option(option)
+{
+	copy(option);
+}
+
+//	Constructor that accepts values
+AsianArithmeticOption::AsianArithmeticOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const size_t fixings1, const OptionType type1) : Option(S1, K1, T1, r1, sig1, b1, type1), fixings(fixings1) {}
+
+//	Constructor that parses the option type from a string
+AsianArithmeticOption::AsianArithmeticOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const size_t fixings1, const string& type1)
+	: AsianArithmeticOption(S1, K1, T1, r1, sig1, b1, fixings1, ParseOptionType(type1)) {}
+
+//	Destructor
+AsianArithmeticOption::~AsianArithmeticOption() {}
+
+
+//	Assignment Operator
+AsianArithmeticOption& AsianArithmeticOption::operator = (const AsianArithmeticOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	copy(option);
+	return *this;
+}
+
+
+// Functions that calculate the option price
+MonteCarloResult AsianArithmeticOption::Price(const MonteCarloSettings& settings, ThreadPool& pool) const
+{
+	return AsianArithmeticPrice(S, K, T, r, sig, b, fixings, type, settings, pool);
+}
+
+//	One pool, started on the first call, serves every call (ParallelFor may be called from several threads at once)
+MonteCarloResult AsianArithmeticOption::Price(const MonteCarloSettings& settings) const
+{
+	static ThreadPool pool;
+	return Price(settings, pool);
+}
+
+double AsianArithmeticOption::GeometricPrice() const
+{
+	return (type == OptionType::Call) ? AsianGeometricPrice<Call>(S, K, T, r, sig, b, fixings) : AsianGeometricPrice<Put>(S, K, T, r, sig, b, fixings);
+}
+
+
+// Modifier functions
+void AsianArithmeticOption::toggle()								//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+
+// Global Functions
+
+//	Path simulation
+//
+//	Sums of the payoffs of samples [first, first + count); a sample is one path, or a pair of antithetic paths. The
+//	paths are simulated Lanes at a time: every lane keeps the log price, the running sum of the prices (arithmetic
+//	average) and of the log prices (geometric average) of its path and of its antithetic path, and the lanes are the
+//	inner, vectorised loop.
+static const size_t Lanes = 64;
+
+OPTION_TARGET_CLONES
+static MonteCarloSums SimulateBlock(const double phi, const double S, const double K, const double T, const double r, const double sig,
+	const double b, const size_t fixings, const bool antithetic, const PathGenerator& generator, const uint64_t first, const size_t count)
+{
+	const double dt = T / static_cast<double>(fixings);
+	const double drift = (b - 0.5 * sig * sig) * dt;
+	const double vol = sig * sqrt(dt);
+	const double logS = log(S);
+	const double df = exp(-r * T);
+	const double invN = 1.0 / static_cast<double>(fixings);
+
+	double logP[Lanes], sumP[Lanes], logSumP[Lanes];
+	double logM[Lanes], sumM[Lanes], logSumM[Lanes];
+	vector<double> normals(fixings * Lanes), work(fixings * Lanes);
+
+	MonteCarloSums sums;
+	for (size_t start = 0; start < count; start += Lanes)
+	{
+		const size_t m = (count - start < Lanes) ? count - start : Lanes;
+
+		//	Normals of every step of the m paths (MonteCarlo.hpp)
+		generator.Normals(first + start, m, normals.data(), work.data());
+
+		for (size_t i = 0; i < m; ++i)
+		{
+			logP[i] = logS;
+			sumP[i] = 0.0;
+			logSumP[i] = 0.0;
+			logM[i] = logS;
+			sumM[i] = 0.0;
+			logSumM[i] = 0.0;
+		}
+
+		for (size_t step = 0; step < fixings; ++step)
+		{
+			const double* z0 = normals.data() + step * m;
+
+			if (antithetic)
+			{
+				OPTION_SIMD_LOOP
+				for (size_t i = 0; i < m; ++i)
+				{
+					double z = z0[i];
+
+					logP[i] += drift + vol * z;
+					sumP[i] += FastExp(logP[i]);
+					logSumP[i] += logP[i];
+
+					logM[i] += drift - vol * z;
+					sumM[i] += FastExp(logM[i]);
+					logSumM[i] += logM[i];
+				}
+			}
+			else
+			{
+				OPTION_SIMD_LOOP
+				for (size_t i = 0; i < m; ++i)
+				{
+					double z = z0[i];
+
+					logP[i] += drift + vol * z;
+					sumP[i] += FastExp(logP[i]);
+					logSumP[i] += logP[i];
+				}
+			}
+		}
+
+		//	Discounted payoffs of the arithmetic (x) and geometric (y) averages
+		for (size_t i = 0; i < m; ++i)
+		{
+			double x = df * fmax(phi * (sumP[i] * invN - K), 0.0);
+			double y = df * fmax(phi * (FastExp(logSumP[i] * invN) - K), 0.0);
+
+			if (antithetic)
+			{
+				x = 0.5 * (x + df * fmax(phi * (sumM[i] * invN - K), 0.0));
+				y = 0.5 * (y + df * fmax(phi * (FastExp(logSumM[i] * invN) - K), 0.0));
+			}
+
+			sums.Add(x, y);
+		}
+	}
+	return sums;
+}
+
+
+MonteCarloResult AsianArithmeticPrice(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const size_t fixings, const OptionType type, const MonteCarloSettings& settings, ThreadPool& pool)
+{
+	if (fixings == 0)
+	{
+		throw invalid_argument("AsianArithmeticPrice: at least one fixing is required");
+	}
+
+	const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+	const size_t samples = settings.Antithetic ? (settings.Paths + 1) / 2 : settings.Paths;
+	const size_t blocks = (samples + MonteCarloBlock - 1) / MonteCarloBlock;
+
+	//	Each block writes its own sums; they are added up in block order below
+	const PathGenerator generator(settings, fixings);
+	vector<MonteCarloSums> blockSums(blocks);
+	pool.ParallelFor(blocks, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t first = i * MonteCarloBlock;
+			size_t count = (samples - first < MonteCarloBlock) ? samples - first : MonteCarloBlock;
+			blockSums[i] = SimulateBlock(phi, S, K, T, r, sig, b, fixings, settings.Antithetic, generator, first, count);
+		}
+	});
+
+	MonteCarloSums sums;
+	for (size_t i = 0; i < blocks; ++i)
+	{
+		sums.Add(blockSums[i]);
+	}
+
+	double control = (type == OptionType::Call) ? AsianGeometricPrice<Call>(S, K, T, r, sig, b, fixings)
+		: AsianGeometricPrice<Put>(S, K, T, r, sig, b, fixings);
+
+	return Estimate(sums, settings.ControlVariate, control, settings.Antithetic ? 2 * samples : samples);
+}
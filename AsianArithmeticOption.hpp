@@ -0,0 +1,67 @@
+// Class that represents arithmetic average-rate (Asian) options, priced by Monte Carlo
+//
+// (c) Sudhansh Dua
+//
+//	The payoff is max(phi (A - K), 0) with A the arithmetic average of the n fixings at t_i = i T / n (i = 1 .. n).
+//	There is no closed form, so the option is priced by simulating the fixings under Black-Scholes-Merton:
+//	->	the paths are generated a block of lanes at a time in a vectorised loop, with counter-based or Sobol normals
+//		(PathGenerator, MonteCarlo.hpp), so the result does not depend on the number of threads
+//	->	antithetic variates: each draw is used for a pair of paths, z and -z
+//	->	control variate: the geometric average of the same fixings, whose price is known in closed form
+//		(AsianGeometricPrice with fixings, AsianGeometricOption.hpp). The two averages are so closely correlated
+//		that it cuts the variance by two to three orders of magnitude.
+
+
+#ifndef AsianArithmeticOption_HPP
+#define AsianArithmeticOption_HPP
+
+#include "Option.hpp"
+#include "MonteCarlo.hpp"
+#include "ThreadPool.hpp"
+#include <string>
+using namespace std;
+
+class AsianArithmeticOption : public Option
+{
+private:
+	void init();											// Initialise all default values
+	void copy(const AsianArithmeticOption& option);			//	copies all values
+
+public:
+	//	Member data
+	size_t fixings;			//	number of equally spaced fixings in the average
+
+
+	//	Constructors and the destructor
+	AsianArithmeticOption();												//	default constructor
+	AsianArithmeticOption(const AsianArithmeticOption& option);						//	Copy constructor
+	AsianArithmeticOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const size_t fixings1, const OptionType type1);	//	constructor that accepts values
+	AsianArithmeticOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const size_t fixings1, const string& type1);	//	"C" - call option, "P" - put option
+	~AsianArithmeticOption();												//	destructor
+
+
+	//	Assignment operator
+	AsianArithmeticOption& operator = (const AsianArithmeticOption& option);
+
+
+	// Functions that calculate the option price
+	MonteCarloResult Price(const MonteCarloSettings& settings, ThreadPool& pool) const;
+	MonteCarloResult Price(const MonteCarloSettings& settings = MonteCarloSettings()) const;	//	on a shared pool, one thread per hardware thread
+	double GeometricPrice() const;			//	closed-form price of the geometric average of the same fixings
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+
+//	Monte Carlo price of an arithmetic average-rate option with the given number of fixings, simulated on pool.
+//	Throws invalid_argument if fixings is 0.
+MonteCarloResult AsianArithmeticPrice(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const size_t fixings, const OptionType type, const MonteCarloSettings& settings, ThreadPool& pool);
+
+#endif
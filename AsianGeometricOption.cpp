@@ -1,128 +1,137 @@
-//	Objective: To implement the option class that is defined in the header file: AsianGeometricOption.hpp
-//
-// (c) Sudhansh Dua
-
-#include "AsianGeometricOption.hpp"
-#include <string>
-#include <boost/math/distributions.hpp>
-#include <cmath>
-
-using namespace std;
-using namespace boost::math;
-
-
-double AsianGeometricOption::CallPrice() const
-{
-	return ::AsianGeometricCallPrice(S, K, T, r, sig, b, type);
-}
-
-double AsianGeometricOption::PutPrice() const
-{
-	return ::AsianGeometricPutPrice(S, K, T, r, sig, b, type);
-}
-
-
-void AsianGeometricOption::init()					// Initialising all the default values
-{
-	//	Default values
-	T = 0.25;
-	r = 0.05;
-	sig = 0.2;
-	K = 85;
-	S = 80;			
-	b = 0.08;			
-
-	type = "C";			//	Call option as the default
-
-}
-
-void AsianGeometricOption::copy(const AsianGeometricOption& option)
-{
-	T = option.T;
-	r = option.r;
-	sig = option.sig;
-	K = option.K;
-	b = option.b;
-	type = option.type;
-	S = option.S;
-}
-
-//	Constructors and destructor
-//	Default Constructor
-AsianGeometricOption::AsianGeometricOption() : Option()
-{
-	init();
-}
-
-//	Copy constructor
-AsianGeometricOption::AsianGeometricOption(const AsianGeometricOption& option) : Option(option)
-{
-	copy(option);
-}
-
-//	Constructor that accepts values
-AsianGeometricOption::AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
-	const double& b1, const string type1) : Option(), S(S1), K(K1), T(T1), r(r1), sig(sig1), b(b1), type(type1) {}
-
-//	Destructor
-AsianGeometricOption::~AsianGeometricOption() {}
-
-
-//	Assignment Operator
-AsianGeometricOption& AsianGeometricOption::operator = (const AsianGeometricOption& option)
-{
-	if (this == &option)
-	{
-		return *this;		//	Self-assignment check!
-	}
-	Option::operator = (option);
-	copy(option);
-	return *this;
-}
-
-
-// Functions that calculate the option price
-double AsianGeometricOption::Price() const
-{
-	if (type == "C")
-	{
-		return CallPrice();
-	}
-	else
-	{
-		return PutPrice();
-	}
-}
-
-
-// Modifier functions
-void AsianGeometricOption::toggle()								//	Change the option type
-{
-	type = ((type == "C") ? "P" : "C");
-}
-
-// Global Functions
-double AsianGeometricCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type)
-{
-	double sig_adj = sig / sqrt(3);						//	adjusted volatility 
-	double b_adj = 0.5 * (b - ((sig * sig) / 6));		//	adjusted cost-of-carry
-
-	double d1 = (log(S / K) + (b_adj + (sig_adj * sig_adj * 0.5)) * T) / sig_adj * sqrt(T);
-	double d2 = d1 - sig_adj * sqrt(T);
-
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return ((S * exp((b_adj - r) * T) * cdf(standard_normal, d1)) - (K * exp(-r * T) * cdf(standard_normal, d2)));
-}
-
-double AsianGeometricPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type)
-{
-	double sig_adj = sig / sqrt(3);						//	adjusted volatility 
-	double b_adj = 0.5 * (b - ((sig * sig) / 6));		//	adjusted cost-of-carry
-
-	double d1 = (log(S / K) + (b_adj + (sig_adj * sig_adj * 0.5)) * T) / sig_adj * sqrt(T);
-	double d2 = d1 - sig_adj * sqrt(T);
-
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return ((K * exp(-r * T) * cdf(standard_normal, -d2)) - (S * exp((b_adj - r) * T) * cdf(standard_normal, -d1)));
-}
-
+//	Objective: To implement the option class that is defined in the header file: AsianGeometricOption.hpp
+//
+// (c) Sudhansh Dua
+
+#include "AsianGeometricOption.hpp"
+#include "Numerics.hpp"
+#include <string>
+#include <cmath>
+
+using namespace std;
+using namespace Numerics;
+
+
+double AsianGeometricOption::CallPrice() const
+{
+	return AsianGeometricPrice<Call>(S, K, T, r, sig, b);
+}
+
+double AsianGeometricOption::PutPrice() const
+{
+	return AsianGeometricPrice<Put>(S, K, T, r, sig, b);
+}
+
+
+void AsianGeometricOption::init()					// Initialising all the default values
+{
+	//	Default values
+	T = 0.25;
+	r = 0.05;
+	sig = 0.2;
+	K = 85;
+	S = 80;			
+	b = 0.08;			
+
+	type = OptionType::Call;			//	Call option as the default
+
+}
+
+//	Constructors and destructor
+//	Default Constructor
+AsianGeometricOption::AsianGeometricOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+AsianGeometricOption::AsianGeometricOption(const AsianGeometricOption& option) : Option(option) {}
+
+//	Constructor that accepts values
+AsianGeometricOption::AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const OptionType type1) : Option(S1, K1, T1, r1, sig1, b1, type1) {}
+
+//	Constructor that parses the option type from a string
+AsianGeometricOption::AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const string& type1)
+	: AsianGeometricOption(S1, K1, T1, r1, sig1, b1, ParseOptionType(type1)) {}
+
+//	Destructor
+AsianGeometricOption::~AsianGeometricOption() {}
+
+
+//	Assignment Operator
+AsianGeometricOption& AsianGeometricOption::operator = (const AsianGeometricOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	return *this;
+}
+
+
+// Functions that calculate the option price
+double AsianGeometricOption::Price() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallPrice();
+	}
+	else
+	{
+		return PutPrice();
+	}
+}
+
+//	Price and sensitivities in one pass of the kernel on dual numbers
+OptionGreeks AsianGeometricOption::Greeks() const
+{
+	return AutoGreeks([this](const GreeksDual& S1, const GreeksDual& T1, const GreeksDual& r1, const GreeksDual& sig1, const GreeksDual& b1)
+	{
+		return (type == OptionType::Call) ? AsianGeometricPrice<Call>(S1, GreeksDual(K), T1, r1, sig1, b1) : AsianGeometricPrice<Put>(S1, GreeksDual(K), T1, r1, sig1, b1);
+	}, S, T, r, sig, b);
+}
+
+
+
+// Modifier functions
+void AsianGeometricOption::toggle()								//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+// Global Functions
+double AsianGeometricCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type)
+{
+	return AsianGeometricPrice<Call>(S, K, T, r, sig, b);
+}
+
+double AsianGeometricPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type)
+{
+	return AsianGeometricPrice<Put>(S, K, T, r, sig, b);
+}
+
+
+//	Batch kernel: the vanilla formula with the adjusted volatility and cost of carry
+OPTION_TARGET_CLONES
+void BatchAsianGeometricPrice(const double* __restrict S, const double* __restrict K, const double* __restrict T, const double* __restrict r, const double* __restrict sig, const double* __restrict b,
+	const int* __restrict isCall, double* __restrict price, const size_t n)
+{
+	const double invSqrt3 = 1.0 / sqrt(3.0);
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double sig_adj = sig[i] * invSqrt3;
+		double b_adj = 0.5 * (b[i] - ((sig[i] * sig[i]) / 6));
+
+		double sigSqrtT = sig_adj * Numerics::FastSqrt(T[i]);
+		double d1 = (Numerics::FastLog(S[i] / K[i]) + (b_adj + (sig_adj * sig_adj * 0.5)) * T[i]) / sigSqrtT;
+		double d2 = d1 - sigSqrtT;
+		double phi = (isCall[i] != 0) ? 1.0 : -1.0;
+
+		price[i] = phi * ((S[i] * Numerics::FastExp((b_adj - r[i]) * T[i]) * Numerics::NormalCdf(phi * d1))
+			- (K[i] * Numerics::FastExp(-r[i] * T[i]) * Numerics::NormalCdf(phi * d2)));
+	}
+}
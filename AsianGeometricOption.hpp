@@ -1,65 +1,89 @@
-// Class that represents solutions to AsianGeometric options
-//
-// (c) Sudhansh Dua
-//
-//	The Asian Geometric continous average-rate options 
-
-
-#ifndef AsianGeometricOption_HPP
-#define AsianGeometricOption_HPP
-
-#include "Option.hpp"
-#include <string>
-using namespace std;
-
-class AsianGeometricOption : public Option
-{
-private:
-	// 'Kernel' functions for option calculations
-	double CallPrice() const;								//	Price of a AsianGeometric call option
-	double PutPrice() const;								//	Price of a AsianGeometric put option
-
-
-	void init();											// Initialise all default values
-	void copy(const AsianGeometricOption& option);			//	copies all values
-
-public:
-	//	Member data
-	double T;			//	Time to expiry
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double K;			//	Strike Price
-	double S;			//	current stock price
-	double b;			//	Cost of carry
-	string type;		//	"C" - call option, "P" - put option
-
-
-
-	//	Constructors and the destructor
-	AsianGeometricOption();												//	default constructor
-	AsianGeometricOption(const AsianGeometricOption& option);						//	Copy constructor
-	AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1,
-		const double& sig1, const double& b1, const string type1);	//	constructor that accepts values
-	~AsianGeometricOption();												//	destructor
-
-
-	//	Assignment operator
-	AsianGeometricOption& operator = (const AsianGeometricOption& option);
-
-
-	// Functions that calculate the option price
-	double Price() const;
-
-
-	// Modifier functions
-	void toggle();					//	Change option type (Call to Put, Put to Call)
-
-};
-
-//	Global Functions
-double AsianGeometricCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type);
-double AsianGeometricPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type);
-
-#endif
-
-
+// Class that represents solutions to AsianGeometric options
+//
+// (c) Sudhansh Dua
+//
+//	The Asian Geometric continous average-rate options 
+
+
+#ifndef AsianGeometricOption_HPP
+#define AsianGeometricOption_HPP
+
+#include "Option.hpp"
+#include <string>
+using namespace std;
+
+class AsianGeometricOption : public Option
+{
+private:
+	// 'Kernel' functions for option calculations
+	double CallPrice() const;								//	Price of a AsianGeometric call option
+	double PutPrice() const;								//	Price of a AsianGeometric put option
+
+
+	void init();											// Initialise all default values
+
+public:
+	//	Constructors and the destructor
+	AsianGeometricOption();												//	default constructor
+	AsianGeometricOption(const AsianGeometricOption& option);						//	Copy constructor
+	AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);	//	constructor that accepts values
+	AsianGeometricOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);	//	"C" - call option, "P" - put option
+	~AsianGeometricOption();												//	destructor
+
+
+	//	Assignment operator
+	AsianGeometricOption& operator = (const AsianGeometricOption& option);
+
+
+	// Functions that calculate the option price
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+double AsianGeometricCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type);
+double AsianGeometricPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type);
+
+//	Compile-time kernel: AsianGeometricPrice<Call> or AsianGeometricPrice<Put>
+template <class Type, class Real>
+inline Real AsianGeometricPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	Real sig_adj = sig / sqrt(3);						//	adjusted volatility 
+	Real b_adj = 0.5 * (b - ((sig * sig) / 6));		//	adjusted cost-of-carry
+
+	Real d1 = (log(S / K) + (b_adj + (sig_adj * sig_adj * 0.5)) * T) / (sig_adj * sqrt(T));
+	Real d2 = d1 - sig_adj * sqrt(T);
+
+	return Type::phi * ((S * exp((b_adj - r) * T) * Numerics::NormalCdf(Type::phi * d1)) - (K * exp(-r * T) * Numerics::NormalCdf(Type::phi * d2)));
+}
+
+//	Geometric average of n equally spaced fixings at t_i = i T / n (i = 1 .. n). The log of the average is normal with
+//		mean = log(S) + (b - sig^2 / 2) T (n + 1) / (2n),	variance = sig^2 T (n + 1)(2n + 1) / (6n^2)
+//	so the option is a vanilla with an adjusted volatility and cost of carry. This is the exact expectation of the
+//	geometric payoff on a simulated path, used as the control variate of the arithmetic Monte Carlo
+//	(AsianArithmeticOption.hpp); as n grows it tends to the continuous average above.
+template <class Type, class Real>
+inline Real AsianGeometricPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b,
+	const size_t fixings)
+{
+	const double n = static_cast<double>(fixings);
+
+	Real sig_adj = sig * sqrt(((n + 1) * (2 * n + 1)) / (6 * n * n));					//	adjusted volatility
+	Real b_adj = ((b - (sig * sig * 0.5)) * ((n + 1) / (2 * n))) + (sig_adj * sig_adj * 0.5);		//	adjusted cost-of-carry
+
+	return VanillaPrice<Type>(S, K, T, r, sig_adj, b_adj);
+}
+
+//	Batch form of the continuous average, with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call.
+//	The loop is vectorised and agrees with AsianGeometricPrice to within 1e-13 * max(S, K) (absolute).
+void BatchAsianGeometricPrice(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, const size_t n);
+
+#endif
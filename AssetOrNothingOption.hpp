@@ -1,66 +1,68 @@
-// Class that represents solutions to Asset or Nothing options
-//
-// (c) Sudhansh Dua
-//
-//  At expiration, the asset-or-nothing call option pays 0 if S < K and S if S > K. 
-//	Similarly, a put option pays 0 if S > Kand S if S < K.
-
-
-#ifndef AssetOrNothingOption_HPP
-#define AssetOrNothingOption_HPP
-
-#include "Option.hpp"
-#include <string>
-using namespace std;
-
-class AssetOrNothingOption : public Option
-{
-private:
-	// 'Kernel' functions for option calculations
-	double CallPrice() const;								//	Price of a asset-or-nothing call option
-	double PutPrice() const;								//	Price of a asset-or-nothing put option
-
-
-	void init();											//  Initialise all default values
-	void copy(const AssetOrNothingOption& option);			//	copies all values
-
-public:
-	//	Member data
-	double T;			//	Time to expiry
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double K;			//	Strike Price
-	double S;			//	current stock price
-	double b;			//	Cost of carry
-	string type;		//	"C" - call option, "P" - put option
-
-
-
-	//	Constructors and the destructor
-	AssetOrNothingOption();												//	default constructor
-	AssetOrNothingOption(const AssetOrNothingOption& option);			//	Copy constructor
-	AssetOrNothingOption(const double& S1, const double& K1, const double& T1, const double& r1,
-		const double& sig1, const double& b1, const string type1);		//	constructor that accepts values
-	~AssetOrNothingOption();											//	destructor
-
-
-	//	Assignment operator
-	AssetOrNothingOption& operator = (const AssetOrNothingOption& option);
-
-
-	// Functions that calculate the option price
-	double Price() const;
-
-
-	// Modifier functions
-	void toggle();					//	Change option type (Call to Put, Put to Call)
-
-};
-
-//	Global Functions
-double AoNCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type);
-double AoNPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string type);
-
-#endif
-
-
+// Class that represents solutions to Asset or Nothing options
+//
+// (c) Sudhansh Dua
+//
+//  At expiration, the asset-or-nothing call option pays 0 if S < K and S if S > K. 
+//	Similarly, a put option pays 0 if S > Kand S if S < K.
+
+
+#ifndef AssetOrNothingOption_HPP
+#define AssetOrNothingOption_HPP
+
+#include "Option.hpp"
+#include <string>
+using namespace std;
+
+class AssetOrNothingOption : public Option
+{
+private:
+	// 'Kernel' functions for option calculations
+	double CallPrice() const;								//	Price of a asset-or-nothing call option
+	double PutPrice() const;								//	Price of a asset-or-nothing put option
+
+
+	void init();											//  Initialise all default values
+
+public:
+	//	Constructors and the destructor
+	AssetOrNothingOption();												//	default constructor
+	AssetOrNothingOption(const AssetOrNothingOption& option);			//	Copy constructor
+	AssetOrNothingOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);		//	constructor that accepts values
+	AssetOrNothingOption(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);		//	"C" - call option, "P" - put option
+	~AssetOrNothingOption();											//	destructor
+
+
+	//	Assignment operator
+	AssetOrNothingOption& operator = (const AssetOrNothingOption& option);
+
+
+	// Functions that calculate the option price
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+double AoNCallPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type);
+double AoNPutPrice(const double S, const double K, const double T, const double r, const double sig, const double b, const string& type);
+
+//	Compile-time kernel: AoNPrice<Call> or AoNPrice<Put>
+template <class Type, class Real>
+inline Real AoNPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	Real d = (log(S / K) + (b + (sig * sig * 0.5)) * T) / (sig * sqrt(T));
+	return (S * exp(-r * T) * Numerics::NormalCdf(Type::phi * d));
+}
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call. The loop is vectorised and
+//	agrees with AoNPrice to within 1e-13 * S (absolute).
+void BatchAoNPrice(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, const size_t n);
+
+#endif
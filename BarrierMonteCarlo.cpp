@@ -0,0 +1,168 @@
+// Implementing the functions that are declared in the header file: BarrierMonteCarlo.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "BarrierMonteCarlo.hpp"
+#include "Numerics.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	One time step of a path: the log distance x to the barrier moves by dx and the barrier is hit with probability p,
+//	the bridge crossing probability or whether the monitoring date is on or beyond the barrier. Branch-free (selects
+//	only), so that it vectorises inside the loops over the lanes.
+static inline void Advance(double& x, double& w, double& rebate, const double dx, const double eta, const bool continuous,
+	const double bridge, const double paid)
+{
+	double last = x;
+	x += dx;
+	bool live = (eta * last > 0.0) && (eta * x > 0.0);
+	double p = continuous ? (live ? FastExp(-bridge * last * x) : 1.0) : ((eta * x > 0.0) ? 0.0 : 1.0);
+	rebate += w * p * paid;
+	w *= 1.0 - p;
+}
+
+
+//	Path simulation
+//
+//	Sums of the payoffs of samples [first, first + count); a sample is one path, or a pair of antithetic paths. Every
+//	lane keeps the log price of its path, the probability w that the barrier has not been hit yet and the discounted
+//	out rebate collected so far; the lanes are the inner, vectorised loop. eta = +1 for a down barrier, -1 for up.
+static const size_t Lanes = 64;
+
+OPTION_TARGET_CLONES
+static MonteCarloSums SimulateBlock(const double phi, const double eta, const bool out, const bool continuous, const double S,
+	const double H, const double K, const double cr, const double T, const double r, const double sig, const double b,
+	const size_t steps, const bool antithetic, const PathGenerator& generator, const uint64_t first, const size_t count)
+{
+	const double dt = T / static_cast<double>(steps);
+	const double drift = (b - 0.5 * sig * sig) * dt;
+	const double vol = sig * sqrt(dt);
+	const double bridge = 2.0 / (sig * sig * dt);			//	crossing probability exp(-bridge x_i x_(i+1))
+	const double x0 = log(S / H);
+	const double df = exp(-r * T);
+	const double payment = continuous ? 0.5 : 1.0;			//	out rebate paid in the middle of the step, or on the date
+
+	double xP[Lanes], wP[Lanes], rebateP[Lanes];
+	double xM[Lanes], wM[Lanes], rebateM[Lanes];
+	vector<double> normals(steps * Lanes), work(steps * Lanes);
+
+	MonteCarloSums sums;
+	for (size_t start = 0; start < count; start += Lanes)
+	{
+		const size_t m = (count - start < Lanes) ? count - start : Lanes;
+
+		//	Normals of every step of the m paths (MonteCarlo.hpp)
+		generator.Normals(first + start, m, normals.data(), work.data());
+
+		for (size_t i = 0; i < m; ++i)
+		{
+			xP[i] = x0;
+			wP[i] = 1.0;
+			rebateP[i] = 0.0;
+			xM[i] = x0;
+			wM[i] = 1.0;
+			rebateM[i] = 0.0;
+		}
+
+		for (size_t step = 0; step < steps; ++step)
+		{
+			const double* z0 = normals.data() + step * m;
+			const double paid = cr * exp(-r * (static_cast<double>(step) + payment) * dt);		//	out rebate for a hit in this step
+
+			if (antithetic)
+			{
+				OPTION_SIMD_LOOP
+				for (size_t i = 0; i < m; ++i)
+				{
+					double z = z0[i];
+					Advance(xP[i], wP[i], rebateP[i], drift + vol * z, eta, continuous, bridge, paid);
+					Advance(xM[i], wM[i], rebateM[i], drift - vol * z, eta, continuous, bridge, paid);
+				}
+			}
+			else
+			{
+				OPTION_SIMD_LOOP
+				for (size_t i = 0; i < m; ++i)
+				{
+					double z = z0[i];
+					Advance(xP[i], wP[i], rebateP[i], drift + vol * z, eta, continuous, bridge, paid);
+				}
+			}
+		}
+
+		//	Discounted payoffs of the barrier option (x) and of the vanilla option on the same path (y)
+		for (size_t i = 0; i < m; ++i)
+		{
+			double y = df * fmax(phi * (H * FastExp(xP[i]) - K), 0.0);
+			double x = out ? (wP[i] * y + rebateP[i]) : ((1.0 - wP[i]) * y + wP[i] * cr * df);
+
+			if (antithetic)
+			{
+				double yM = df * fmax(phi * (H * FastExp(xM[i]) - K), 0.0);
+				double xMinus = out ? (wM[i] * yM + rebateM[i]) : ((1.0 - wM[i]) * yM + wM[i] * cr * df);
+				x = 0.5 * (x + xMinus);
+				y = 0.5 * (y + yM);
+			}
+
+			sums.Add(x, y);
+		}
+	}
+	return sums;
+}
+
+
+MonteCarloResult BarrierMonteCarloPrice(const double S, const double H, const double K, const double cr, const double T, const double r,
+	const double sig, const double b, const OptionType type, const BarrierType InOrOut, const BarrierMonitoring monitoring,
+	const size_t steps, const MonteCarloSettings& settings, ThreadPool& pool)
+{
+	if (steps == 0)
+	{
+		throw invalid_argument("BarrierMonteCarloPrice: at least one time step is required");
+	}
+
+	const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+	const double eta = (S >= H) ? 1.0 : -1.0;
+	const bool out = (InOrOut == BarrierType::Out);
+	const bool continuous = (monitoring == BarrierMonitoring::Continuous);
+	const size_t samples = settings.Antithetic ? (settings.Paths + 1) / 2 : settings.Paths;
+	const size_t blocks = (samples + MonteCarloBlock - 1) / MonteCarloBlock;
+
+	//	Each block writes its own sums; they are added up in block order below
+	const PathGenerator generator(settings, steps);
+	vector<MonteCarloSums> blockSums(blocks);
+	pool.ParallelFor(blocks, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t first = i * MonteCarloBlock;
+			size_t count = (samples - first < MonteCarloBlock) ? samples - first : MonteCarloBlock;
+			blockSums[i] = SimulateBlock(phi, eta, out, continuous, S, H, K, cr, T, r, sig, b, steps, settings.Antithetic,
+				generator, first, count);
+		}
+	});
+
+	MonteCarloSums sums;
+	for (size_t i = 0; i < blocks; ++i)
+	{
+		sums.Add(blockSums[i]);
+	}
+
+	double control = (type == OptionType::Call) ? VanillaPrice<Call>(S, K, T, r, sig, b) : VanillaPrice<Put>(S, K, T, r, sig, b);
+
+	return Estimate(sums, settings.ControlVariate, control, settings.Antithetic ? 2 * samples : samples);
+}
+
+
+MonteCarloResult BarrierMonteCarloPrice(const BarrierOption& option, const BarrierMonitoring monitoring, const size_t steps,
+	const MonteCarloSettings& settings, ThreadPool& pool)
+{
+	return BarrierMonteCarloPrice(option.S, option.H, option.K, option.cr, option.T, option.r, option.sig, option.b, option.type,
+		option.InOrOut, monitoring, steps, settings, pool);
+}
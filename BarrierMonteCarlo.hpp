@@ -0,0 +1,53 @@
+// Monte Carlo engine for barrier options, continuously or discretely monitored
+//
+// (c) Sudhansh Dua
+//
+//	BarrierOption prices a barrier that is watched continuously. A barrier that is only checked at n dates (daily
+//	fixings, say) is knocked less often, and is priced here either by the Broadie-Glasserman-Kou continuity
+//	correction (DiscreteBarrierPrice, BarrierOption.hpp) or by simulation. The engine covers the eight variants of
+//	BarrierOption, rebate included, with the same conventions: down if S >= H and up otherwise; an out option pays
+//	cr when it is knocked out, an in option pays cr at expiry if it was never knocked in.
+//
+//	The log price is simulated exactly on a grid of equal time steps, and between two grid points it is a Brownian
+//	bridge, which crosses the barrier with probability (x_i = log(S_i / H), both on the live side of the barrier)
+//		p = exp(-2 x_i x_(i+1) / (sig^2 dt))
+//	->	BarrierMonitoring::Continuous: each path carries the probability that it is still alive, the product of the
+//		(1 - p) of its steps, instead of a sampled hit. This is the exact conditional expectation, so the price of a
+//		barrier without rebate is unbiased however coarse the grid. An out rebate is discounted from the middle of the
+//		step in which the barrier is crossed: paths cross early in a step more often than late, so the rebate is
+//		slightly undervalued, by at most cr (1 - exp(-r dt / 2)) and in practice within a standard error of 10^6
+//		paths from about 16 steps a year.
+//	->	BarrierMonitoring::Discrete: the grid points are the monitoring dates t_i = i T / steps (i = 1 .. steps), and
+//		the barrier is checked at those only. There is no discretisation bias at all.
+//
+//	Paths are generated as for the Asian options (MonteCarlo.hpp): a block of lanes at a time in a vectorised loop,
+//	pseudo-random or Sobol (one dimension per time step), with antithetic variates, and summed in fixed blocks so the
+//	result does not depend on the number of threads. The control variate is the discounted vanilla payoff of the same
+//	path, whose price is known in closed form.
+//
+//	tools/BarrierBenchmark.cpp compares the convergence and throughput of the engine against BarrierOption::Price().
+
+
+#ifndef BarrierMonteCarlo_HPP
+#define BarrierMonteCarlo_HPP
+
+#include "BarrierOption.hpp"
+#include "MonteCarlo.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+using namespace std;
+
+
+enum class BarrierMonitoring { Continuous, Discrete };
+
+
+//	Monte Carlo price of a barrier option on a grid of steps equal time steps, simulated on pool. With
+//	BarrierMonitoring::Discrete the steps are the monitoring dates. Throws invalid_argument if steps is 0.
+MonteCarloResult BarrierMonteCarloPrice(const double S, const double H, const double K, const double cr, const double T, const double r,
+	const double sig, const double b, const OptionType type, const BarrierType InOrOut, const BarrierMonitoring monitoring,
+	const size_t steps, const MonteCarloSettings& settings, ThreadPool& pool);
+
+MonteCarloResult BarrierMonteCarloPrice(const BarrierOption& option, const BarrierMonitoring monitoring, const size_t steps,
+	const MonteCarloSettings& settings, ThreadPool& pool);
+
+#endif
@@ -0,0 +1,128 @@
+// Implementing the class that is defined in the header file: BrownianBridge.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "BrownianBridge.hpp"
+#include "Numerics.hpp"
+#include <cmath>
+#include <stdexcept>
+
+
+using namespace std;
+
+
+//	Constructor: the order of construction and the weights, from the grid alone
+BrownianBridge::BrownianBridge(const size_t steps1)
+	: steps(steps1), point(steps1), left(steps1), right(steps1), hasLeft(steps1), wLeft(steps1), wRight(steps1), sigma(steps1)
+{
+	if (steps == 0)
+	{
+		throw invalid_argument("BrownianBridge: at least one time step is required");
+	}
+
+	//	filled[i] != 0 once W(i + 1) is set
+	vector<char> filled(steps, 0);
+	filled[steps - 1] = 1;
+	point[0] = steps - 1;
+	hasLeft[0] = 0;
+	left[0] = right[0] = 0;
+	wLeft[0] = wRight[0] = 0.0;
+	sigma[0] = sqrt(static_cast<double>(steps));
+
+	size_t j = 0;			//	first grid point of the current gap
+	for (size_t n = 1; n < steps; ++n)
+	{
+		while (filled[j])
+		{
+			++j;
+		}
+		size_t k = j;		//	first grid point set after the gap
+		while (!filled[k])
+		{
+			++k;
+		}
+		size_t l = j + ((k - 1 - j) >> 1);
+		filled[l] = 1;
+
+		//	Gap from time j (W(j), index j - 1, or 0 if j = 0) to time k + 1 (index k); the new point is at time l + 1
+		double width = static_cast<double>(k + 1 - j);
+		point[n] = l;
+		hasLeft[n] = (j > 0);
+		left[n] = (j > 0) ? j - 1 : 0;
+		right[n] = k;
+		wLeft[n] = static_cast<double>(k - l) / width;
+		wRight[n] = static_cast<double>(l + 1 - j) / width;
+		sigma[n] = sqrt(static_cast<double>(l + 1 - j) * static_cast<double>(k - l) / width);
+
+		j = k + 1;
+		if (j >= steps)
+		{
+			j = 0;
+		}
+	}
+}
+
+
+size_t BrownianBridge::Steps() const
+{
+	return steps;
+}
+
+
+void BrownianBridge::Transform(double* z, const size_t count, double* work) const
+{
+	double* W = work;			//	W[(l - 1) * count + i] = W(l) of path i
+
+	for (size_t n = 0; n < steps; ++n)
+	{
+		double* out = W + point[n] * count;
+		const double* zn = z + n * count;
+		const double s = sigma[n];
+		const double b = wRight[n];
+
+		if (n == 0)
+		{
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = s * zn[i];
+			}
+		}
+		else if (hasLeft[n])
+		{
+			const double* wl = W + left[n] * count;
+			const double* wr = W + right[n] * count;
+			const double a = wLeft[n];
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = a * wl[i] + b * wr[i] + s * zn[i];
+			}
+		}
+		else
+		{
+			const double* wr = W + right[n] * count;
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = b * wr[i] + s * zn[i];
+			}
+		}
+	}
+
+	//	Increments, written over the normals
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < count; ++i)
+	{
+		z[i] = W[i];
+	}
+	for (size_t t = 1; t < steps; ++t)
+	{
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < count; ++i)
+		{
+			z[t * count + i] = W[t * count + i] - W[(t - 1) * count + i];
+		}
+	}
+}
@@ -0,0 +1,48 @@
+// Brownian-bridge construction of the paths of a Monte Carlo simulation
+//
+// (c) Sudhansh Dua
+//
+//	Builds a Brownian motion on the grid t_i = i (i = 1 .. n) from n independent normals z_0 .. z_(n-1) by
+//	successive bisection (Jaeckel 2002): z_0 sets the end point, W(n) = sqrt(n) z_0, and each following normal fills
+//	in the midpoint of the widest gap left, from the two points around it
+//		W(l) = wLeft W(j) + wRight W(k) + sigma z,	wLeft = (k - l) / (k - j),	wRight = (l - j) / (k - j),
+//		sigma^2 = (l - j) (k - l) / (k - j)
+//	The paths have exactly the law of those built forward step by step; the difference is in which normals matter.
+//	The first few, which carry the end point and the coarse shape of the path, explain most of the variance of a
+//	path-dependent payoff, so with quasi-random normals they take the best-distributed dimensions of the sequence
+//	and the effective dimension of the problem falls from n to a handful.
+//
+//	Transform works on a block of paths laid out normal by normal (z[k * count + i], as FillNormals gives them) and
+//	returns the increments W(t_(s+1)) - W(t_s) of each path in the same layout; the loops over the paths vectorise.
+
+
+#ifndef BrownianBridge_HPP
+#define BrownianBridge_HPP
+
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+
+class BrownianBridge
+{
+private:
+	size_t steps;
+	vector<size_t> point;			//	grid point set by normal k (index l - 1 of W(l))
+	vector<size_t> left;			//	grid point to its left (index j - 1), when hasLeft
+	vector<size_t> right;			//	grid point to its right (index k - 1)
+	vector<char> hasLeft;			//	false when the left end of the gap is t = 0, where W = 0
+	vector<double> wLeft, wRight, sigma;
+
+public:
+	//	Throws invalid_argument if steps is 0
+	explicit BrownianBridge(const size_t steps1);
+
+	size_t Steps() const;
+
+	//	In place on z, which holds steps * count normals; work holds steps * count doubles
+	void Transform(double* z, const size_t count, double* work) const;
+};
+
+#endif
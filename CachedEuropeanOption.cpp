@@ -0,0 +1,255 @@
+// Implementing the class that is defined in the header file: CachedEuropeanOption.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "CachedEuropeanOption.hpp"
+#include "Numerics.hpp"
+#include <cmath>
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Memoised terms
+//
+//	A term is stale if one of its inputs is dirty; the dirty bits are cleared once every stale term is recomputed
+bool CachedEuropeanOption::Stale(const unsigned dependsOn)
+{
+	bool stale = (dirty & dependsOn) != 0;
+	++(stale ? misses : hits);
+	return stale;
+}
+
+const BlackTerms& CachedEuropeanOption::Terms()
+{
+	const double S = option.S, K = option.K, T = option.T, r = option.r, sig = option.sig, b = option.b;
+
+	if (Stale(Spot | Strike))
+	{
+		terms.logSK = log(S / K);
+	}
+	if (Stale(Vol | Time))
+	{
+		terms.sqrtT = sqrt(T);
+		terms.sigSqrtT = sig * terms.sqrtT;
+	}
+	if (Stale(Rate | Time))
+	{
+		terms.df = exp(-r * T);
+	}
+	if (Stale(Carry | Rate | Time))
+	{
+		terms.carry = exp((b - r) * T);
+	}
+	if (Stale(Spot | Strike | Time | Vol | Carry))
+	{
+		terms.d1 = (terms.logSK + (b + (sig * sig) * 0.5) * T) / terms.sigSqrtT;
+		terms.d2 = terms.d1 - terms.sigSqrtT;
+	}
+	if (Stale(Spot | Strike | Time | Vol | Carry | Type))
+	{
+		const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+		terms.Nphi1 = NormalCdf(phi * terms.d1);
+		terms.Nphi2 = NormalCdf(phi * terms.d2);
+		terms.nd1 = NormalPdf(terms.d1);
+	}
+
+	dirty = 0;
+	return terms;
+}
+
+
+//	Constructors and destructor
+CachedEuropeanOption::CachedEuropeanOption() : option(), terms(), dirty(All), hits(0), misses(0) {}
+
+CachedEuropeanOption::CachedEuropeanOption(const CachedEuropeanOption& source)
+	: option(source.option), terms(source.terms), dirty(source.dirty), hits(source.hits), misses(source.misses) {}
+
+CachedEuropeanOption::CachedEuropeanOption(const EuropeanOption& contract)
+	: option(contract), terms(), dirty(All), hits(0), misses(0) {}
+
+CachedEuropeanOption::~CachedEuropeanOption() {}
+
+
+//	Assignment operator
+CachedEuropeanOption& CachedEuropeanOption::operator = (const CachedEuropeanOption& source)
+{
+	if (this == &source)
+	{
+		return *this;
+	}
+	option = source.option;
+	terms = source.terms;
+	dirty = source.dirty;
+	hits = source.hits;
+	misses = source.misses;
+	return *this;
+}
+
+
+//	Functions that calculate option price and sensitivities (phi = +1 for calls, -1 for puts)
+double CachedEuropeanOption::Price()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	return phi * ((option.S * t.carry * t.Nphi1) - (option.K * t.df * t.Nphi2));
+}
+
+double CachedEuropeanOption::Delta()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	return phi * t.carry * t.Nphi1;
+}
+
+double CachedEuropeanOption::Gamma()
+{
+	const BlackTerms& t = Terms();
+	return (t.nd1 * t.carry) / (option.S * t.sigSqrtT);
+}
+
+double CachedEuropeanOption::Vega()
+{
+	const BlackTerms& t = Terms();
+	return option.S * t.sqrtT * t.carry * t.nd1;
+}
+
+double CachedEuropeanOption::Theta()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	double t1 = (option.S * option.sig * t.carry * t.nd1) / (2 * t.sqrtT);
+	double t2 = (option.b - option.r) * option.S * t.carry * t.Nphi1;
+	double t3 = option.r * option.K * t.df * t.Nphi2;
+	return -t1 - phi * (t2 + t3);
+}
+
+double CachedEuropeanOption::Rho()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	return (option.b != 0.0) ? phi * option.T * option.K * t.df * t.Nphi2 : -option.T * Price();
+}
+
+double CachedEuropeanOption::Coc()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	return phi * option.T * option.S * t.carry * t.Nphi1;
+}
+
+OptionGreeks CachedEuropeanOption::Greeks()
+{
+	const BlackTerms& t = Terms();
+	const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+	const double S = option.S, K = option.K, T = option.T, r = option.r, b = option.b;
+	OptionGreeks g;
+
+	g.Price = phi * ((S * t.carry * t.Nphi1) - (K * t.df * t.Nphi2));
+	g.Delta = phi * t.carry * t.Nphi1;
+	g.Gamma = (t.nd1 * t.carry) / (S * t.sigSqrtT);
+	g.Vega = S * t.sqrtT * t.carry * t.nd1;
+	g.Theta = -(S * option.sig * t.carry * t.nd1) / (2 * t.sqrtT) - phi * ((b - r) * S * t.carry * t.Nphi1 + r * K * t.df * t.Nphi2);
+	g.Rho = (b != 0.0) ? phi * T * K * t.df * t.Nphi2 : -T * g.Price;
+	g.Coc = phi * T * S * t.carry * t.Nphi1;
+
+	return g;
+}
+
+
+//	The contract
+const EuropeanOption& CachedEuropeanOption::Contract() const
+{
+	return option;
+}
+
+
+// Modifier functions: each marks the inputs it changed
+void CachedEuropeanOption::SetContract(const EuropeanOption& contract)
+{
+	option = contract;
+	dirty = All;
+}
+
+void CachedEuropeanOption::toggle()
+{
+	option.toggle();
+	dirty |= Type;
+}
+
+void CachedEuropeanOption::SetSpot(const double S1)
+{
+	if (!(S1 == option.S))
+	{
+		option.S = S1;
+		dirty |= Spot;
+	}
+}
+
+void CachedEuropeanOption::SetStrike(const double K1)
+{
+	if (!(K1 == option.K))
+	{
+		option.K = K1;
+		dirty |= Strike;
+	}
+}
+
+void CachedEuropeanOption::SetExpiry(const double T1)
+{
+	if (!(T1 == option.T))
+	{
+		option.T = T1;
+		dirty |= Time;
+	}
+}
+
+void CachedEuropeanOption::SetRate(const double r1)
+{
+	if (!(r1 == option.r))
+	{
+		option.r = r1;
+		dirty |= Rate;
+	}
+}
+
+void CachedEuropeanOption::SetVol(const double sig1)
+{
+	if (!(sig1 == option.sig))
+	{
+		option.sig = sig1;
+		dirty |= Vol;
+	}
+}
+
+void CachedEuropeanOption::SetCarry(const double b1)
+{
+	if (!(b1 == option.b))
+	{
+		option.b = b1;
+		dirty |= Carry;
+	}
+}
+
+
+//	Cache counters
+size_t CachedEuropeanOption::CacheHits() const
+{
+	return hits;
+}
+
+size_t CachedEuropeanOption::CacheMisses() const
+{
+	return misses;
+}
+
+double CachedEuropeanOption::CacheHitRate() const
+{
+	return (hits + misses > 0) ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+}
+
+void CachedEuropeanOption::ResetCacheCounters()
+{
+	hits = misses = 0;
+}
@@ -0,0 +1,98 @@
+// Class that defines a European option with memoised Black-Scholes terms
+//
+// (c) Sudhansh Dua
+//
+//	CachedEuropeanOption holds an EuropeanOption together with the intermediates of the Black-Scholes formulas, which
+//	it keeps between calls. The contract can only be changed through the setters, each of which marks the inputs it
+//	changed as dirty; the next accessor recomputes only the terms that depend on a dirty input. A spot move keeps
+//	sig sqrt(T) and the discount and carry factors, a vol move keeps log(S / K) and the factors, and a type toggle
+//	recomputes only the normal functions.
+//
+//	The accessors refresh the terms and so are not const: one CachedEuropeanOption belongs to one thread. The
+//	EuropeanOption itself holds no cache and stays safe to price from any number of threads; Contract() returns it.
+
+
+#ifndef CachedEuropeanOption_HPP
+#define CachedEuropeanOption_HPP
+
+
+#include "EuropeanOption.hpp"
+using namespace std;
+
+
+//	Intermediates of the Black-Scholes formulas and the inputs each depends on
+struct BlackTerms
+{
+	double logSK;			//	log(S / K)							S, K
+	double sqrtT;			//	sqrt(T)								T
+	double sigSqrtT;		//	sig sqrt(T)							sig, T
+	double df;				//	exp(-rT)							r, T
+	double carry;			//	exp((b - r)T)						b, r, T
+	double d1, d2;			//										S, K, T, sig, b
+	double Nphi1, Nphi2;	//	N(phi d1), N(phi d2); phi = +1 for a call and -1 for a put
+	double nd1;				//	n(d1)
+};
+
+
+class CachedEuropeanOption
+{
+private:
+	//	Dirty bits, one per input
+	enum { Spot = 1, Strike = 2, Time = 4, Rate = 8, Vol = 16, Carry = 32, Type = 64, All = 127 };
+
+	EuropeanOption option;
+	BlackTerms terms;
+	unsigned dirty;					//	inputs changed since the terms were computed
+	size_t hits, misses;
+
+	const BlackTerms& Terms();		//	recomputes the terms that depend on a dirty input
+	bool Stale(const unsigned dependsOn);
+
+public:
+	//	Constructors and destructor
+	CachedEuropeanOption();											//	default constructor
+	CachedEuropeanOption(const CachedEuropeanOption& source);		//	copy constructor
+	explicit CachedEuropeanOption(const EuropeanOption& contract);	//	starts with every term dirty
+	virtual ~CachedEuropeanOption();								//	destructor
+
+
+	//	Assignment operator
+	CachedEuropeanOption& operator = (const CachedEuropeanOption& source);
+
+
+	// Functions that calculate option price and sensitivities, from the memoised terms
+	double Price();
+	double Delta();
+	double Gamma();
+	double Vega();
+	double Theta();
+	double Rho();
+	double Coc();
+	OptionGreeks Greeks();
+
+
+	//	The contract; it is changed only through the functions below
+	const EuropeanOption& Contract() const;
+
+
+	// Modifier functions
+	void SetContract(const EuropeanOption& contract);	//	marks every term dirty
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+	void SetSpot(const double S1);
+	void SetStrike(const double K1);
+	void SetExpiry(const double T1);
+	void SetRate(const double r1);
+	void SetVol(const double sig1);
+	void SetCarry(const double b1);
+
+
+	//	Cache counters: terms reused and terms recomputed by the calls above
+	size_t CacheHits() const;
+	size_t CacheMisses() const;
+	double CacheHitRate() const;	//	hits / (hits + misses)
+	void ResetCacheCounters();
+
+
+};
+
+#endif
@@ -1,120 +1,139 @@
-//	Objective: To implement the option class that is defined in the header file: CashOrNothingOption.hpp
-//
-// (c) Sudhansh Dua
-
-#include "CashOrNothingOption.hpp"
-#include <string>
-#include <boost/math/distributions.hpp>
-#include <cmath>
-
-using namespace std;
-using namespace boost::math;
-
-
-double CashOrNothingOption::CallPrice() const
-{
-	return ::CashOrNothingCallPrice(S, K, cr, T, r, sig, b, type);
-}
-
-double CashOrNothingOption::PutPrice() const
-{
-	return ::CashOrNothingPutPrice(S, K, cr, T, r, sig, b, type);
-}
-
-
-void CashOrNothingOption::init()					// Initialising all the default values
-{
-	//	Default values
-	T = 1;
-	cr = 10;
-	r = 0.08;
-	sig = 0.25;
-	K = 100;
-	S = 100;			//	Default stock price 
-	b = r;				//	Black - Scholes(1973) stock option model : b = r
-
-	type = "C";			//	Call option as the default
-
-}
-
-void CashOrNothingOption::copy(const CashOrNothingOption& option)
-{
-	cr = option.cr;
-	T = option.T;
-	r = option.r;
-	sig = option.sig;
-	K = option.K;
-	b = option.b;
-	type = option.type;
-	S = option.S;
-}
-
-//	Constructors and destructor
-//	Default Constructor
-CashOrNothingOption::CashOrNothingOption() : Option()
-{
-	init();
-}
-
-//	Copy constructor
-CashOrNothingOption::CashOrNothingOption(const CashOrNothingOption& option) : Option(option)
-{
-	copy(option);
-}
-
-//	Constructor that accepts values
-CashOrNothingOption::CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1, const double& sig1,
-	const double& b1, const string type1) : Option(), S(S1), K(K1), cr(cr1), T(T1), r(r1), sig(sig1), b(b1), type(type1) {}
-
-//	Destructor
-CashOrNothingOption::~CashOrNothingOption() {}
-
-
-//	Assignment Operator
-CashOrNothingOption& CashOrNothingOption::operator = (const CashOrNothingOption& option)
-{
-	if (this == &option)
-	{
-		return *this;		//	Self-assignment check!
-	}
-	Option::operator = (option);
-	copy(option);
-	return *this;
-}
-
-
-// Functions that calculate the option price
-double CashOrNothingOption::Price() const
-{
-	if (type == "C")
-	{
-		return CallPrice();
-	}
-	else
-	{
-		return PutPrice();
-	}
-}
-
-
-// Modifier functions
-void CashOrNothingOption::toggle()								//	Change the option type
-{
-	type = ((type == "C") ? "P" : "C");
-}
-
-// Global Functions
-double CashOrNothingCallPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string type)
-{
-	double d = (log(S / K) + (b - (sig * sig * 0.5)) * T) / (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return (cr * exp(-r * T) * cdf(standard_normal, d));
-}
-
-double CashOrNothingPutPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string type)
-{
-	double d = (log(S / K) + (b - (sig * sig * 0.5)) * T) / (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return (cr * exp(-r * T) * cdf(standard_normal, -d));
-}
-
+//	Objective: To implement the option class that is defined in the header file: CashOrNothingOption.hpp
+//
+// (c) Sudhansh Dua
+
+#include "CashOrNothingOption.hpp"
+#include "Numerics.hpp"
+#include <string>
+#include <cmath>
+
+using namespace std;
+using namespace Numerics;
+
+
+double CashOrNothingOption::CallPrice() const
+{
+	return CashOrNothingPrice<Call>(S, K, cr, T, r, sig, b);
+}
+
+double CashOrNothingOption::PutPrice() const
+{
+	return CashOrNothingPrice<Put>(S, K, cr, T, r, sig, b);
+}
+
+
+void CashOrNothingOption::init()					// Initialising all the default values
+{
+	//	Default values
+	T = 1;
+	cr = 10;
+	r = 0.08;
+	sig = 0.25;
+	K = 100;
+	S = 100;			//	Default stock price 
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+
+	type = OptionType::Call;			//	Call option as the default
+
+}
+
+void CashOrNothingOption::copy(const CashOrNothingOption& option)
+{
+	cr = option.cr;
+}
+
+//	Constructors and destructor
+//	Default Constructor
+CashOrNothingOption::CashOrNothingOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+CashOrNothingOption::CashOrNothingOption(const CashOrNothingOption& option) : Option(option)
+{
+	copy(option);
+}
+
+//	Constructor that accepts values
+CashOrNothingOption::CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const OptionType type1) : Option(S1, K1, T1, r1, sig1, b1, type1), cr(cr1) {}
+
+//	Constructor that parses the option type from a string
+CashOrNothingOption::CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1, const double& sig1,
+	const double& b1, const string& type1)
+	: CashOrNothingOption(S1, K1, cr1, T1, r1, sig1, b1, ParseOptionType(type1)) {}
+
+//	Destructor
+CashOrNothingOption::~CashOrNothingOption() {}
+
+
+//	Assignment Operator
+CashOrNothingOption& CashOrNothingOption::operator = (const CashOrNothingOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	copy(option);
+	return *this;
+}
+
+
+// Functions that calculate the option price
+double CashOrNothingOption::Price() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallPrice();
+	}
+	else
+	{
+		return PutPrice();
+	}
+}
+
+//	Price and sensitivities in one pass of the kernel on dual numbers
+OptionGreeks CashOrNothingOption::Greeks() const
+{
+	return AutoGreeks([this](const GreeksDual& S1, const GreeksDual& T1, const GreeksDual& r1, const GreeksDual& sig1, const GreeksDual& b1)
+	{
+		return (type == OptionType::Call) ? CashOrNothingPrice<Call>(S1, GreeksDual(K), GreeksDual(cr), T1, r1, sig1, b1) : CashOrNothingPrice<Put>(S1, GreeksDual(K), GreeksDual(cr), T1, r1, sig1, b1);
+	}, S, T, r, sig, b);
+}
+
+
+
+// Modifier functions
+void CashOrNothingOption::toggle()								//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+// Global Functions
+double CashOrNothingCallPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string& type)
+{
+	return CashOrNothingPrice<Call>(S, K, cr, T, r, sig, b);
+}
+
+double CashOrNothingPutPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string& type)
+{
+	return CashOrNothingPrice<Put>(S, K, cr, T, r, sig, b);
+}
+
+
+//	Batch kernel
+OPTION_TARGET_CLONES
+void BatchCashOrNothingPrice(const double* __restrict S, const double* __restrict K, const double* __restrict cr, const double* __restrict T, const double* __restrict r,
+	const double* __restrict sig, const double* __restrict b, const int* __restrict isCall, double* __restrict price, const size_t n)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double d = (Numerics::FastLog(S[i] / K[i]) + (b[i] - (sig[i] * sig[i] * 0.5)) * T[i]) / (sig[i] * Numerics::FastSqrt(T[i]));
+		double phi = (isCall[i] != 0) ? 1.0 : -1.0;
+
+		price[i] = cr[i] * Numerics::FastExp(-r[i] * T[i]) * Numerics::NormalCdf(phi * d);
+	}
+}
@@ -1,66 +1,74 @@
-// Class that represents solutions to CashOrNothing options
-//
-// (c) Sudhansh Dua
-//
-//	The cash-or-nothing options pay an amount CR at expiration if the option is in-the-money.
-//	The payoff from a call is 0 if S < K and CR, if S > K.
-//	The payoff from a put is 0 if S > Kand CR if S < K.
-
-
-#ifndef CashOrNothingOption_HPP
-#define CashOrNothingOption_HPP
-
-#include "Option.hpp"
-#include <string>
-using namespace std;
-
-class CashOrNothingOption : public Option
-{
-private:
-	// 'Kernel' functions for option calculations
-	double CallPrice() const;								//	Price of a CashOrNothing call option
-	double PutPrice() const;								//	Price of a CashOrNothing put option
-
-
-	void init();											// Initialise all default values
-	void copy(const CashOrNothingOption& option);			//	copies all values
-
-public:
-	//	Member data
-	double cr;			//	Cash Rebate
-	double T;			//	Time to expiry
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double K;			//	Strike Price
-	double S;			//	current stock price
-	double b;			//	Cost of carry
-	string type;		//	"C" - call option, "P" - put option
-
-
-	//	Constructors and the destructor
-	CashOrNothingOption();												//	default constructor
-	CashOrNothingOption(const CashOrNothingOption& option);				//	Copy constructor
-	CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1,
-		const double& sig1, const double& b1, const string type1);		//	constructor that accepts values
-	~CashOrNothingOption();												//	destructor
-
-
-	//	Assignment operator
-	CashOrNothingOption& operator = (const CashOrNothingOption& option);
-
-
-	// Functions that calculate the option price
-	double Price() const;
-
-
-	// Modifier functions
-	void toggle();					//	Change option type (Call to Put, Put to Call)
-
-};
-
-//	Global Functions
-double CashOrNothingCallPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string type);
-double CashOrNothingPutPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string type);
-
-#endif
-
+// Class that represents solutions to CashOrNothing options
+//
+// (c) Sudhansh Dua
+//
+//	The cash-or-nothing options pay an amount CR at expiration if the option is in-the-money.
+//	The payoff from a call is 0 if S < K and CR, if S > K.
+//	The payoff from a put is 0 if S > Kand CR if S < K.
+
+
+#ifndef CashOrNothingOption_HPP
+#define CashOrNothingOption_HPP
+
+#include "Option.hpp"
+#include <string>
+using namespace std;
+
+class CashOrNothingOption : public Option
+{
+private:
+	// 'Kernel' functions for option calculations
+	double CallPrice() const;								//	Price of a CashOrNothing call option
+	double PutPrice() const;								//	Price of a CashOrNothing put option
+
+
+	void init();											// Initialise all default values
+	void copy(const CashOrNothingOption& option);			//	copies all values
+
+public:
+	//	Member data
+	double cr;			//	Cash Rebate
+
+
+	//	Constructors and the destructor
+	CashOrNothingOption();												//	default constructor
+	CashOrNothingOption(const CashOrNothingOption& option);				//	Copy constructor
+	CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);		//	constructor that accepts values
+	CashOrNothingOption(const double& S1, const double& K1, const double& cr1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);		//	"C" - call option, "P" - put option
+	~CashOrNothingOption();												//	destructor
+
+
+	//	Assignment operator
+	CashOrNothingOption& operator = (const CashOrNothingOption& option);
+
+
+	// Functions that calculate the option price
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+double CashOrNothingCallPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string& type);
+double CashOrNothingPutPrice(const double S, const double K, const double cr, const double T, const double r, const double sig, const double b, const string& type);
+
+//	Compile-time kernel: CashOrNothingPrice<Call> or CashOrNothingPrice<Put>
+template <class Type, class Real>
+inline Real CashOrNothingPrice(const Real& S, const Real& K, const Real& cr, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	Real d = (log(S / K) + (b - (sig * sig * 0.5)) * T) / (sig * sqrt(T));
+	return (cr * exp(-r * T) * Numerics::NormalCdf(Type::phi * d));
+}
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call. The loop is vectorised and
+//	agrees with CashOrNothingPrice to within 1e-13 * cr (absolute).
+void BatchCashOrNothingPrice(const double* S, const double* K, const double* cr, const double* T, const double* r, const double* sig,
+	const double* b, const int* isCall, double* price, const size_t n);
+
+#endif
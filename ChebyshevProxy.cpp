@@ -0,0 +1,449 @@
+// Implementing the classes that are defined in the header file: ChebyshevProxy.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "ChebyshevProxy.hpp"
+#include "Numerics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+
+using namespace std;
+
+
+//	Axes, in the order of the arguments of Price
+enum ProxyAxis { AxisSpot, AxisVol, AxisTime, AxisRate, ProxyAxes };
+
+static const double Pi = 3.14159265358979323846;
+
+
+//	ChebyshevAxis
+ChebyshevAxis::ChebyshevAxis() : Lower(0.0), Upper(0.0), Degree(0) {}
+
+ChebyshevAxis::ChebyshevAxis(const double lower, const double upper, const size_t degree) : Lower(lower), Upper(upper), Degree(degree) {}
+
+
+static const ChebyshevAxis& AxisOf(const ProxyBox& box, const size_t axis)
+{
+	switch (axis)
+	{
+	case AxisSpot: return box.Spot;
+	case AxisVol: return box.Vol;
+	case AxisTime: return box.Time;
+	default: return box.Rate;
+	}
+}
+
+//	S, sig, T and r of the contract
+static void ContractInputs(const Product& product, double* inputs)
+{
+	visit([inputs](const auto& option)
+	{
+		inputs[AxisSpot] = option.S;
+		inputs[AxisVol] = option.sig;
+		inputs[AxisTime] = option.T;
+		inputs[AxisRate] = option.r;
+	}, product);
+}
+
+//	Exact price of the contract at the inputs, moving b with r and a chooser's choice date with T
+static double Reprice(const Product& product, const double* inputs)
+{
+	return visit([inputs](const auto& option)
+	{
+		typedef decay_t<decltype(option)> Kind;
+
+		Kind shifted(option);
+		shifted.S = inputs[AxisSpot];
+		shifted.sig = inputs[AxisVol];
+		shifted.T = inputs[AxisTime];
+		shifted.r = inputs[AxisRate];
+		shifted.b = (option.b != 0.0) ? option.b + (inputs[AxisRate] - option.r) : 0.0;
+		if constexpr (is_same<Kind, ChooserOption>::value)
+		{
+			shifted.t = option.t + (inputs[AxisTime] - option.T);
+		}
+		return shifted.Price();
+	}, product);
+}
+
+
+//	T_0(x) .. T_{n-1}(x), with t room for n rounded up to a multiple of four. T_0 .. T_7 come from the double-angle
+//	forms and the rest from T_k = 2 T_4 T_{k-4} - T_{k-8}: four independent chains, held in registers, instead of the
+//	one chain of the three-term recurrence
+static void ChebyshevTable(const double x, const size_t n, double* t)
+{
+	const double x2 = 2.0 * x * x - 1.0;
+	const double x3 = x * (2.0 * x2 - 1.0);
+	const double x4 = 2.0 * x2 * x2 - 1.0;
+	double q[4] = { 1.0, x, x2, x3 };
+	double p[4] = { x4, 2.0 * x2 * x3 - x, 2.0 * x3 * x3 - 1.0, 2.0 * x3 * x4 - x };
+	const double twoT4 = 2.0 * x4;
+
+	for (size_t j = 0; j < 4; ++j)
+	{
+		t[j] = q[j];
+		t[4 + j] = p[j];
+	}
+	for (size_t k = 8; k < n; k += 4)
+	{
+		for (size_t j = 0; j < 4; ++j)
+		{
+			const double next = twoT4 * p[j] - q[j];
+			q[j] = p[j];
+			p[j] = next;
+			t[k + j] = next;
+		}
+	}
+}
+
+//	One axis of the tensor: c holds n rows of m coefficients, out[i] = sum_k t[k] c[k][i]
+OPTION_TARGET_CLONES
+static void ContractRows(const double* __restrict c, const size_t n, const size_t m, const double* __restrict t,
+	double* __restrict out)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < m; ++i)
+	{
+		out[i] = t[0] * c[i];
+	}
+	for (size_t k = 1; k < n; ++k)
+	{
+		const double* row = c + k * m;
+		const double tk = t[k];
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < m; ++i)
+		{
+			out[i] += tk * row[i];
+		}
+	}
+}
+
+//	Innermost axis: sum_k t[k] c[k], over four partial sums
+static double ContractLast(const double* c, const size_t n, const double* t)
+{
+	double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+	size_t k = 0;
+	for (; k + 4 <= n; k += 4)
+	{
+		s0 += t[k] * c[k];
+		s1 += t[k + 1] * c[k + 1];
+		s2 += t[k + 2] * c[k + 2];
+		s3 += t[k + 3] * c[k + 3];
+	}
+	for (; k < n; ++k)
+	{
+		s0 += t[k] * c[k];
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+
+//	ChebyshevProxy
+
+//	Constructors and destructor
+ChebyshevProxy::ChebyshevProxy(const Product& product, const ProxyBox& box1)
+	: contract(product), values(), box(box1), axes(), points(), coefficients(), fitError(0.0), tailEstimate(0.0)
+{
+	ContractInputs(contract, values);
+
+	//	Active axes, outermost first
+	for (size_t axis = ProxyAxes; axis-- > 0;)
+	{
+		const ChebyshevAxis& range = AxisOf(box, axis);
+		if (range.Degree == 0)
+		{
+			continue;
+		}
+		if (!(range.Lower < range.Upper) || range.Degree > ChebyshevMaxDegree)
+		{
+			throw invalid_argument("ChebyshevProxy: an axis needs Lower < Upper and a degree of at most ChebyshevMaxDegree");
+		}
+		if (axis != AxisRate && !(range.Lower > 0.0))
+		{
+			throw invalid_argument("ChebyshevProxy: the spot, volatility and time ranges must be positive");
+		}
+		axes.push_back(axis);
+		points.push_back(range.Degree + 1);
+	}
+
+	if (holds_alternative<BarrierOption>(contract) && box.Spot.Degree > 0)
+	{
+		const double H = get<BarrierOption>(contract).H;
+		if (box.Spot.Lower < H && box.Spot.Upper >= H)
+		{
+			throw invalid_argument("ChebyshevProxy: the spot range of a barrier option may not straddle the barrier");
+		}
+	}
+	if (holds_alternative<ChooserOption>(contract) && box.Time.Degree > 0)
+	{
+		const ChooserOption& chooser = get<ChooserOption>(contract);
+		if (!(chooser.t + (box.Time.Lower - chooser.T) > 0.0))
+		{
+			throw invalid_argument("ChebyshevProxy: the time range would put the choice date of the chooser in the past");
+		}
+	}
+
+	const size_t d = axes.size();
+	size_t total = 1;
+	for (size_t p : points)
+	{
+		total *= p;
+	}
+
+	//	Exact prices at the Chebyshev points of the first kind, x_k = cos(pi (k + 1/2) / n)
+	coefficients.resize(total);
+	for (size_t flat = 0; flat < total; ++flat)
+	{
+		double inputs[ProxyAxes] = { values[0], values[1], values[2], values[3] };
+		for (size_t a = 0, rest = flat; a < d; ++a)
+		{
+			size_t inner = 1;
+			for (size_t b = a + 1; b < d; ++b)
+			{
+				inner *= points[b];
+			}
+			const size_t k = rest / inner;
+			rest %= inner;
+
+			const ChebyshevAxis& range = AxisOf(box, axes[a]);
+			const double x = cos(Pi * (static_cast<double>(k) + 0.5) / static_cast<double>(points[a]));
+			inputs[axes[a]] = 0.5 * (range.Lower + range.Upper) + 0.5 * (range.Upper - range.Lower) * x;
+		}
+		coefficients[flat] = Reprice(contract, inputs);
+	}
+
+	//	Discrete cosine transform along each axis: c_j = (2 / n) sum_k f_k cos(pi j (k + 1/2) / n), c_0 halved
+	for (size_t a = 0; a < d; ++a)
+	{
+		const size_t n = points[a];
+		size_t inner = 1, outer = 1;
+		for (size_t b = a + 1; b < d; ++b)
+		{
+			inner *= points[b];
+		}
+		for (size_t b = 0; b < a; ++b)
+		{
+			outer *= points[b];
+		}
+
+		vector<double> f(n), cosines(n * n);
+		for (size_t j = 0; j < n; ++j)
+		{
+			for (size_t k = 0; k < n; ++k)
+			{
+				cosines[j * n + k] = cos(Pi * static_cast<double>(j) * (static_cast<double>(k) + 0.5) / static_cast<double>(n));
+			}
+		}
+
+		for (size_t o = 0; o < outer; ++o)
+		{
+			for (size_t i = 0; i < inner; ++i)
+			{
+				double* line = coefficients.data() + o * n * inner + i;
+				for (size_t k = 0; k < n; ++k)
+				{
+					f[k] = line[k * inner];
+				}
+				for (size_t j = 0; j < n; ++j)
+				{
+					double sum = 0.0;
+					for (size_t k = 0; k < n; ++k)
+					{
+						sum += f[k] * cosines[j * n + k];
+					}
+					line[j * inner] = ((j == 0) ? 1.0 : 2.0) * sum / static_cast<double>(n);
+				}
+			}
+		}
+	}
+
+	//	Truncation estimate: the coefficients of the highest degree of any axis
+	for (size_t flat = 0; flat < total; ++flat)
+	{
+		bool top = false;
+		for (size_t a = 0, rest = flat; a < d; ++a)
+		{
+			size_t inner = 1;
+			for (size_t b = a + 1; b < d; ++b)
+			{
+				inner *= points[b];
+			}
+			top = top || (rest / inner == points[a] - 1);
+			rest %= inner;
+		}
+		if (top)
+		{
+			tailEstimate += fabs(coefficients[flat]);
+		}
+	}
+
+	//	Check against the exact price at the Chebyshev extrema, x_k = cos(pi k / n), k = 0 .. n
+	size_t checks = 1;
+	for (size_t p : points)
+	{
+		checks *= p + 1;
+	}
+	for (size_t flat = 0; flat < checks; ++flat)
+	{
+		double inputs[ProxyAxes] = { values[0], values[1], values[2], values[3] };
+		double x[ProxyAxes];
+		for (size_t a = 0, rest = flat; a < d; ++a)
+		{
+			size_t inner = 1;
+			for (size_t b = a + 1; b < d; ++b)
+			{
+				inner *= points[b] + 1;
+			}
+			const size_t k = rest / inner;
+			rest %= inner;
+
+			const ChebyshevAxis& range = AxisOf(box, axes[a]);
+			x[a] = cos(Pi * static_cast<double>(k) / static_cast<double>(points[a]));
+			inputs[axes[a]] = 0.5 * (range.Lower + range.Upper) + 0.5 * (range.Upper - range.Lower) * x[a];
+		}
+		fitError = max(fitError, fabs(Interpolate(x) - Reprice(contract, inputs)));
+	}
+}
+
+ChebyshevProxy::ChebyshevProxy(const ChebyshevProxy& proxy)
+	: contract(proxy.contract), values{ proxy.values[0], proxy.values[1], proxy.values[2], proxy.values[3] }, box(proxy.box), axes(proxy.axes), points(proxy.points), coefficients(proxy.coefficients),
+	fitError(proxy.fitError), tailEstimate(proxy.tailEstimate) {}
+
+ChebyshevProxy::~ChebyshevProxy() {}
+
+ChebyshevProxy& ChebyshevProxy::operator = (const ChebyshevProxy& proxy)
+{
+	if (this == &proxy)
+	{
+		return *this;
+	}
+
+	contract = proxy.contract;
+	copy(proxy.values, proxy.values + ProxyAxes, values);
+	box = proxy.box;
+	axes = proxy.axes;
+	points = proxy.points;
+	coefficients = proxy.coefficients;
+	fitError = proxy.fitError;
+	tailEstimate = proxy.tailEstimate;
+
+	return *this;
+}
+
+
+double ChebyshevProxy::Interpolate(const double* x) const
+{
+	const size_t d = axes.size();
+	if (d == 0)
+	{
+		return coefficients[0];
+	}
+
+	double t[ProxyAxes][ChebyshevMaxDegree + 8];
+	for (size_t a = 0; a < d; ++a)
+	{
+		ChebyshevTable(x[a], points[a], t[a]);
+	}
+	if (d == 1)
+	{
+		return ContractLast(coefficients.data(), points[0], t[0]);
+	}
+
+	//	Outer axes: one contraction each, into alternating halves of the work area
+	size_t m = coefficients.size() / points[0];
+	static thread_local vector<double> work;
+	if (work.size() < 2 * m)
+	{
+		work.resize(2 * m);
+	}
+	double* result[2] = { work.data(), work.data() + m };
+
+	const double* c = coefficients.data();
+	for (size_t a = 0; a + 1 < d; ++a)
+	{
+		double* out = result[a & 1];
+		ContractRows(c, points[a], m, t[a], out);
+		c = out;
+		m /= points[a + 1];
+	}
+
+	return ContractLast(c, points[d - 1], t[d - 1]);
+}
+
+
+bool ChebyshevProxy::Inside(const double S, const double sig, const double T, const double r) const
+{
+	const double inputs[ProxyAxes] = { S, sig, T, r };
+
+	for (size_t axis = 0; axis < ProxyAxes; ++axis)
+	{
+		const ChebyshevAxis& range = AxisOf(box, axis);
+		bool inside = (range.Degree == 0) ? (inputs[axis] == values[axis]) : (inputs[axis] >= range.Lower && inputs[axis] <= range.Upper);
+		if (!inside)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+double ChebyshevProxy::Price(const double S, const double sig, const double T, const double r) const
+{
+	if (!Inside(S, sig, T, r))
+	{
+		return ExactPrice(S, sig, T, r);
+	}
+
+	const double inputs[ProxyAxes] = { S, sig, T, r };
+	double x[ProxyAxes];
+	for (size_t a = 0; a < axes.size(); ++a)
+	{
+		const ChebyshevAxis& range = AxisOf(box, axes[a]);
+		x[a] = (2.0 * inputs[axes[a]] - (range.Lower + range.Upper)) / (range.Upper - range.Lower);
+	}
+	return Interpolate(x);
+}
+
+double ChebyshevProxy::Price(const double S) const
+{
+	return Price(S, values[AxisVol], values[AxisTime], values[AxisRate]);
+}
+
+
+double ChebyshevProxy::ExactPrice(const double S, const double sig, const double T, const double r) const
+{
+	const double inputs[ProxyAxes] = { S, sig, T, r };
+	return Reprice(contract, inputs);
+}
+
+
+double ChebyshevProxy::ErrorBound() const
+{
+	return max(fitError, tailEstimate);
+}
+
+double ChebyshevProxy::CheckError() const
+{
+	return fitError;
+}
+
+size_t ChebyshevProxy::Coefficients() const
+{
+	return coefficients.size();
+}
+
+
+const ProxyBox& ChebyshevProxy::Box() const
+{
+	return box;
+}
+
+const Product& ChebyshevProxy::Contract() const
+{
+	return contract;
+}
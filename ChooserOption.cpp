@@ -1,121 +1,132 @@
-// Implementing the class that is defined in the header file: ChooserOption.hpp
-//
-// (c) Sudhansh Dua
-
-
-
-#include "ChooserOption.hpp"
-#include <string>
-#include <boost/math/distributions.hpp>
-#include <cmath>
-
-
-using namespace std;
-using namespace boost::math;
-
-
-//	Gaussian functions using boost libraries
-double ChooserOption::N(double x) const
-{
-	normal_distribution<> Standard_normal(0.0, 1.0);
-	return cdf(Standard_normal, x);
-}
-
-double ChooserOption::n(double x) const
-{
-	normal_distribution<> Standard_normal(0.0, 1.0);
-	return pdf(Standard_normal, x);
-}
-
-
-double ChooserOption::ChooserPrice() const
-{
-	return ::ChooserPrice(S, K, T, t, r, sig, b);
-}
-
-
-// Initialising all the default values
-void ChooserOption::init()					
-{
-	//	Default values
-	r = 0.03;
-	sig = 0.2;
-	K = 105;
-	S = 100;			//	Default stock price 
-	b = r;				//	Black - Scholes(1973) stock option model : b = r
-	T = 1;				
-	t = 0.5;			//	time that has passed since t = 0
-
-}
-
-
-void ChooserOption::copy(const ChooserOption& option)
-{
-	r = option.r;
-	t = option.t;
-	T = option.T;
-	sig = option.sig;
-	K = option.K;
-	b = option.b;
-	S = option.S;
-}
-
-
-//	Constructors and destructor
-//	Default Constructor
-ChooserOption::ChooserOption() : Option()
-{
-	init();
-}
-
-//	Copy constructor
-ChooserOption::ChooserOption(const ChooserOption& option) : Option(option)
-{
-	copy(option);
-}
-
-//	Constructor that accepts values
-ChooserOption::ChooserOption(const double& S1, const double& K1, const double& T1, const double& t1, const double& r1,
-	const double& sig1, const double& b1) : Option(), S(S1), K(K1), T(T1), t(t1), r(r1), sig(sig1), b(b1) {}
-
-//	Destructor
-ChooserOption::~ChooserOption() {}
-
-
-//	Assignment Operator
-ChooserOption& ChooserOption::operator = (const ChooserOption& option)
-{
-	if (this == &option)
-	{
-		return *this;		//	Self-assignment check!
-	}
-	Option::operator = (option);
-	copy(option);
-	return *this;
-}
-
-
-// Member function that calculate the option price
-double ChooserOption::Price() const
-{
-	return ChooserPrice();
-}
-
-
-// Global functions
-double ChooserPrice(const double S, const double K, const double T, const double t, const double r, const double sig, const double b)
-{
-
-	double y1 = (log(S / K) + (b * T) + (sig * sig * 0.5 * t)) / (sig * sqrt(t));
-	double y2 = y1 - (sig * sqrt(t));
-
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-
-	normal_distribution<> standard_normal(0.0, 1.0);
-
-	double w = (S * exp((b - r) * T) * cdf(standard_normal, d1)) - (K * exp(-r * T) * cdf(standard_normal, d2)) - (S * exp((b - r) * T) * cdf(standard_normal, -y1)) + (K * exp(-r * T) * cdf(standard_normal, -y2));
-	return w;
-
-}
-
+// Implementing the class that is defined in the header file: ChooserOption.hpp
+//
+// (c) Sudhansh Dua
+
+
+
+#include "ChooserOption.hpp"
+#include "Numerics.hpp"
+#include <string>
+#include <cmath>
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Gaussian functions
+double ChooserOption::N(double x) const
+{
+	return NormalCdf(x);
+}
+
+double ChooserOption::n(double x) const
+{
+	return NormalPdf(x);
+}
+
+
+double ChooserOption::ChooserPrice() const
+{
+	return ::ChooserPrice(S, K, T, t, r, sig, b);
+}
+
+
+// Initialising all the default values
+void ChooserOption::init()					
+{
+	//	Default values
+	r = 0.03;
+	sig = 0.2;
+	K = 105;
+	S = 100;			//	Default stock price 
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+	T = 1;				
+	t = 0.5;			//	time that has passed since t = 0
+
+}
+
+
+void ChooserOption::copy(const ChooserOption& option)
+{
+	t = option.t;
+}
+
+
+//	Constructors and destructor
+//	Default Constructor
+ChooserOption::ChooserOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+ChooserOption::ChooserOption(const ChooserOption& option) : Option(option)
+{
+	copy(option);
+}
+
+//	Constructor that accepts values
+ChooserOption::ChooserOption(const double& S1, const double& K1, const double& T1, const double& t1, const double& r1,
+	const double& sig1, const double& b1) : Option(S1, K1, T1, r1, sig1, b1, OptionType::Call), t(t1) {}
+
+//	Destructor
+ChooserOption::~ChooserOption() {}
+
+
+//	Assignment Operator
+ChooserOption& ChooserOption::operator = (const ChooserOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	copy(option);
+	return *this;
+}
+
+
+// Member function that calculate the option price
+double ChooserOption::Price() const
+{
+	return ChooserPrice();
+}
+
+//	Price and sensitivities in one pass of the kernel on dual numbers. The choice date moves with the expiry,
+//	so theta is the time decay of both.
+OptionGreeks ChooserOption::Greeks() const
+{
+	return AutoGreeks([this](const GreeksDual& S1, const GreeksDual& T1, const GreeksDual& r1, const GreeksDual& sig1, const GreeksDual& b1)
+	{
+		GreeksDual t1(T1);
+		t1.v = t;
+		return ::ChooserPrice(S1, GreeksDual(K), T1, t1, r1, sig1, b1);
+	}, S, T, r, sig, b);
+}
+
+
+//	Batch kernel
+OPTION_TARGET_CLONES
+void BatchChooserPrice(const double* __restrict S, const double* __restrict K, const double* __restrict T, const double* __restrict t, const double* __restrict r,
+	const double* __restrict sig, const double* __restrict b, double* __restrict price, const size_t n)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double logSK = Numerics::FastLog(S[i] / K[i]);
+		double sigSqrtt = sig[i] * Numerics::FastSqrt(t[i]);
+		double sigSqrtT = sig[i] * Numerics::FastSqrt(T[i]);
+
+		double y1 = (logSK + (b[i] * T[i]) + (sig[i] * sig[i] * 0.5 * t[i])) / sigSqrtt;
+		double y2 = y1 - sigSqrtt;
+		double d1 = (logSK + (b[i] + (sig[i] * sig[i]) * 0.5) * T[i]) / sigSqrtT;
+		double d2 = d1 - sigSqrtT;
+
+		double forward = S[i] * Numerics::FastExp((b[i] - r[i]) * T[i]);
+		double strike = K[i] * Numerics::FastExp(-r[i] * T[i]);
+
+		price[i] = (forward * Numerics::NormalCdf(d1)) - (strike * Numerics::NormalCdf(d2)) - (forward * Numerics::NormalCdf(-y1))
+			+ (strike * Numerics::NormalCdf(-y2));
+	}
+}
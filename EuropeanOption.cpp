@@ -1,350 +1,430 @@
-// Implementing the class that is defined in the header file: Option.hpp
-//
-// (c) Sudhansh Dua
-
-
-#include "EuropeanOption.hpp"
-#include <cmath>
-#include <boost/math/distributions.hpp>
-
-using namespace std;
-using namespace boost::math;
-
-
-//	Gaussian functions using boost libraries
-double EuropeanOption::N(double x) const
-{
-	normal_distribution<> Standard_normal(0.0, 1.0);
-	return cdf(Standard_normal, x);
-}
-
-double EuropeanOption::n(double x) const
-{
-	normal_distribution<> Standard_normal(0.0, 1.0);
-	return pdf(Standard_normal, x);
-}
-
-//	Kernel functions
-double EuropeanOption::CallPrice() const
-{
-	return ::CallPrice(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutPrice() const
-{
-	return ::PutPrice(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallDelta() const
-{
-	return ::CallDelta(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutDelta() const
-{
-	return ::PutDelta(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallGamma() const
-{
-	return ::CallGamma(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutGamma() const
-{
-	return ::PutGamma(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallVega() const
-{
-	return ::CallVega(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutVega() const
-{
-	return ::PutVega(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallTheta() const
-{
-	return ::CallTheta(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutTheta() const
-{
-	return ::PutTheta(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallRho() const
-{
-	return ::CallRho(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::PutRho() const
-{
-	return ::PutRho(S, K, T, r, sig, b);
-}
-
-double EuropeanOption::CallCoc() const
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	return T * S * exp((b - r) * T) * N(d1);
-}
-
-double EuropeanOption::PutCoc() const
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	return -T * S * exp((b - r) * T) * N(-d1);
-}
-
-
-//	Initialising all the default values
-void EuropeanOption::init()
-{
-	//	Default values
-	r = 0.03;
-	sig = 0.2;
-	K = 100;
-	S = 95;				//	Default stock price 
-	T = 1;
-	b = r;				//	Black - Scholes(1973) stock option model : b = r
-	type = "C";			//	Call option as the default
-}
-
-
-void EuropeanOption::copy(const EuropeanOption& option)
-{
-	S = option.S;
-	K = option.K;
-	T = option.T;
-	r = option.r;
-	sig = option.sig;
-	b = option.b;
-	type = option.type;
-}
-
-//	Constructors and destructor
-EuropeanOption::EuropeanOption() : Option()						//	Default constructor
-{
-	init();
-}
-
-EuropeanOption::EuropeanOption(const EuropeanOption& option) : Option(option)		//	Copy constructor
-{
-	copy(option);
-}
-
-//	Constructor that accepts values
-EuropeanOption::EuropeanOption(const double& S1, const double& K1, const double& T1, const double& r1,
-	const double& sig1, const double& b1, const string type1) : Option(), S(S1), K(K1), T(T1), r(r1), sig(sig1), b(b1), type(type1) {}
-
-EuropeanOption::~EuropeanOption() {}							//	Destructor
-
-
-//	Assignment operator
-EuropeanOption& EuropeanOption::operator = (const EuropeanOption& option)
-{
-	if (this == &option)
-	{
-		return *this;
-	}
-	Option::operator = (option);
-	copy(option);
-	return *this;
-}
-
-
-//	Functions that calculate option price and sensitivities
-double EuropeanOption::Price() const
-{
-	if (type == "C")
-	{
-		return CallPrice();
-	}
-	else
-	{
-		return PutPrice();
-	}
-}
-
-double EuropeanOption::Delta() const
-{
-	if (type == "C")
-	{
-		return CallDelta();
-	}
-	else
-	{
-		return PutDelta();
-	}
-}
-
-double EuropeanOption::Gamma() const
-{
-	if (type == "C")
-	{
-		return CallGamma();
-	}
-	else
-	{
-		return PutGamma();
-	}
-}
-
-double EuropeanOption::Vega() const
-{
-	if (type == "C")
-	{
-		return CallVega();
-	}
-	else
-	{
-		return PutVega();
-	}
-}
-
-double EuropeanOption::Theta() const
-{
-	if (type == "C")
-	{
-		return CallTheta();
-	}
-	else
-	{
-		return PutTheta();
-	}
-}
-
-double EuropeanOption::Rho() const
-{
-	if (type == "C")
-	{
-		return CallRho();
-	}
-	else
-	{
-		return PutRho();
-	}
-}
-
-
-//	Functions that calculates the Cost of carry
-double EuropeanOption::Coc() const
-{
-	if (type == "C")
-	{
-		return CallCoc();
-	}
-	else
-	{
-		return PutCoc();
-	}
-}
-
-
-// Modifier functions
-void EuropeanOption::toggle()				//	Change the option type
-{
-	type = ((type == "C") ? "P" : "C");
-}
-
-
-//	Global Functions
-double CallDelta(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return exp((b - r) * T) * cdf(standard_normal, d1);
-
-}
-
-double PutDelta(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return exp((b - r) * T) * (cdf(standard_normal, d1) - 1.0);
-}
-
-
-double CallGamma(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return (pdf(standard_normal, d1) * exp((b - r) * T)) / (S * sig * sqrt(T));
-}
-
-double PutGamma(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	return CallGamma(S, K, T, r, sig, b);
-}
-
-
-double CallVega(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	return (S * sqrt(T) * exp((b - r) * T) * pdf(standard_normal, d1));
-}
-
-
-double PutVega(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	return CallVega(S, K, T, r, sig, b);
-}
-
-
-double CallTheta(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	double t1 = (S * sig * exp((b - r) * T) * pdf(standard_normal, d1)) / (2 * sqrt(T));
-	double t2 = ((b - r) * S * exp((b - r) * T) * cdf(standard_normal, d1));
-	double t3 = (r * K * exp(-r * T) * cdf(standard_normal, d1));
-	return -(t1 + t2 + t3);
-}
-
-double PutTheta(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	double t1 = (S * sig * exp((b - r) * T) * pdf(standard_normal, d1)) / (2 * sqrt(T));
-	double t2 = ((b - r) * S * exp((b - r) * T) * cdf(standard_normal, d1));
-	double t3 = (r * K * exp(-r * T) * cdf(standard_normal, d1));
-	return t2 + t3 - t1;
-}
-
-
-double CallRho(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	if (b != 0.0)
-	{
-		return T * K * exp(-r * T) * cdf(standard_normal, d2);
-	}
-	else
-	{
-		return -T * CallPrice(S, K, T, r, sig, b);
-	}
-}
-
-double PutRho(const double S, const double K, const double T, const double r, const double sig, const double b)
-{
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> standard_normal(0.0, 1.0);
-	if (b != 0.0)
-	{
-		return T * K * exp(-r * T) * cdf(standard_normal, -d2);
-	}
-	else
-	{
-		return -T * PutPrice(S, K, T, r, sig, b);
-	}
-}
+// Implementing the class that is defined in the header file: Option.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "EuropeanOption.hpp"
+#include "Numerics.hpp"
+#include "ImpliedVolatility.hpp"
+#include <cmath>
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Gaussian functions
+double EuropeanOption::N(double x) const
+{
+	return NormalCdf(x);
+}
+
+double EuropeanOption::n(double x) const
+{
+	return NormalPdf(x);
+}
+
+//	Kernel functions
+double EuropeanOption::CallPrice() const
+{
+	return ::CallPrice(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutPrice() const
+{
+	return ::PutPrice(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallDelta() const
+{
+	return ::CallDelta(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutDelta() const
+{
+	return ::PutDelta(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallGamma() const
+{
+	return ::CallGamma(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutGamma() const
+{
+	return ::PutGamma(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallVega() const
+{
+	return ::CallVega(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutVega() const
+{
+	return ::PutVega(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallTheta() const
+{
+	return ::CallTheta(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutTheta() const
+{
+	return ::PutTheta(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallRho() const
+{
+	return ::CallRho(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::PutRho() const
+{
+	return ::PutRho(S, K, T, r, sig, b);
+}
+
+double EuropeanOption::CallCoc() const
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	return T * S * exp((b - r) * T) * N(d1);
+}
+
+double EuropeanOption::PutCoc() const
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	return -T * S * exp((b - r) * T) * N(-d1);
+}
+
+
+//	Initialising all the default values
+void EuropeanOption::init()
+{
+	//	Default values
+	r = 0.03;
+	sig = 0.2;
+	K = 100;
+	S = 95;				//	Default stock price 
+	T = 1;
+	b = r;				//	Black - Scholes(1973) stock option model : b = r
+	type = OptionType::Call;			//	Call option as the default
+}
+
+
+//	Constructors and destructor
+EuropeanOption::EuropeanOption() : Option()						//	Default constructor
+{
+	init();
+}
+
+EuropeanOption::EuropeanOption(const EuropeanOption& option) : Option(option) {}		//	Copy constructor
+
+//	Constructor that accepts values
+EuropeanOption::EuropeanOption(const double& S1, const double& K1, const double& T1, const double& r1,
+	const double& sig1, const double& b1, const OptionType type1) : Option(S1, K1, T1, r1, sig1, b1, type1) {}
+
+//	Constructor that parses the option type from a string
+EuropeanOption::EuropeanOption(const double& S1, const double& K1, const double& T1, const double& r1,
+	const double& sig1, const double& b1, const string& type1)
+	: EuropeanOption(S1, K1, T1, r1, sig1, b1, ParseOptionType(type1)) {}
+
+EuropeanOption::~EuropeanOption() {}							//	Destructor
+
+
+//	Assignment operator
+EuropeanOption& EuropeanOption::operator = (const EuropeanOption& option)
+{
+	if (this == &option)
+	{
+		return *this;
+	}
+	Option::operator = (option);
+	return *this;
+}
+
+
+//	Functions that calculate option price and sensitivities
+double EuropeanOption::Price() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallPrice();
+	}
+	else
+	{
+		return PutPrice();
+	}
+}
+
+double EuropeanOption::Delta() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallDelta();
+	}
+	else
+	{
+		return PutDelta();
+	}
+}
+
+double EuropeanOption::Gamma() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallGamma();
+	}
+	else
+	{
+		return PutGamma();
+	}
+}
+
+double EuropeanOption::Vega() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallVega();
+	}
+	else
+	{
+		return PutVega();
+	}
+}
+
+double EuropeanOption::Theta() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallTheta();
+	}
+	else
+	{
+		return PutTheta();
+	}
+}
+
+double EuropeanOption::Rho() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallRho();
+	}
+	else
+	{
+		return PutRho();
+	}
+}
+
+
+//	Functions that calculates the Cost of carry
+double EuropeanOption::Coc() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallCoc();
+	}
+	else
+	{
+		return PutCoc();
+	}
+}
+
+
+//	Price and all sensitivities in one pass
+OptionGreeks EuropeanOption::Greeks() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallGreeks(S, K, T, r, sig, b);
+	}
+	else
+	{
+		return PutGreeks(S, K, T, r, sig, b);
+	}
+}
+
+
+//	Implied volatility from a market price; the option's own sig is not used
+double EuropeanOption::ImpliedVol(const double price) const
+{
+	return ::ImpliedVol(price, S, K, T, r, b, type).Vol;
+}
+
+
+// Modifier functions
+void EuropeanOption::toggle()				//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+
+//	Global Functions
+double CallDelta(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+
+	return exp((b - r) * T) * NormalCdf(d1);
+
+}
+
+double PutDelta(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	return exp((b - r) * T) * (NormalCdf(d1) - 1.0);
+}
+
+
+double CallGamma(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return (NormalPdf(d1) * exp((b - r) * T)) / (S * sig * sqrt(T));
+}
+
+double PutGamma(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	return CallGamma(S, K, T, r, sig, b);
+}
+
+
+double CallVega(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	return (S * sqrt(T) * exp((b - r) * T) * NormalPdf(d1));
+}
+
+
+double PutVega(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	return CallVega(S, K, T, r, sig, b);
+}
+
+
+double CallTheta(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	double t1 = (S * sig * exp((b - r) * T) * NormalPdf(d1)) / (2 * sqrt(T));
+	double t2 = ((b - r) * S * exp((b - r) * T) * NormalCdf(d1));
+	double t3 = (r * K * exp(-r * T) * NormalCdf(d2));
+	return -(t1 + t2 + t3);
+}
+
+double PutTheta(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	double t1 = (S * sig * exp((b - r) * T) * NormalPdf(d1)) / (2 * sqrt(T));
+	double t2 = ((b - r) * S * exp((b - r) * T) * NormalCdf(-d1));
+	double t3 = (r * K * exp(-r * T) * NormalCdf(-d2));
+	return t2 + t3 - t1;
+}
+
+
+double CallRho(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	if (b != 0.0)
+	{
+		return T * K * exp(-r * T) * NormalCdf(d2);
+	}
+	else
+	{
+		return -T * CallPrice(S, K, T, r, sig, b);
+	}
+}
+
+double PutRho(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	if (b != 0.0)
+	{
+		return -T * K * exp(-r * T) * NormalCdf(-d2);
+	}
+	else
+	{
+		return -T * PutPrice(S, K, T, r, sig, b);
+	}
+}
+
+
+//	Fused kernels
+//
+//	phi = +1 for calls and -1 for puts. From the shared intermediates
+//		carry = exp((b - r)T), df = exp(-rT), Nphi1 = N(phi * d1), Nphi2 = N(phi * d2), nd1 = n(d1)
+//	every quantity follows without further transcendental calls.
+static inline OptionGreeks AssembleGreeks(const double phi, const double S, const double K, const double T, const double r,
+	const double sig, const double b, const double sqrtT, const double carry, const double df, const double Nphi1,
+	const double Nphi2, const double nd1)
+{
+	OptionGreeks g;
+
+	g.Price = phi * ((S * carry * Nphi1) - (K * df * Nphi2));
+	g.Delta = phi * carry * Nphi1;
+	g.Gamma = (nd1 * carry) / (S * sig * sqrtT);
+	g.Vega = S * sqrtT * carry * nd1;
+
+	double t1 = (S * sig * carry * nd1) / (2 * sqrtT);
+	double t2 = (b - r) * S * carry * Nphi1;
+	double t3 = r * K * df * Nphi2;
+	g.Theta = -t1 - phi * (t2 + t3);
+
+	g.Rho = (b != 0.0) ? phi * T * K * df * Nphi2 : -T * g.Price;
+	g.Coc = phi * T * S * carry * Nphi1;
+
+	return g;
+}
+
+static OptionGreeks FusedGreeks(const double phi, const double S, const double K, const double T, const double r,
+	const double sig, const double b)
+{
+	double sqrtT = sqrt(T);
+	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrtT);
+	double d2 = d1 - (sig * sqrtT);
+
+	return AssembleGreeks(phi, S, K, T, r, sig, b, sqrtT, exp((b - r) * T), exp(-r * T),
+		NormalCdf(phi * d1), NormalCdf(phi * d2), NormalPdf(d1));
+}
+
+OptionGreeks CallGreeks(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	return FusedGreeks(1.0, S, K, T, r, sig, b);
+}
+
+OptionGreeks PutGreeks(const double S, const double K, const double T, const double r, const double sig, const double b)
+{
+	return FusedGreeks(-1.0, S, K, T, r, sig, b);
+}
+
+
+//	Batch kernel
+OPTION_TARGET_CLONES
+void BatchGreeks(const double* __restrict S, const double* __restrict K, const double* __restrict T, const double* __restrict r,
+	const double* __restrict sig, const double* __restrict b, const int* __restrict isCall, double* __restrict price,
+	double* __restrict delta, double* __restrict gamma, double* __restrict vega, double* __restrict theta,
+	double* __restrict rho, double* __restrict coc, const size_t n)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double phi = (isCall[i] != 0) ? 1.0 : -1.0;
+		double sqrtT = FastSqrt(T[i]);
+		double d1 = (FastLog(S[i] / K[i]) + (b[i] + (sig[i] * sig[i]) * 0.5) * T[i]) / (sig[i] * sqrtT);
+		double d2 = d1 - (sig[i] * sqrtT);
+
+		OptionGreeks g = AssembleGreeks(phi, S[i], K[i], T[i], r[i], sig[i], b[i], sqrtT, FastExp((b[i] - r[i]) * T[i]),
+			FastExp(-r[i] * T[i]), NormalCdf(phi * d1), NormalCdf(phi * d2), NormalPdf(d1));
+
+		price[i] = g.Price;
+		delta[i] = g.Delta;
+		gamma[i] = g.Gamma;
+		vega[i] = g.Vega;
+		theta[i] = g.Theta;
+		rho[i] = g.Rho;
+		coc[i] = g.Coc;
+	}
+}
@@ -0,0 +1,446 @@
+// Implementing the classes and functions that are defined in the header file: HistoricalVaR.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "HistoricalVaR.hpp"
+#include "ScenarioEngine.hpp"
+#include "ScenarioKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Reading the history
+
+//	Parses one number of a line, surrounded by optional blanks; false if it is not a number
+static bool ParseNumber(const string& field, double& value)
+{
+	const char* begin = field.c_str();
+	char* end = nullptr;
+	value = strtod(begin, &end);
+	if (end == begin)
+	{
+		return false;
+	}
+	while (*end == ' ' || *end == '\t' || *end == '\r')
+	{
+		++end;
+	}
+	return *end == '\0';
+}
+
+vector<MarketMove> ReadMarketMoves(const string& file)
+{
+	ifstream in(file);
+	if (!in)
+	{
+		throw runtime_error("ReadMarketMoves: cannot open " + file);
+	}
+
+	vector<MarketMove> moves;
+	string line;
+	size_t number = 0;
+	bool first = true;			//	first line with data, which may be a header
+
+	while (getline(in, line))
+	{
+		++number;
+		size_t start = line.find_first_not_of(" \t\r");
+		if (start == string::npos || line[start] == '#')
+		{
+			continue;
+		}
+
+		//	date,spot return,vol change,rate change
+		vector<string> fields;
+		size_t begin = 0;
+		for (size_t comma = line.find(','); comma != string::npos; comma = line.find(',', begin))
+		{
+			fields.push_back(line.substr(begin, comma - begin));
+			begin = comma + 1;
+		}
+		fields.push_back(line.substr(begin));
+
+		MarketMove move;
+		bool parsed = (fields.size() == 4) && ParseNumber(fields[1], move.SpotReturn) && ParseNumber(fields[2], move.VolChange)
+			&& ParseNumber(fields[3], move.RateChange);
+
+		if (!parsed)
+		{
+			if (first)
+			{
+				first = false;
+				continue;
+			}
+			throw runtime_error("ReadMarketMoves: " + file + ", line " + to_string(number)
+				+ ": expected date,spot return,vol change,rate change");
+		}
+		first = false;
+
+		size_t dateBegin = fields[0].find_first_not_of(" \t");
+		size_t dateEnd = fields[0].find_last_not_of(" \t");
+		move.Date = (dateBegin == string::npos) ? string() : fields[0].substr(dateBegin, dateEnd - dateBegin + 1);
+		moves.push_back(move);
+	}
+
+	return moves;
+}
+
+
+//	LossTail
+
+//	Constructors and destructor
+LossTail::LossTail() : capacity(0), heap(), count(0) {}
+
+LossTail::LossTail(const size_t capacity1) : capacity(capacity1), heap(), count(0)
+{
+	heap.reserve(capacity1);
+}
+
+LossTail::LossTail(const LossTail& tail) : capacity(tail.capacity), heap(tail.heap), count(tail.count) {}
+
+LossTail::~LossTail() {}
+
+LossTail& LossTail::operator = (const LossTail& tail)
+{
+	if (this == &tail)
+	{
+		return *this;
+	}
+
+	capacity = tail.capacity;
+	heap = tail.heap;
+	count = tail.count;
+
+	return *this;
+}
+
+
+size_t LossTail::Capacity() const
+{
+	return capacity;
+}
+
+size_t LossTail::Count() const
+{
+	return count;
+}
+
+
+void LossTail::Add(const double pnl, const size_t scenario)
+{
+	++count;
+	pair<double, size_t> entry(pnl, scenario);
+
+	if (heap.size() < capacity)
+	{
+		heap.push_back(entry);
+		push_heap(heap.begin(), heap.end());
+	}
+	else if (capacity > 0 && entry < heap.front())
+	{
+		pop_heap(heap.begin(), heap.end());
+		heap.back() = entry;
+		push_heap(heap.begin(), heap.end());
+	}
+}
+
+void LossTail::Merge(const LossTail& tail)
+{
+	for (const pair<double, size_t>& entry : tail.heap)
+	{
+		Add(entry.first, entry.second);
+	}
+	count += tail.count - tail.heap.size();
+}
+
+
+vector<pair<double, size_t>> LossTail::Sorted() const
+{
+	vector<pair<double, size_t>> sorted(heap);
+	sort(sorted.begin(), sorted.end());
+	return sorted;
+}
+
+
+//	Repricing
+
+//	The market of scenario move
+static double ShiftedVol(const double sig, const MarketMove& move)
+{
+	return max(sig + move.VolChange, ScenarioMinimumVol);
+}
+
+static double ShiftedCarry(const double b, const MarketMove& move)
+{
+	return (b != 0.0) ? b + move.RateChange : 0.0;
+}
+
+
+//	Lanes of one block of scenarios
+struct LaneBuffers
+{
+	double S[KernelLanes], logS[KernelLanes];
+	BlackLanes black;
+	BarrierLanes barrier;
+};
+
+//	Prices of one product under n <= KernelLanes scenarios: the lane kernels of ScenarioKernels.hpp where the product
+//	has one, Price() on the shifted contract otherwise. growth[i] = 1 + return and logGrowth[i] = log(1 + return).
+
+static void BlockPrices(const Product& product, const MarketMove* moves, const double* growth, const double* logGrowth, const size_t n,
+	LaneBuffers& work, double* prices)
+{
+	visit([&](const auto& option)
+	{
+		typedef decay_t<decltype(option)> Kind;
+
+		constexpr bool black = is_same<Kind, Option>::value || is_same<Kind, EuropeanOption>::value || is_same<Kind, DigitalOption>::value
+			|| is_same<Kind, AssetOrNothingOption>::value || is_same<Kind, CashOrNothingOption>::value || is_same<Kind, GapOption>::value;
+
+		if constexpr (black || is_same<Kind, BarrierOption>::value)
+		{
+			const double T = option.T;
+			const double sqrtT = sqrt(T);
+			const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+			const double logS = log(option.S);
+
+			double logK = 0.0;
+			if constexpr (is_same<Kind, GapOption>::value)
+			{
+				logK = log(option.K1);
+			}
+			else
+			{
+				logK = log(option.K);
+			}
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				const double sig = ShiftedVol(option.sig, moves[i]);
+				const double r = option.r + moves[i].RateChange;
+				const double b = ShiftedCarry(option.b, moves[i]);
+				const double df = FastExp(-r * T);
+				const double carry = FastExp((b - r) * T);
+
+				work.S[i] = option.S * growth[i];
+				work.logS[i] = logS + logGrowth[i];
+
+				if constexpr (black)
+				{
+					work.black.drift[i] = (b + 0.5 * sig * sig) * T;
+					work.black.s[i] = sig * sqrtT;
+					if constexpr (is_same<Kind, DigitalOption>::value)
+					{
+						work.black.a[i] = 0.0;
+						work.black.c[i] = df;
+					}
+					else if constexpr (is_same<Kind, AssetOrNothingOption>::value)
+					{
+						work.black.a[i] = df;
+						work.black.c[i] = 0.0;
+					}
+					else if constexpr (is_same<Kind, CashOrNothingOption>::value)
+					{
+						work.black.a[i] = 0.0;
+						work.black.c[i] = option.cr * df;
+					}
+					else if constexpr (is_same<Kind, GapOption>::value)
+					{
+						work.black.a[i] = phi * carry;
+						work.black.c[i] = -phi * option.K2 * df;
+					}
+					else
+					{
+						work.black.a[i] = phi * carry;
+						work.black.c[i] = -phi * option.K * df;
+					}
+				}
+				else
+				{
+					work.barrier.Set(i, sig, r, b, sqrtT, df, carry);
+				}
+			}
+
+			if constexpr (black)
+			{
+				const bool hasA = !is_same<Kind, DigitalOption>::value && !is_same<Kind, CashOrNothingOption>::value;
+				const bool hasC = !is_same<Kind, AssetOrNothingOption>::value;
+				BlackLanePrices(work.S, work.logS, n, logK, phi, work.black, hasA, hasC, prices);
+			}
+			else
+			{
+				BarrierContract contract;
+				contract.H = option.H;
+				contract.K = option.K;
+				contract.logH = log(option.H);
+				contract.logK = logK;
+				contract.cr = option.cr;
+				contract.call = (option.type == OptionType::Call);
+				contract.out = (option.InOrOut == BarrierType::Out);
+				BarrierLanePrices(work.S, work.logS, n, contract, work.barrier, prices);
+			}
+		}
+		else
+		{
+			//	No lane kernel: reprice the shifted contract
+			Kind shifted(option);
+			for (size_t i = 0; i < n; ++i)
+			{
+				shifted.S = option.S * growth[i];
+				shifted.r = option.r + moves[i].RateChange;
+				shifted.sig = ShiftedVol(option.sig, moves[i]);
+				shifted.b = ShiftedCarry(option.b, moves[i]);
+				prices[i] = shifted.Price();
+			}
+		}
+	}, product);
+}
+
+
+//	HistoricalVaR
+
+//	Constructors and destructor
+HistoricalVaR::HistoricalVaR() : pool(), chunk(32) {}
+
+HistoricalVaR::HistoricalVaR(const size_t threads, const size_t chunk1) : pool(threads), chunk(max<size_t>(chunk1, 1)) {}
+
+HistoricalVaR::~HistoricalVaR() {}
+
+
+size_t HistoricalVaR::Threads() const
+{
+	return pool.Size();
+}
+
+
+VaRReport HistoricalVaR::Run(const vector<Position>& portfolio, const vector<MarketMove>& history, const vector<double>& confidences)
+{
+	const size_t N = history.size();
+	if (N == 0)
+	{
+		throw invalid_argument("HistoricalVaR::Run: the history needs at least one market move");
+	}
+	for (const MarketMove& move : history)
+	{
+		if (!(move.SpotReturn > -1.0))
+		{
+			throw invalid_argument("HistoricalVaR::Run: spot returns must be greater than -1 (" + move.Date + ")");
+		}
+	}
+
+	//	Size of the tail of each confidence; the small margin keeps N (1 - 0.99) = 5.000000000000004 at 5
+	vector<size_t> tails;
+	size_t capacity = 1;
+	for (double c : confidences)
+	{
+		if (!(c > 0.0 && c < 1.0))
+		{
+			throw invalid_argument("HistoricalVaR::Run: confidence levels must be strictly between 0 and 1");
+		}
+		size_t m = static_cast<size_t>(ceil(static_cast<double>(N) * (1.0 - c) - 1e-9));
+		tails.push_back(max<size_t>(m, 1));
+		capacity = max(capacity, tails.back());
+	}
+
+	//	Today's prices
+	const size_t n = portfolio.size();
+	vector<double> base(n);
+	pool.ParallelFor(n, 256, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			base[i] = ::Price(portfolio[i].Contract);
+		}
+	});
+
+	//	Scenario P&Ls, a chunk of scenarios per task; each task keeps its own tail and sum
+	const size_t tasks = (N + chunk - 1) / chunk;
+	vector<LossTail> taskTails(tasks, LossTail(capacity));
+	vector<double> taskSums(tasks, 0.0);
+
+	pool.ParallelFor(N, chunk, [&](size_t begin, size_t end)
+	{
+		const size_t count = end - begin;
+		vector<double> pnl(count, 0.0);
+		LaneBuffers work;
+		double growth[KernelLanes], logGrowth[KernelLanes], prices[KernelLanes];
+
+		for (size_t start = 0; start < count; start += KernelLanes)
+		{
+			const size_t m = min(count - start, KernelLanes);
+			const MarketMove* moves = &history[begin + start];
+			for (size_t j = 0; j < m; ++j)
+			{
+				growth[j] = 1.0 + moves[j].SpotReturn;
+				logGrowth[j] = log1p(moves[j].SpotReturn);
+			}
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				BlockPrices(portfolio[i].Contract, moves, growth, logGrowth, m, work, prices);
+
+				const double quantity = portfolio[i].Quantity;
+				for (size_t j = 0; j < m; ++j)
+				{
+					pnl[start + j] += quantity * (prices[j] - base[i]);
+				}
+			}
+		}
+
+		LossTail& tail = taskTails[begin / chunk];
+		double sum = 0.0;
+		for (size_t j = 0; j < count; ++j)
+		{
+			tail.Add(pnl[j], begin + j);
+			sum += pnl[j];
+		}
+		taskSums[begin / chunk] = sum;
+	});
+
+	//	Merged in chunk order
+	LossTail tail(capacity);
+	double sum = 0.0;
+	for (size_t t = 0; t < tasks; ++t)
+	{
+		tail.Merge(taskTails[t]);
+		sum += taskSums[t];
+	}
+
+	VaRReport report;
+	report.Scenarios = N;
+	report.Base = 0.0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		report.Base += portfolio[i].Quantity * base[i];
+	}
+	report.MeanPnL = sum / static_cast<double>(N);
+	report.Worst = tail.Sorted();
+
+	for (size_t k = 0; k < confidences.size(); ++k)
+	{
+		const size_t m = min(tails[k], report.Worst.size());
+		double total = 0.0;
+		for (size_t j = 0; j < m; ++j)
+		{
+			total += report.Worst[j].first;
+		}
+
+		RiskMeasure measure;
+		measure.Confidence = confidences[k];
+		measure.TailScenarios = m;
+		measure.VaR = -report.Worst[m - 1].first;
+		measure.ExpectedShortfall = -total / static_cast<double>(m);
+		report.Measures.push_back(measure);
+	}
+
+	return report;
+}
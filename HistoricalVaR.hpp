@@ -0,0 +1,128 @@
+// Historical-simulation Value at Risk and Expected Shortfall of a portfolio, by full revaluation
+//
+// (c) Sudhansh Dua
+//
+//	A history is a list of market moves, one per past day: a relative spot return, an absolute volatility change
+//	and an absolute rate change. Scenario j applies move j to today's market and reprices every position in it:
+//	->	S (1 + return), sig + change (floored at ScenarioMinimumVol, ScenarioEngine.hpp) and r + change
+//	->	the cost of carry moves with the rate, b + change, so b - r (a dividend yield) is held; b = 0 (futures) stays 0,
+//		as in the Rho of the Greeks (Option.hpp)
+//	->	the contracts are not aged: the scenario is an instantaneous move of today's market
+//	All positions share one underlying, as in ScenarioEngine.
+//
+//	The P&L of scenario j is the sum over positions of quantity x (shifted price - today's price). Only the tail of
+//	the P&L distribution is kept: a LossTail holds the m worst scenarios in a bounded heap, m = ceil(N (1 - c)) for
+//	the lowest confidence c asked for, so memory grows with the tail and not with positions x scenarios. From the
+//	m_c worst P&Ls of confidence c (m_c = ceil(N (1 - c)), at least 1):
+//		VaR_c = -(m_c-th worst P&L),		ES_c = -(mean of the m_c worst P&Ls)
+//	both reported as positive losses.
+//
+//	The scenarios are split into chunks on a thread pool. A chunk loops over the positions and, for each one, prices
+//	its scenarios in blocks of KernelLanes through the vectorised lane kernels of ScenarioKernels.hpp: vanilla
+//	(Option, EuropeanOption), digital, asset-or-nothing, cash-or-nothing and gap options by BlackLanePrices, barrier
+//	options by BarrierLanePrices. The other products are repriced by Price() on the shifted contract. Each chunk
+//	keeps its own P&Ls and tail, and the tails are merged in chunk order, so the results do not depend on the number
+//	of threads.
+
+
+#ifndef HistoricalVaR_HPP
+#define HistoricalVaR_HPP
+
+
+#include "PortfolioPricer.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+
+//	One day of market history
+struct MarketMove
+{
+	string Date;				//	label of the day, free text
+	double SpotReturn;			//	relative: S (1 + return), > -1
+	double VolChange;			//	absolute: sig + change
+	double RateChange;			//	absolute: r + change
+};
+
+
+//	Reads a history from a flat file, one move per line:
+//		date,spot return,vol change,rate change
+//	Blank lines and lines starting with '#' are skipped, and so is a first line whose numbers do not parse (a column
+//	header). Throws runtime_error if the file cannot be opened or a line is malformed, naming the line.
+vector<MarketMove> ReadMarketMoves(const string& file);
+
+
+//	Bounded heap of the worst (lowest) P&Ls seen, with the scenario each came from
+class LossTail
+{
+private:
+	size_t capacity;
+	vector<pair<double, size_t>> heap;			//	(P&L, scenario), highest P&L of the tail on top
+	size_t count;								//	P&Ls seen
+
+public:
+	//	Constructors and destructor
+	LossTail();												//	keeps nothing
+	explicit LossTail(const size_t capacity1);			//	keeps the capacity1 worst P&Ls
+	LossTail(const LossTail& tail);
+	~LossTail();
+
+	LossTail& operator = (const LossTail& tail);
+
+	size_t Capacity() const;
+	size_t Count() const;
+
+	void Add(const double pnl, const size_t scenario);
+	void Merge(const LossTail& tail);
+
+	//	The P&Ls kept, worst first; ties in scenario order
+	vector<pair<double, size_t>> Sorted() const;
+};
+
+
+struct RiskMeasure
+{
+	double Confidence;
+	size_t TailScenarios;		//	m = ceil(N (1 - Confidence)), at least 1
+	double VaR;					//	loss at the m-th worst scenario
+	double ExpectedShortfall;	//	mean loss of the m worst scenarios
+};
+
+
+struct VaRReport
+{
+	size_t Scenarios;
+	double Base;							//	value of the portfolio today
+	double MeanPnL;							//	over all scenarios
+	vector<RiskMeasure> Measures;			//	one per confidence, in the order asked
+	vector<pair<double, size_t>> Worst;		//	(P&L, scenario) of the tail, worst first
+};
+
+
+class HistoricalVaR
+{
+private:
+	ThreadPool pool;
+	size_t chunk;			//	scenarios per task
+
+public:
+	//	Constructors and destructor
+	HistoricalVaR();												//	one thread per hardware thread, 32 scenarios per task
+	HistoricalVaR(const size_t threads, const size_t chunk1);		//	threads = 0 runs on the calling thread
+	HistoricalVaR(const HistoricalVaR& engine) = delete;
+	~HistoricalVaR();
+
+	HistoricalVaR& operator = (const HistoricalVaR& engine) = delete;
+
+	size_t Threads() const;
+
+	//	VaR and ES of the portfolio over the history at each confidence level (0.99 for 99%). Throws invalid_argument
+	//	if the history is empty, a spot return is <= -1 or a confidence is not strictly between 0 and 1.
+	VaRReport Run(const vector<Position>& portfolio, const vector<MarketMove>& history, const vector<double>& confidences);
+};
+
+
+#endif
@@ -0,0 +1,202 @@
+// Implementing the functions that are declared in the header file: ImpliedVolatility.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "ImpliedVolatility.hpp"
+#include "Numerics.hpp"
+#include <cmath>
+#include <limits>
+
+
+using namespace std;
+using namespace Numerics;
+
+
+static const int MaxIterations = 64;
+static const double Tolerance = 4e-16;				//	on |ds| / s
+static const double Rounding = 4.0 * numeric_limits<double>::epsilon();	//	relative rounding error of the price
+static const double Infinity = numeric_limits<double>::infinity();
+
+
+//	Moves the option to its out-of-the-money side and returns the initial guess of the total volatility.
+//	On return x = log(F / K), phi = +1 (call) or -1 (put) on the OTM side, target is the undiscounted OTM price,
+//	and upper is its no-arbitrage upper bound (F for a call, K for a put).
+static inline double Setup(const double price, const double S, const double K, const double T, const double r, const double b,
+	const double phiIn, double& x, double& F, double& phi, double& target, double& upper)
+{
+	F = S * FastExp(b * T);
+	x = FastLog(F / K);
+
+	double undiscounted = price * FastExp(r * T);
+	bool itm = (phiIn * x > 0.0);
+	phi = itm ? -phiIn : phiIn;
+	target = itm ? undiscounted - phiIn * (F - K) : undiscounted;
+	target = (itm && fabs(target) <= Rounding * (F + K)) ? 0.0 : target;		//	time value lost in the rounding of the price
+	upper = (phi > 0.0) ? F : K;
+
+	//	Corrado & Miller (1996), on the undiscounted call price
+	double call = (phi > 0.0) ? target : target + (F - K);
+	double a = call - 0.5 * (F - K);
+	double disc = a * a - (F - K) * (F - K) * 0.318309886183790671538;		//	1 / pi
+	double s = 2.50662827463100050242 * (a + FastSqrt((disc > 0.0) ? disc : 0.0)) / (F + K);
+
+	//	Otherwise start from the inflection point of the price in s, from where Newton converges monotonically
+	return (s > 0.0) ? s : FastSqrt(2.0 * fabs(x));
+}
+
+
+//	One third-order Householder step on g(s) = log(v(s)) - log(target), where v(s) = phi * (F N(phi d1) - K N(phi d2))
+//	is the OTM price. The logarithm keeps the steps well scaled far in the wings, where v spans hundreds of orders
+//	of magnitude. With v' = F n(d1), v'' / v' = h2 = d1 d2 / s and v''' / v' = h3 = h2^2 - (d1^2 + d1 d2 + d2^2) / s^2:
+//		g' = v' / v,	g'' / g' = h2 - g',		g''' / g' = h3 - 3 h2 g' + 2 g'^2
+//	Updates the bracket [lo, hi] and s, and returns the step taken (0 once s is a root).
+static inline double Step(const double x, const double F, const double K, const double phi, const double logTarget,
+	const double target, double& s, double& lo, double& hi)
+{
+	double d1 = x / s + 0.5 * s;
+	double d2 = d1 - s;
+
+	double call = F * NormalCdf(phi * d1);
+	double put = K * NormalCdf(phi * d2);
+	double v = phi * (call - put);
+	double f = v - target;
+
+	//	Once the residual is down to the rounding error of the price, s is a root to machine precision
+	bool root = (fabs(f) <= Rounding * (call + put + target));
+
+	lo = (f < 0.0) ? s : lo;
+	hi = (f > 0.0) ? s : hi;
+
+	double g1 = F * NormalPdf(d1) / v;
+	double h2 = d1 * d2 / s;
+	double h3 = h2 * h2 - (d1 * d1 + d1 * d2 + d2 * d2) / (s * s);
+	double a2 = h2 - g1;
+	double a3 = h3 - 3.0 * h2 * g1 + 2.0 * g1 * g1;
+
+	double nu = (FastLog(v) - logTarget) / g1;
+	double next = s - nu * (1.0 - 0.5 * a2 * nu) / (1.0 - a2 * nu + a3 * nu * nu * (1.0 / 6.0));
+
+	//	Bisection (or doubling while there is no upper bound) when the step leaves the bracket, or when v or its
+	//	derivative underflow
+	bool inside = (next > lo) && (next < hi);
+	next = inside ? next : ((hi < Infinity) ? 0.5 * (lo + hi) : 2.0 * s);
+	next = root ? s : next;
+
+	double step = next - s;
+	s = next;
+	return step;
+}
+
+
+ImpliedVolResult ImpliedVol(const double price, const double S, const double K, const double T, const double r, const double b,
+	const OptionType type)
+{
+	ImpliedVolResult result = { numeric_limits<double>::quiet_NaN(), 0, false };
+
+	double x, F, phi, target, upper;
+	double s = Setup(price, S, K, T, r, b, (type == OptionType::Call) ? 1.0 : -1.0, x, F, phi, target, upper);
+
+	if (!(target >= 0.0 && target < upper))
+	{
+		return result;
+	}
+	if (target == 0.0)
+	{
+		result.Vol = 0.0;				//	the price is the intrinsic value
+		result.Converged = true;
+		return result;
+	}
+
+	double lo = 0.0;
+	double hi = Infinity;
+	while (result.Iterations < MaxIterations)
+	{
+		double step = Step(x, F, K, phi, FastLog(target), target, s, lo, hi);
+		++result.Iterations;
+
+		if (fabs(step) <= Tolerance * s)
+		{
+			result.Converged = true;
+			break;
+		}
+	}
+
+	result.Vol = s / sqrt(T);
+	return result;
+}
+
+
+//	Batch solver: blocks of options are set up and then iterated in lockstep
+OPTION_TARGET_CLONES
+void BatchImpliedVol(const double* __restrict price, const double* __restrict S, const double* __restrict K, const double* __restrict T,
+	const double* __restrict r, const double* __restrict b, const int* __restrict isCall, double* __restrict vol,
+	int* __restrict iterations, const size_t n)
+{
+	const size_t Block = 256;
+	const int Moving = 0, Converged = 1, Invalid = 2;
+
+	double x[Block], F[Block], Kb[Block], phi[Block], target[Block], logTarget[Block], s[Block], lo[Block], hi[Block];
+	int state[Block], count[Block];
+
+	for (size_t start = 0; start < n; start += Block)
+	{
+		const size_t m = (n - start < Block) ? n - start : Block;
+
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < m; ++i)
+		{
+			size_t j = start + i;
+			double upper;
+			double s0 = Setup(price[j], S[j], K[j], T[j], r[j], b[j], (isCall[j] != 0) ? 1.0 : -1.0, x[i], F[i], phi[i], target[i], upper);
+
+			bool valid = (target[i] >= 0.0) && (target[i] < upper);
+			bool intrinsic = (target[i] == 0.0);
+
+			Kb[i] = K[j];
+			logTarget[i] = FastLog(target[i]);
+			s[i] = intrinsic ? 0.0 : s0;
+			lo[i] = 0.0;
+			hi[i] = Infinity;
+			state[i] = valid ? (intrinsic ? Converged : Moving) : Invalid;
+			count[i] = 0;
+		}
+
+		for (int it = 0; it < MaxIterations; ++it)
+		{
+			int active = 0;
+
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < m; ++i)
+			{
+				double si = s[i];
+				double loi = lo[i];
+				double hii = hi[i];
+				double step = Step(x[i], F[i], Kb[i], phi[i], logTarget[i], target[i], si, loi, hii);
+
+				bool moving = (state[i] == Moving);
+				bool converged = (fabs(step) <= Tolerance * si);
+
+				s[i] = moving ? si : s[i];
+				lo[i] = moving ? loi : lo[i];
+				hi[i] = moving ? hii : hi[i];
+				count[i] += moving ? 1 : 0;
+				state[i] = (moving && converged) ? Converged : state[i];
+				active += (state[i] == Moving) ? 1 : 0;
+			}
+
+			if (active == 0)
+			{
+				break;
+			}
+		}
+
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < m; ++i)
+		{
+			size_t j = start + i;
+			vol[j] = (state[i] == Invalid) ? numeric_limits<double>::quiet_NaN() : s[i] / FastSqrt(T[j]);
+			iterations[j] = (state[i] == Converged) ? count[i] : -1;
+		}
+	}
+}
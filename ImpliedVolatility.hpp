@@ -0,0 +1,48 @@
+// Implied volatility of European options under the Black-Scholes-Merton model
+//
+// (c) Sudhansh Dua
+//
+//	The solver works on the undiscounted out-of-the-money price (in-the-money prices are converted by put-call
+//	parity) as a function of the total volatility s = sig * sqrt(T):
+//	->	initial guess from the Corrado & Miller (1996) rational approximation
+//	->	third-order Householder steps on log(price), using the analytic vega and its first two derivatives in s;
+//		the logarithm keeps the steps well scaled far in the wings
+//	->	a bracket [lo, hi] kept from the signs of the residuals; a step that leaves it is replaced by bisection
+//	From the initial guess it typically needs two to three steps to reach machine precision (|ds| <= 4e-16 * s);
+//	far in the wings it takes a few more. Deep in the money the accuracy is limited by the time value that survives
+//	in the rounding of the price; a price within rounding of the intrinsic value gives a volatility of 0.
+//
+//	The price is inverted with the same normal CDF as the pricing kernels, so that
+//	VanillaPrice(ImpliedVol(VanillaPrice(sig))) reproduces the input price.
+
+
+#ifndef ImpliedVolatility_HPP
+#define ImpliedVolatility_HPP
+
+
+#include "OptionTraits.hpp"
+#include <cstddef>
+using namespace std;
+
+
+struct ImpliedVolResult
+{
+	double Vol;				//	implied volatility; NaN if the price violates the no-arbitrage bounds
+	int Iterations;			//	number of Householder or bisection steps taken
+	bool Converged;
+};
+
+
+//	Volatility at which the Black-Scholes-Merton price of the option equals price
+ImpliedVolResult ImpliedVol(const double price, const double S, const double K, const double T, const double r, const double b,
+	const OptionType type);
+
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call.
+//	All options of a block are iterated in lockstep in a vectorised loop; an option stops moving once it has
+//	converged. iterations[i] receives the number of steps option i needed, or -1 if it did not converge.
+void BatchImpliedVol(const double* price, const double* S, const double* K, const double* T, const double* r, const double* b,
+	const int* isCall, double* vol, int* iterations, const size_t n);
+
+
+#endif
@@ -0,0 +1,347 @@
+// Implementing the functions that are declared in the header file: Lattice.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "Lattice.hpp"
+#include "Numerics.hpp"
+#include <cmath>
+#include <vector>
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Shape of a tree: the branch probabilities, already discounted, and the spot multipliers of the nodes.
+//	Binomial:	node j of level i is at S d^i ratio[j],	ratio[j] = (u / d)^j,	j = 0 .. N
+//	Trinomial:	node j of level i is at S ratio[j - i + N],	ratio[k] = u^(k - N),	k = 0 .. 2N
+struct Tree
+{
+	size_t N;
+	bool trinomial;
+	double dt;
+	double u, d;
+	double pu, pm, pd;
+	vector<double> ratio;
+};
+
+
+//	Number of steps actually used: at least two, so that the Greeks have their levels, and odd for Leisen-Reimer
+static size_t TreeSteps(const LatticeMethod method, const size_t steps)
+{
+	size_t N = (steps < 2) ? 2 : steps;
+	if (method == LatticeMethod::LeisenReimer && N % 2 == 0)
+	{
+		++N;
+	}
+	return N;
+}
+
+//	Peizer-Pratt (method 2) inversion: the binomial probability that matches N(z) on a tree of n steps
+static double PeizerPratt(const double z, const size_t n)
+{
+	double m = static_cast<double>(n);
+	double x = z / (m + 1.0 / 3.0 + 0.1 / (m + 1.0));
+	return 0.5 + copysign(0.5, z) * sqrt(1.0 - exp(-x * x * (m + 1.0 / 6.0)));
+}
+
+static Tree BuildTree(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const LatticeMethod method, const size_t N)
+{
+	Tree tree;
+	tree.N = N;
+	tree.trinomial = (method == LatticeMethod::Trinomial);
+	tree.dt = T / static_cast<double>(N);
+
+	const double disc = exp(-r * tree.dt);
+	const double growth = exp(b * tree.dt);
+	double p;
+
+	switch (method)
+	{
+	case LatticeMethod::Trinomial:
+	{
+		double a = exp(0.5 * b * tree.dt);
+		double e = exp(sig * sqrt(0.5 * tree.dt));
+		tree.u = exp(sig * sqrt(2.0 * tree.dt));
+		tree.d = 1.0 / tree.u;
+
+		double pu = (a - 1.0 / e) / (e - 1.0 / e);
+		double pd = (e - a) / (e - 1.0 / e);
+		tree.pu = disc * pu * pu;
+		tree.pd = disc * pd * pd;
+		tree.pm = disc * (1.0 - pu * pu - pd * pd);
+		break;
+	}
+	case LatticeMethod::LeisenReimer:
+	{
+		double d1 = (log(S / K) + (b + 0.5 * sig * sig) * T) / (sig * sqrt(T));
+		double d2 = d1 - sig * sqrt(T);
+		p = PeizerPratt(d2, N);
+		tree.u = growth * PeizerPratt(d1, N) / p;
+		tree.d = (growth - p * tree.u) / (1.0 - p);
+		tree.pu = disc * p;
+		tree.pd = disc * (1.0 - p);
+		tree.pm = 0.0;
+		break;
+	}
+	default:
+	{
+		tree.u = exp(sig * sqrt(tree.dt));
+		tree.d = 1.0 / tree.u;
+		p = (growth - tree.d) / (tree.u - tree.d);
+		tree.pu = disc * p;
+		tree.pd = disc * (1.0 - p);
+		tree.pm = 0.0;
+		break;
+	}
+	}
+
+	if (tree.trinomial)
+	{
+		double logU = log(tree.u);
+		tree.ratio.resize(2 * N + 1);
+		for (size_t k = 0; k <= 2 * N; ++k)
+		{
+			tree.ratio[k] = exp((static_cast<double>(k) - static_cast<double>(N)) * logU);
+		}
+	}
+	else
+	{
+		double logRatio = log(tree.u / tree.d);
+		tree.ratio.resize(N + 1);
+		for (size_t j = 0; j <= N; ++j)
+		{
+			tree.ratio[j] = exp(static_cast<double>(j) * logRatio);
+		}
+	}
+	return tree;
+}
+
+
+//	Backward induction in place in v, which holds 2N + 1 doubles
+OPTION_TARGET_CLONES
+static LatticeResult Induct(const Tree& tree, const double S, const double K, const double phi, const bool american, double* v)
+{
+	const size_t N = tree.N;
+	const double pu = tree.pu;
+	const double pm = tree.pm;
+	const double pd = tree.pd;
+	const double* ratio = tree.ratio.data();
+
+	LatticeResult result;
+	double level1[3] = {}, level2[3] = {};
+
+	if (!tree.trinomial)
+	{
+		double low = S * pow(tree.d, static_cast<double>(N));
+		OPTION_SIMD_LOOP
+		for (size_t j = 0; j <= N; ++j)
+		{
+			double e = phi * (low * ratio[j] - K);
+			v[j] = (e > 0.0) ? e : 0.0;
+		}
+
+		//	On a two-step tree the payoffs are the level-2 values; the loop below starts from level 1
+		if (N == 2)
+		{
+			level2[0] = v[0];
+			level2[1] = v[1];
+			level2[2] = v[2];
+		}
+
+		for (size_t i = N; i-- > 0;)
+		{
+			if (american)
+			{
+				low = S * pow(tree.d, static_cast<double>(i));
+				OPTION_SIMD_LOOP
+				for (size_t j = 0; j <= i; ++j)
+				{
+					double hold = pu * v[j + 1] + pd * v[j];
+					double e = phi * (low * ratio[j] - K);
+					v[j] = (hold > e) ? hold : e;
+				}
+			}
+			else
+			{
+				OPTION_SIMD_LOOP
+				for (size_t j = 0; j <= i; ++j)
+				{
+					v[j] = pu * v[j + 1] + pd * v[j];
+				}
+			}
+
+			if (i == 2)
+			{
+				level2[0] = v[0];
+				level2[1] = v[1];
+				level2[2] = v[2];
+			}
+			else if (i == 1)
+			{
+				level1[0] = v[0];
+				level1[1] = v[1];
+			}
+		}
+
+		const double u = tree.u;
+		const double d = tree.d;
+		double s21 = S * u * d;
+		double up = (level2[2] - level2[1]) / (S * u * u - s21);
+		double down = (level2[1] - level2[0]) / (s21 - S * d * d);
+
+		result.Price = v[0];
+		result.Delta = (level1[1] - level1[0]) / (S * (u - d));
+		result.Gamma = (up - down) / (0.5 * S * (u * u - d * d));
+
+		//	The middle node two steps ahead is at S u d, which is S only for Cox-Ross-Rubinstein: take out the move in
+		//	the spot to second order
+		double move = s21 - S;
+		result.Theta = (level2[1] - v[0] - result.Delta * move - 0.5 * result.Gamma * move * move) / (2.0 * tree.dt);
+		return result;
+	}
+
+	OPTION_SIMD_LOOP
+	for (size_t j = 0; j <= 2 * N; ++j)
+	{
+		double e = phi * (S * ratio[j] - K);
+		v[j] = (e > 0.0) ? e : 0.0;
+	}
+
+	for (size_t i = N; i-- > 0;)
+	{
+		const double* level = ratio + (N - i);
+		if (american)
+		{
+			OPTION_SIMD_LOOP
+			for (size_t j = 0; j <= 2 * i; ++j)
+			{
+				double hold = pu * v[j + 2] + pm * v[j + 1] + pd * v[j];
+				double e = phi * (S * level[j] - K);
+				v[j] = (hold > e) ? hold : e;
+			}
+		}
+		else
+		{
+			OPTION_SIMD_LOOP
+			for (size_t j = 0; j <= 2 * i; ++j)
+			{
+				v[j] = pu * v[j + 2] + pm * v[j + 1] + pd * v[j];
+			}
+		}
+
+		if (i == 1)
+		{
+			level1[0] = v[0];
+			level1[1] = v[1];
+			level1[2] = v[2];
+		}
+	}
+
+	const double u = tree.u;
+	const double d = tree.d;
+	double up = (level1[2] - level1[1]) / (S * (u - 1.0));
+	double down = (level1[1] - level1[0]) / (S * (1.0 - d));
+
+	result.Price = v[0];
+	result.Delta = (level1[2] - level1[0]) / (S * (u - d));
+	result.Gamma = (up - down) / (0.5 * S * (u - d));
+	result.Theta = (level1[1] - v[0]) / tree.dt;
+	return result;
+}
+
+
+//	Richardson extrapolation of the results on N and M steps, for an error proportional to 1 / steps^p
+static LatticeResult Extrapolate(const LatticeResult& fine, const size_t N, const LatticeResult& coarse, const size_t M, const double p)
+{
+	double wN = pow(static_cast<double>(N), p);
+	double wM = pow(static_cast<double>(M), p);
+	double scale = 1.0 / (wN - wM);
+
+	LatticeResult result;
+	result.Price = (wN * fine.Price - wM * coarse.Price) * scale;
+	result.Delta = (wN * fine.Delta - wM * coarse.Delta) * scale;
+	result.Gamma = (wN * fine.Gamma - wM * coarse.Gamma) * scale;
+	result.Theta = (wN * fine.Theta - wM * coarse.Theta) * scale;
+	return result;
+}
+
+//	Steps of the coarse tree for Richardson extrapolation, or N if there is none
+static size_t CoarseSteps(const LatticeSettings& settings, const size_t N)
+{
+	if (!settings.Richardson)
+	{
+		return N;
+	}
+	size_t M = TreeSteps(settings.Method, N / 2);
+	return (M < N) ? M : N;
+}
+
+//	Early exercise brings the error of every tree back to order 1 / steps
+static double RichardsonOrder(const LatticeMethod method, const bool american)
+{
+	return (method == LatticeMethod::LeisenReimer && !american) ? 2.0 : 1.0;
+}
+
+
+LatticeResult LatticePrice(const double S, const double K, const double T, const double r, const double sig, const double b,
+	const OptionType type, const ExerciseType exercise, const LatticeSettings& settings)
+{
+	const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+	const bool american = (exercise == ExerciseType::American);
+	const size_t N = TreeSteps(settings.Method, settings.Steps);
+	const size_t M = CoarseSteps(settings, N);
+
+	vector<double> v(2 * N + 1);
+	LatticeResult fine = Induct(BuildTree(S, K, T, r, sig, b, settings.Method, N), S, K, phi, american, v.data());
+	if (M == N)
+	{
+		return fine;
+	}
+
+	LatticeResult coarse = Induct(BuildTree(S, K, T, r, sig, b, settings.Method, M), S, K, phi, american, v.data());
+	return Extrapolate(fine, N, coarse, M, RichardsonOrder(settings.Method, american));
+}
+
+
+void BatchLattice(const double S, const double T, const double r, const double sig, const double b, const double* K,
+	const int* isCall, double* price, double* delta, double* gamma, double* theta, const size_t n, const ExerciseType exercise,
+	const LatticeSettings& settings, ThreadPool& pool)
+{
+	const bool american = (exercise == ExerciseType::American);
+	const bool shared = (settings.Method != LatticeMethod::LeisenReimer);		//	the other trees do not depend on K
+	const size_t N = TreeSteps(settings.Method, settings.Steps);
+	const size_t M = CoarseSteps(settings, N);
+
+	Tree fineTree, coarseTree;
+	if (shared && n > 0)
+	{
+		fineTree = BuildTree(S, K[0], T, r, sig, b, settings.Method, N);
+		coarseTree = BuildTree(S, K[0], T, r, sig, b, settings.Method, M);
+	}
+
+	pool.ParallelFor(n, 1, [&](size_t begin, size_t end)
+	{
+		vector<double> v(2 * N + 1);
+		for (size_t i = begin; i < end; ++i)
+		{
+			const double phi = (isCall[i] != 0) ? 1.0 : -1.0;
+
+			LatticeResult result = shared ? Induct(fineTree, S, K[i], phi, american, v.data())
+				: Induct(BuildTree(S, K[i], T, r, sig, b, settings.Method, N), S, K[i], phi, american, v.data());
+			if (M != N)
+			{
+				LatticeResult coarse = shared ? Induct(coarseTree, S, K[i], phi, american, v.data())
+					: Induct(BuildTree(S, K[i], T, r, sig, b, settings.Method, M), S, K[i], phi, american, v.data());
+				result = Extrapolate(result, N, coarse, M, RichardsonOrder(settings.Method, american));
+			}
+
+			price[i] = result.Price;
+			delta[i] = result.Delta;
+			gamma[i] = result.Gamma;
+			theta[i] = result.Theta;
+		}
+	});
+}
@@ -0,0 +1,74 @@
+// Implementing the functions that are declared in the header file: MonteCarlo.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "MonteCarlo.hpp"
+#include <cmath>
+#include <stdexcept>
+
+
+using namespace std;
+
+
+MonteCarloResult Estimate(const MonteCarloSums& sums, const bool control, const double yMean, const size_t paths)
+{
+	MonteCarloResult result = { 0.0, 0.0, paths };
+	if (sums.n < 2.0)
+	{
+		result.Price = (sums.n > 0.0) ? sums.x / sums.n : 0.0;
+		return result;
+	}
+
+	double n = sums.n;
+	double mx = sums.x / n;
+	double my = sums.y / n;
+	double vx = (sums.xx - n * mx * mx) / (n - 1.0);
+	double vy = (sums.yy - n * my * my) / (n - 1.0);
+	double cxy = (sums.xy - n * mx * my) / (n - 1.0);
+
+	double variance = vx;
+	result.Price = mx;
+	if (control && vy > 0.0)
+	{
+		double beta = cxy / vy;
+		result.Price = mx - beta * (my - yMean);
+		variance = vx - beta * cxy;
+	}
+
+	result.StdError = sqrt(((variance > 0.0) ? variance : 0.0) / n);
+	return result;
+}
+
+
+//	The Sobol sequence and the bridge are built for one dimension only when they are not used
+PathGenerator::PathGenerator(const MonteCarloSettings& settings, const size_t steps1)
+	: sampling(settings.Sampling), seed(settings.Seed), steps(steps1), bridge(settings.Bridge),
+	sobol((settings.Sampling == SamplingMethod::Sobol && steps1 > 0) ? steps1 : 1, settings.Scramble, settings.Seed),
+	construction((settings.Sampling == SamplingMethod::Sobol && settings.Bridge && steps1 > 0) ? steps1 : 1)
+{
+	if (steps == 0)
+	{
+		throw invalid_argument("PathGenerator: at least one time step is required");
+	}
+}
+
+size_t PathGenerator::Steps() const
+{
+	return steps;
+}
+
+void PathGenerator::Normals(const uint64_t first, const size_t count, double* out, double* work) const
+{
+	if (sampling == SamplingMethod::PseudoRandom)
+	{
+		FillNormals(seed, first, count, 0, steps, out);
+		return;
+	}
+
+	sobol.FillNormals(first, count, 0, steps, out);
+	if (bridge)
+	{
+		construction.Transform(out, count, work);
+	}
+}
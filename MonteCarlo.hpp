@@ -0,0 +1,121 @@
+// Building blocks shared by the Monte Carlo engines: settings, results, random numbers and the estimator
+//
+// (c) Sudhansh Dua
+//
+//	Reproducibility: the random numbers are a function of (seed, path, step) only (Philox, Random.hpp), and the
+//	paths are simulated in fixed blocks of MonteCarloBlock samples whose sums are added up in block order. The result
+//	is therefore the same for any number of threads and any scheduling of the blocks.
+//
+//	Sampling: PathGenerator gives the engines the normals of a block of paths, one per time step, either
+//	pseudo-random (Philox, draw = step) or quasi-random (SamplingMethod::Sobol): point = sample and dimension = step
+//	of a Sobol sequence, scrambled with the seed, and by default turned into the path by a Brownian bridge so that the
+//	first dimensions carry the end point and coarse shape of the path (BrownianBridge.hpp). Quasi-random points
+//	converge at close to 1 / n instead of 1 / sqrt(n) on the smooth payoffs of the engines.
+//	->	The standard error reported is the iid formula. The points of a Sobol sequence are not independent, and it
+//		overstates the error, often by a wide margin; the spread of the price over independent scrambles (seeds) is
+//		the honest measure (tools/QuasiMonteCarloBenchmark.cpp).
+//	->	Sobol paths use path counts that are powers of two best; at most SobolMaxDimension time steps.
+//
+//	With a control variate Y of known mean E[Y], the estimator of E[X] is
+//		mean(X) - beta (mean(Y) - E[Y]),	beta = cov(X, Y) / var(Y)
+//	estimated from the same sample, and its variance is var(X) (1 - corr(X, Y)^2) / n.
+
+
+#ifndef MonteCarlo_HPP
+#define MonteCarlo_HPP
+
+
+#include "Random.hpp"
+#include "Sobol.hpp"
+#include "BrownianBridge.hpp"
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+
+enum class SamplingMethod { PseudoRandom, Sobol };
+
+
+struct MonteCarloSettings
+{
+	size_t Paths;				//	number of paths; with antithetic variates a pair of paths counts as two
+	uint64_t Seed;				//	seed of the random numbers (of the scramble, with Sobol sampling)
+	bool Antithetic;			//	simulate each normal draw z together with -z
+	bool ControlVariate;		//	use the engine's control variate
+	SamplingMethod Sampling;	//	pseudo-random or quasi-random normals
+	bool Scramble;				//	Sobol only: Owen-scramble the points
+	bool Bridge;				//	Sobol only: build the paths by Brownian bridge rather than step by step
+
+	MonteCarloSettings() : Paths(100000), Seed(1), Antithetic(true), ControlVariate(true), Sampling(SamplingMethod::PseudoRandom),
+		Scramble(true), Bridge(true) {}
+};
+
+
+struct MonteCarloResult
+{
+	double Price;
+	double StdError;			//	standard error of Price
+	size_t Paths;				//	number of paths simulated
+};
+
+
+//	Samples per block: the unit of work and of the ordered reduction
+const size_t MonteCarloBlock = 4096;
+
+
+//	Sums over a block of samples of the payoff x and the control y
+struct MonteCarloSums
+{
+	double n, x, y, xx, yy, xy;
+
+	MonteCarloSums() : n(0.0), x(0.0), y(0.0), xx(0.0), yy(0.0), xy(0.0) {}
+
+	void Add(const double xi, const double yi)
+	{
+		n += 1.0;
+		x += xi;
+		y += yi;
+		xx += xi * xi;
+		yy += yi * yi;
+		xy += xi * yi;
+	}
+
+	void Add(const MonteCarloSums& sums)
+	{
+		n += sums.n;
+		x += sums.x;
+		y += sums.y;
+		xx += sums.xx;
+		yy += sums.yy;
+		xy += sums.xy;
+	}
+};
+
+
+//	Normals of the paths of an engine with a given number of time steps
+class PathGenerator
+{
+private:
+	SamplingMethod sampling;
+	uint64_t seed;
+	size_t steps;
+	bool bridge;
+	SobolSequence sobol;				//	used with Sobol sampling only
+	BrownianBridge construction;		//	used with Sobol sampling and bridge only
+
+public:
+	//	Throws invalid_argument if steps is 0, or above SobolMaxDimension with Sobol sampling
+	PathGenerator(const MonteCarloSettings& settings, const size_t steps1);
+
+	size_t Steps() const;
+
+	//	Normals of samples [first, first + count), laid out step by step: out[step * count + i] is the normal of the
+	//	step of sample first + i. work holds steps * count doubles, used by the Brownian bridge.
+	void Normals(const uint64_t first, const size_t count, double* out, double* work) const;
+};
+
+
+//	Price and standard error from the sums. yMean is E[y]; it is used only if control is true.
+MonteCarloResult Estimate(const MonteCarloSums& sums, const bool control, const double yMean, const size_t paths);
+
+#endif
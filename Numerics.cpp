@@ -0,0 +1,169 @@
+// Implementing the packed and bivariate Gaussian functions that are declared in the header file: Numerics.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "Numerics.hpp"
+#include <cmath>
+
+
+namespace Numerics
+{
+	OPTION_TARGET_CLONES
+	void NormalCdf(const double* __restrict x, double* __restrict out, const std::size_t count, const NormalTier tier)
+	{
+		//	The tier is resolved once, outside the loops
+		if (tier == NormalTier::Fast)
+		{
+			OPTION_SIMD_LOOP
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = NormalCdfFast(x[i]);
+			}
+		}
+		else if (tier == NormalTier::Exact)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = NormalCdfExact(x[i]);
+			}
+		}
+		else
+		{
+			OPTION_SIMD_LOOP
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = NormalCdfAccurate(x[i]);
+			}
+		}
+	}
+
+	OPTION_TARGET_CLONES
+	void NormalPdf(const double* __restrict x, double* __restrict out, const std::size_t count)
+	{
+		OPTION_SIMD_LOOP
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = NormalPdf(x[i]);
+		}
+	}
+
+
+	//	Gauss-Legendre nodes (negative half) and weights with 6, 12 and 20 points
+	static const double LegendreX[3][10] = {
+		{ -0.9324695142031522, -0.6612093864662647, -0.2386191860831970 },
+		{ -0.9815606342467191, -0.9041172563704750, -0.7699026741943050, -0.5873179542866171, -0.3678314989981802,
+			-0.1252334085114692 },
+		{ -0.9931285991850949, -0.9639719272779138, -0.9122344282513259, -0.8391169718222188, -0.7463319064601508,
+			-0.6360536807265150, -0.5108670019508271, -0.3737060887154196, -0.2277858511416451, -0.07652652113349733 } };
+
+	static const double LegendreW[3][10] = {
+		{ 0.1713244923791705, 0.3607615730481384, 0.4679139345726904 },
+		{ 0.04717533638651177, 0.1069393259953183, 0.1600783285433464, 0.2031674267230659, 0.2334925365383547,
+			0.2491470458134029 },
+		{ 0.01761400713915212, 0.04060142980038694, 0.06267204833410906, 0.08327674157670475, 0.1019301198172404,
+			0.1181945319615184, 0.1316886384491766, 0.1420961093183821, 0.1491729864726037, 0.1527533871307259 } };
+
+	OPTION_TARGET_CLONES
+	double BivariateNormalCdf(const double a, const double b, const double rho)
+	{
+		const double pi = 3.14159265358979323846;
+
+		//	Genz works with the upper orthant P(X > h, Y > k), which is the lower orthant of (-X, -Y)
+		double h = -a;
+		double k = -b;
+		double hk = h * k;
+
+		//	More quadrature points as |rho| grows
+		const int g = (std::fabs(rho) < 0.3) ? 0 : ((std::fabs(rho) < 0.75) ? 1 : 2);
+		const int points = (g == 0) ? 3 : ((g == 1) ? 6 : 10);
+
+		double bvn = 0.0;
+		if (std::fabs(rho) < 0.925)
+		{
+			//	Integral over the correlation from 0 to rho, in asin(rho). The nodes sin(asin(rho) (1 +/- x) / 2) depend on
+			//	rho only; they are kept for the last |rho| seen by the thread (odd in rho), as callers such as the
+			//	Bjerksund-Stensland kernel evaluate many points at one correlation.
+			thread_local double lastRho = -1.0;
+			thread_local double lastAsr = 0.0;
+			thread_local double nodes[20] = {};
+			if (std::fabs(rho) != lastRho)
+			{
+				lastRho = std::fabs(rho);
+				lastAsr = std::asin(lastRho);
+				for (int i = 0; i < points; ++i)
+				{
+					nodes[2 * i] = std::sin(0.5 * lastAsr * (LegendreX[g][i] + 1.0));
+					nodes[2 * i + 1] = std::sin(0.5 * lastAsr * (1.0 - LegendreX[g][i]));
+				}
+			}
+
+			const double sign = (rho < 0.0) ? -1.0 : 1.0;
+			const double hs = 0.5 * (h * h + k * k);
+			double sn[20], terms[20];
+			for (int i = 0; i < 20; ++i)
+			{
+				sn[i] = sign * nodes[i];
+			}
+
+			OPTION_SIMD_LOOP
+			for (int i = 0; i < 20; ++i)
+			{
+				terms[i] = FastExp((sn[i] * hk - hs) / (1.0 - sn[i] * sn[i]));
+			}
+			for (int i = 0; i < 2 * points; ++i)
+			{
+				bvn += LegendreW[g][i / 2] * terms[i];
+			}
+			return sign * bvn * lastAsr / (4.0 * pi) + NormalCdf(-h) * NormalCdf(-k);
+		}
+
+		//	|rho| close to 1: integral from rho to +/-1, after taking out the singular part
+		if (rho < 0.0)
+		{
+			k = -k;
+			hk = -hk;
+		}
+		if (std::fabs(rho) < 1.0)
+		{
+			double as = (1.0 - rho) * (1.0 + rho);
+			double A = std::sqrt(as);
+			double bs = (h - k) * (h - k);
+			double c = (4.0 - hk) / 8.0;
+			double d = (12.0 - hk) / 16.0;
+
+			bvn = A * std::exp(-0.5 * (bs / as + hk)) * (1.0 - c * (bs - as) * (1.0 - d * bs / 5.0) / 3.0 + c * d * as * as / 5.0);
+			if (hk > -160.0)
+			{
+				double B = std::sqrt(bs);
+				bvn -= std::exp(-0.5 * hk) * std::sqrt(2.0 * pi) * NormalCdf(-B / A) * B * (1.0 - c * bs * (1.0 - d * bs / 5.0) / 3.0);
+			}
+
+			A *= 0.5;
+			for (int i = 0; i < points; ++i)
+			{
+				for (int sign = -1; sign <= 1; sign += 2)
+				{
+					double xs = A * (sign * LegendreX[g][i] + 1.0);
+					xs *= xs;
+					double rs = std::sqrt(1.0 - xs);
+					bvn += A * LegendreW[g][i] * (std::exp(-bs / (2.0 * xs) - hk / (1.0 + rs)) / rs
+						- std::exp(-0.5 * (bs / xs + hk)) * (1.0 + c * xs * (1.0 + d * xs)));
+				}
+			}
+			bvn = -bvn / (2.0 * pi);
+		}
+
+		if (rho > 0.0)
+		{
+			return bvn + NormalCdf(-((h > k) ? h : k));
+		}
+
+		bvn = -bvn;
+		if (k > h)
+		{
+			bvn += NormalCdf(k) - NormalCdf(h);
+		}
+		return bvn;
+	}
+}
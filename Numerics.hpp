@@ -0,0 +1,307 @@
+// Inline numerical building blocks shared by the pricing kernels
+//
+// (c) Sudhansh Dua
+//
+//	The functions in this header are branch-free (all branches are written as selects) and use no tables,
+//	so that loops calling them can be vectorised by the compiler. Every pricing kernel in the library takes its
+//	Gaussian functions from here; the batch kernels also use the fast exp/log/sqrt.
+//
+//	Accuracy:
+//	->	FastExp:		<= 2 ulp for -708 < x < 709, 0 below, +inf above
+//	->	FastSqrt:		<= 1 ulp for positive normal x
+//	->	FastLog:		<= 2 ulp for positive normal x, NaN for x <= 0 (denormals are not supported)
+//	->	InverseNormalCdf:	relative error < 1.15e-9 (Acklam)
+//	->	BivariateNormalCdf:	absolute error < 1e-13 (Genz 2004); out of line and not vectorised
+//
+//	The normal CDF comes in three accuracy tiers (see tools/NormalAccuracy.cpp for the full report against boost):
+//	->	NormalTier::Fast		Abramowitz & Stegun 26.2.17, absolute error < 7.5e-8
+//	->	NormalTier::Accurate	Hart (1968) / West (2005), absolute error < 3e-16, relative error < 1e-8 in the
+//							lower tail (default)
+//	->	NormalTier::Exact		0.5 * erfc(-x / sqrt(2)) from <cmath>, relative error < 1e-12; not vectorisable
+//	The default tier used by the kernels can be changed at compile time with -DOPTION_NORMAL_TIER=Fast (or Exact).
+
+
+#ifndef Numerics_HPP
+#define Numerics_HPP
+
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+
+//	Batch kernels are compiled for several instruction sets and the best one is picked at load time
+//	(AVX-512, AVX2 + FMA, and a scalar x86-64 fallback). Compilers without function multi-versioning get a
+//	single version, which is vectorised when the build enables it (e.g. -O3 -march=native).
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__ELF__)
+#define OPTION_TARGET_CLONES __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define OPTION_TARGET_CLONES
+#endif
+
+//	Loop annotation: tells the compiler that the iterations of a batch loop are independent
+#if defined(__GNUC__) && !defined(__clang__)
+#define OPTION_SIMD_LOOP _Pragma("GCC ivdep")
+#elif defined(__clang__)
+#define OPTION_SIMD_LOOP _Pragma("clang loop vectorize(enable)")
+#else
+#define OPTION_SIMD_LOOP
+#endif
+
+#ifndef OPTION_NORMAL_TIER
+#define OPTION_NORMAL_TIER Accurate
+#endif
+
+
+namespace Numerics
+{
+	//	Bit casts between double and its IEEE-754 representation
+	inline std::uint64_t AsBits(double x)
+	{
+		std::uint64_t u;
+		std::memcpy(&u, &x, sizeof(u));
+		return u;
+	}
+
+	inline double AsDouble(std::uint64_t u)
+	{
+		double x;
+		std::memcpy(&x, &u, sizeof(x));
+		return x;
+	}
+
+	const double Ln2Hi = 6.93147180369123816490e-01;		//	high part of log(2), exact in k * Ln2Hi
+	const double Ln2Lo = 1.90821492927058770002e-10;		//	log(2) - Ln2Hi
+	const double Log2e = 1.44269504088896338700e+00;		//	1 / log(2)
+	const double RoundMagic = 6755399441055744.0;			//	1.5 * 2^52: adding it rounds to the nearest integer
+	const double InvSqrt2Pi = 0.398942280401432677940;		//	1 / sqrt(2 * pi)
+
+
+	//	exp(x): x = k * log(2) + f with |f| <= log(2) / 2, exp(f) by its Taylor series to degree 12
+	inline double FastExp(double x)
+	{
+		double xc = (x < -708.0) ? -708.0 : ((x > 709.0) ? 709.0 : x);
+
+		double kd = xc * Log2e + RoundMagic;			//	low bits of kd hold k = round(x / log(2))
+		std::uint64_t kBits = AsBits(kd);
+		kd -= RoundMagic;
+
+		double f = (xc - kd * Ln2Hi) - kd * Ln2Lo;
+
+		double p = 1.0 / 479001600.0;
+		p = p * f + 1.0 / 39916800.0;
+		p = p * f + 1.0 / 3628800.0;
+		p = p * f + 1.0 / 362880.0;
+		p = p * f + 1.0 / 40320.0;
+		p = p * f + 1.0 / 5040.0;
+		p = p * f + 1.0 / 720.0;
+		p = p * f + 1.0 / 120.0;
+		p = p * f + 1.0 / 24.0;
+		p = p * f + 1.0 / 6.0;
+		p = p * f + 0.5;
+		p = p * f + 1.0;
+		p = p * f + 1.0;
+
+		//	2^k, built directly in the exponent field
+		double scale = AsDouble((kBits - AsBits(RoundMagic) + 1023) << 52);
+		double result = p * scale;
+
+		result = (x < -708.0) ? 0.0 : result;
+		result = (x > 709.0) ? std::numeric_limits<double>::infinity() : result;
+		return result;
+	}
+
+
+	//	log(x): x = 2^e * m with sqrt(1/2) <= m < sqrt(2), log(m) = 2 atanh(s) with s = (m - 1) / (m + 1)
+	inline double FastLog(double x)
+	{
+		std::uint64_t bits = AsBits(x);
+
+		//	Exponent field as a double without an integer conversion
+		double e = AsDouble((bits >> 52) | AsBits(4503599627370496.0)) - 4503599627370496.0 - 1023.0;
+		double m = AsDouble((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+
+		bool high = (m > 1.41421356237309504880);
+		m = high ? 0.5 * m : m;
+		e = high ? e + 1.0 : e;
+
+		double s = (m - 1.0) / (m + 1.0);
+		double z = s * s;
+
+		double p = 1.0 / 23.0;
+		p = p * z + 1.0 / 21.0;
+		p = p * z + 1.0 / 19.0;
+		p = p * z + 1.0 / 17.0;
+		p = p * z + 1.0 / 15.0;
+		p = p * z + 1.0 / 13.0;
+		p = p * z + 1.0 / 11.0;
+		p = p * z + 1.0 / 9.0;
+		p = p * z + 1.0 / 7.0;
+		p = p * z + 1.0 / 5.0;
+		p = p * z + 1.0 / 3.0;
+
+		double logm = 2.0 * s + 2.0 * s * z * p;
+		double result = e * Ln2Hi + (logm + e * Ln2Lo);
+
+		result = (x > 0.0) ? result : std::numeric_limits<double>::quiet_NaN();
+		return result;
+	}
+
+
+	//	sqrt(x) for x >= 0: Newton iterations on 1 / sqrt(x) from a bit-level first guess. std::sqrt may set
+	//	errno, which stops the compiler from vectorising any loop that calls it.
+	inline double FastSqrt(double x)
+	{
+		double y = AsDouble(0x5fe6eb50c7b537a9ULL - (AsBits(x) >> 1));		//	1 / sqrt(x) to within 3.5%
+		double h = 0.5 * x;
+		y = y * (1.5 - h * y * y);
+		y = y * (1.5 - h * y * y);
+		y = y * (1.5 - h * y * y);
+		y = y * (1.5 - h * y * y);
+
+		double s = x * y;
+		s = s + 0.5 * (x - s * s) * y;			//	final correction to the square root itself
+
+		return (x > 0.0) ? s : ((x == 0.0) ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+	}
+
+
+	//	Accuracy tiers of the cumulative normal distribution function
+	enum class NormalTier { Fast, Accurate, Exact };
+
+	const NormalTier DefaultNormalTier = NormalTier::OPTION_NORMAL_TIER;
+
+
+	//	Normal probability density function
+	inline double NormalPdf(double x)
+	{
+		return InvSqrt2Pi * FastExp(-0.5 * x * x);
+	}
+
+
+	//	Cumulative normal distribution function, Hart (1968) as given by West (2005)
+	inline double NormalCdfAccurate(double x)
+	{
+		double z = std::fabs(x);
+		double e = FastExp(-0.5 * z * z);
+
+		//	Rational approximation for |x| < 10 / sqrt(2)
+		double num = 0.0352624965998911;
+		num = num * z + 0.700383064443688;
+		num = num * z + 6.37396220353165;
+		num = num * z + 33.912866078383;
+		num = num * z + 112.079291497871;
+		num = num * z + 221.213596169931;
+		num = num * z + 220.206867912376;
+
+		double den = 0.0883883476483184;
+		den = den * z + 1.75566716318264;
+		den = den * z + 16.064177579207;
+		den = den * z + 86.7807322029461;
+		den = den * z + 296.564248779674;
+		den = den * z + 637.333633378831;
+		den = den * z + 793.826512519948;
+		den = den * z + 440.413735824752;
+
+		//	Continued fraction for the tail
+		double cf = z + 0.65;
+		cf = z + 4.0 / cf;
+		cf = z + 3.0 / cf;
+		cf = z + 2.0 / cf;
+		cf = z + 1.0 / cf;
+
+		//	Beyond |x| = 37.6 the exponential underflows to 0, and so does the tail
+		double tail = (z < 7.07106781186547) ? (e * num / den) : (e * InvSqrt2Pi / cf);
+
+		return (x > 0.0) ? 1.0 - tail : tail;
+	}
+
+	//	Cumulative normal distribution function, Abramowitz & Stegun (1964) 26.2.17
+	inline double NormalCdfFast(double x)
+	{
+		double z = std::fabs(x);
+		double t = 1.0 / (1.0 + 0.2316419 * z);
+
+		double poly = 1.330274429;
+		poly = poly * t - 1.821255978;
+		poly = poly * t + 1.781477937;
+		poly = poly * t - 0.356563782;
+		poly = poly * t + 0.319381530;
+
+		double tail = NormalPdf(z) * poly * t;
+		return (x > 0.0) ? 1.0 - tail : tail;
+	}
+
+	//	Cumulative normal distribution function from the complementary error function (reference tier)
+	inline double NormalCdfExact(double x)
+	{
+		return 0.5 * std::erfc(-x * 0.707106781186547524401);
+	}
+
+	template <NormalTier Tier = DefaultNormalTier>
+	inline double NormalCdf(double x)
+	{
+		return (Tier == NormalTier::Fast) ? NormalCdfFast(x) : ((Tier == NormalTier::Exact) ? NormalCdfExact(x) : NormalCdfAccurate(x));
+	}
+
+
+	//	Inverse of the normal distribution function for 0 < p < 1, Acklam (2003): relative error < 1.15e-9. The central
+	//	and tail rational approximations are both evaluated and selected, so that loops calling it can be vectorised.
+	inline double InverseNormalCdf(double p)
+	{
+		//	Central region, |p - 0.5| <= 0.47575
+		double q = p - 0.5;
+		double r = q * q;
+
+		double num = -3.969683028665376e+01;
+		num = num * r + 2.209460984245205e+02;
+		num = num * r - 2.759285104469687e+02;
+		num = num * r + 1.383577518672690e+02;
+		num = num * r - 3.066479806614716e+01;
+		num = num * r + 2.506628277459239e+00;
+
+		double den = -5.447609879822406e+01;
+		den = den * r + 1.615858368580409e+02;
+		den = den * r - 1.556989798598866e+02;
+		den = den * r + 6.680131188771972e+01;
+		den = den * r - 1.328068155288572e+01;
+		den = den * r + 1.0;
+
+		double central = num * q / den;
+
+		//	Tails, from the smaller of p and 1 - p
+		double t = FastSqrt(-2.0 * FastLog((p < 0.5) ? p : 1.0 - p));
+
+		double tnum = -7.784894002430293e-03;
+		tnum = tnum * t - 3.223964580411365e-01;
+		tnum = tnum * t - 2.400758277161838e+00;
+		tnum = tnum * t - 2.549732539343734e+00;
+		tnum = tnum * t + 4.374664141464968e+00;
+		tnum = tnum * t + 2.938163982698783e+00;
+
+		double tden = 7.784695709041462e-03;
+		tden = tden * t + 3.224671290700398e-01;
+		tden = tden * t + 2.445134137142996e+00;
+		tden = tden * t + 3.754408661907416e+00;
+		tden = tden * t + 1.0;
+
+		double tail = tnum / tden;						//	lower tail; the upper tail is its mirror image
+
+		return (std::fabs(q) <= 0.47575) ? central : ((p < 0.5) ? tail : -tail);
+	}
+
+
+	//	Packed forms: out[i] = N(x[i]) or n(x[i]) for i = 0 .. count-1 (vectorised, see Numerics.cpp)
+	void NormalCdf(const double* x, double* out, const std::size_t count, const NormalTier tier = DefaultNormalTier);
+	void NormalPdf(const double* x, double* out, const std::size_t count);
+
+
+	//	Bivariate normal distribution function: P(X <= a, Y <= b) for standard normals X, Y with correlation rho
+	//	(Genz 2004, Gauss-Legendre quadrature of the Drezner & Wesolowsky (1990) integral in rho)
+	double BivariateNormalCdf(const double a, const double b, const double rho);
+}
+
+
+#endif
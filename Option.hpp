@@ -1,67 +1,135 @@
-// Class that defines the base class: Options
-//
-// (c) Sudhansh Dua
-
-
-#ifndef Option_HPP
-#define Option_HPP
-
-
-#include <iostream>
-using namespace std;
-
-
-class Option
-{
-private:
-	void init();
-	void copy(const Option& option);
-
-	// 'Kernel' functions for option calculations
-	double CallPrice() const;						//	Call option price
-	double PutPrice() const;						//	Put option price
-
-
-	// Gaussian functions
-	double n(double x) const;		//	Normal Probability Density function
-	double N(double x) const;		//	Cumulative Probability Density function
-
-public:
-	//	Member data
-	double S;			//	current stock price where we wish to price the option
-	double K;			//	Strike Price
-	double T;			//	time to maturity
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double b;			//	Cost of carry
-	string type;		//	"C" - call option, "P" - put option
-
-	//	Constructors and destructor
-	Option();												//	default constructor
-	Option(const Option& option);							//	copy constructor
-	Option(const double& S1, const double& K1, const double& T1, const double& r1,
-		const double& sig1, const double& b1, const string type1);	//	constructor that accepts values
-	virtual ~Option();										// destructor
-
-
-	//	Assignment operator
-	Option& operator = (const Option& option);
-
-
-	// Functions that calculate option price and sensitivities
-	double Price() const;
-
-
-	// Modifier functions
-	void toggle();					//	Change option type (Call to Put, Put to Call)
-
-
-};
-
-//	Global functions
-double CallPrice(const double S, const double K, const double T, const double r, const double sig, const double b);
-double PutPrice(const double S, const double K, const double T, const double r, const double sig, const double b);
-
-
-#endif
-
+// Class that defines the base class: Options
+//
+// (c) Sudhansh Dua
+
+
+#ifndef Option_HPP
+#define Option_HPP
+
+
+#include "OptionTraits.hpp"
+#include "Numerics.hpp"
+#include "Dual.hpp"
+#include <iostream>
+#include <cmath>
+using namespace std;
+
+
+//	Price and sensitivities of an option, computed together in one pass
+struct OptionGreeks
+{
+	double Price;
+	double Delta;
+	double Gamma;
+	double Vega;
+	double Theta;
+	double Rho;
+	double Coc;
+};
+
+
+class Option
+{
+private:
+	void init();
+	void copy(const Option& option);
+
+	// 'Kernel' functions for option calculations
+	double CallPrice() const;						//	Call option price
+	double PutPrice() const;						//	Put option price
+
+
+	// Gaussian functions
+	double n(double x) const;		//	Normal Probability Density function
+	double N(double x) const;		//	Cumulative Probability Density function
+
+public:
+	//	Member data
+	double S;			//	current stock price where we wish to price the option
+	double K;			//	Strike Price
+	double T;			//	time to maturity
+	double r;			//	risk-free interest rate
+	double sig;			//	Volatility
+	double b;			//	Cost of carry
+	OptionType type;		//	OptionType::Call or OptionType::Put
+
+	//	Constructors and destructor
+	Option();												//	default constructor
+	Option(const Option& option);							//	copy constructor
+	Option(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);	//	constructor that accepts values
+	Option(const double& S1, const double& K1, const double& T1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);	//	"C" - call option, "P" - put option
+	virtual ~Option();										// destructor
+
+
+	//	Assignment operator
+	Option& operator = (const Option& option);
+
+
+	// Functions that calculate option price and sensitivities
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+
+};
+
+//	Global functions
+double CallPrice(const double S, const double K, const double T, const double r, const double sig, const double b);
+double PutPrice(const double S, const double K, const double T, const double r, const double sig, const double b);
+
+//	Compile-time kernel: VanillaPrice<Call> or VanillaPrice<Put>. Like all the kernels of the library it is a template on
+//	the scalar type Real: double for prices, Dual (Dual.hpp) for prices with their derivatives.
+template <class Type, class Real>
+inline Real VanillaPrice(const Real& S, const Real& K, const Real& T, const Real& r, const Real& sig, const Real& b)
+{
+	Real d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
+	Real d2 = d1 - (sig * sqrt(T));
+
+	return Type::phi * ((S * exp((b - r) * T) * Numerics::NormalCdf(Type::phi * d1)) - (K * exp(-r * T) * Numerics::NormalCdf(Type::phi * d2)));
+}
+
+
+//	Automatic differentiation of a kernel
+//
+//	kernel(S, T, r, sig, b) is called once on GreeksDual inputs, with the other contract terms (strike, barrier, ...)
+//	captured as constants. The spot is seeded in both levels of the nested dual, which gives gamma; the outer level
+//	gives the first derivatives in S, T, r, sig and b. The conventions are those of the analytic European Greeks:
+//	Theta = -dV/dT, Coc = dV/db, and Rho moves r with the cost of carry b held at b - r (b = r - q), or with b = 0
+//	held at 0 (futures).
+typedef Dual<Dual<double, 1>, 5> GreeksDual;
+
+template <class Kernel>
+OptionGreeks AutoGreeks(const Kernel& kernel, const double S, const double T, const double r, const double sig, const double b)
+{
+	typedef Dual<double, 1> Inner;
+
+	GreeksDual v = kernel(GreeksDual::Variable(Inner::Variable(S, 0), 0), GreeksDual::Variable(Inner(T), 1),
+		GreeksDual::Variable(Inner(r), 2), GreeksDual::Variable(Inner(sig), 3), GreeksDual::Variable(Inner(b), 4));
+
+	OptionGreeks g;
+	g.Price = v.v.v;
+	g.Delta = v.d[0].v;
+	g.Gamma = v.d[0].d[0];
+	g.Vega = v.d[3].v;
+	g.Theta = -v.d[1].v;
+	g.Rho = (b != 0.0) ? v.d[2].v + v.d[4].v : v.d[2].v;
+	g.Coc = v.d[4].v;
+	return g;
+}
+
+
+//	Batch kernel: prices n options given as structure-of-arrays inputs (one array per parameter) and writes
+//	the prices into price[0 .. n-1]. isCall[i] is non-zero for a call and 0 for a put. The loop does not
+//	allocate and is vectorised (AVX-512 or AVX2, picked at load time, with a scalar fallback).
+//	Prices agree with CallPrice/PutPrice to within 1e-13 * max(S, K) (absolute).
+void BatchPrice(const double* S, const double* K, const double* T, const double* r, const double* sig, const double* b,
+	const int* isCall, double* price, const size_t n);
+
+
+#endif
+
@@ -0,0 +1,63 @@
+// Compile-time product traits: the option type (call/put) and barrier type (in/out) of a contract
+//
+// (c) Sudhansh Dua
+//
+//	The pricing kernels are templates on the tag structs below, e.g. VanillaPrice<Call>(...) or
+//	BarrierPrice<Put, Out>(...), so the call/put and in/out choices are made by the compiler and the kernels
+//	contain no branches on them. The option classes store the choice as an enum; their string-based
+//	constructors ("C"/"P", "In"/"Out") parse it once.
+
+
+#ifndef OptionTraits_HPP
+#define OptionTraits_HPP
+
+
+#include <string>
+using namespace std;
+
+
+enum class OptionType { Call, Put };
+enum class BarrierType { In, Out };
+enum class ExerciseType { European, American };
+
+
+//	Option type tags: phi is the sign of the payoff, max(phi * (S - K), 0)
+struct Call
+{
+	static constexpr OptionType type = OptionType::Call;
+	static constexpr double phi = 1.0;
+};
+
+struct Put
+{
+	static constexpr OptionType type = OptionType::Put;
+	static constexpr double phi = -1.0;
+};
+
+
+//	Barrier type tags
+struct In
+{
+	static constexpr BarrierType type = BarrierType::In;
+};
+
+struct Out
+{
+	static constexpr BarrierType type = BarrierType::Out;
+};
+
+
+//	Parsing layer for the string-based constructors: "C" is a call and anything else a put,
+//	"In" is an in barrier and anything else an out barrier
+inline OptionType ParseOptionType(const string& type)
+{
+	return (type == "C") ? OptionType::Call : OptionType::Put;
+}
+
+inline BarrierType ParseBarrierType(const string& InOrOut)
+{
+	return (InOrOut == "In") ? BarrierType::In : BarrierType::Out;
+}
+
+
+#endif
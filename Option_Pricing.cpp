@@ -1,274 +1,420 @@
-// Testing the exotic option classes
-//
-// (c) Sudhansh Dua
-
-// Base class
-#include "Option.hpp"
-
-// Derived Classes
-#include "EuropeanOption.hpp"
-#include "PerpetualAmericanOption.hpp"
-#include "ChooserOption.hpp"
-#include "BarrierOption.hpp"
-#include "DigitalOption.hpp"
-#include "AssetOrNothingOption.hpp"
-#include "CashOrNothingOption.hpp"
-#include "AsianGeometricOption.hpp"
-#include "GapOption.hpp"
-
-// In-built Header files
-#include <iostream>
-#include <iomanip>
-using namespace std;
-
-
-int main()
-{	
-	
-	////////////////////////////		Chooser Option		///////////////////////////////
-	// Chooser Option parameters
-	double S_1 = 50.0;
-	double K_1 = 50.0;
-	double T_1 = 0.5;
-	double t = 0.25;
-	double r_1 = 0.08;
-	double sig_1 = 0.25;
-	double b_1 = r_1;
-	ChooserOption option_1(S_1, K_1, T_1, t, r_1, sig_1, b_1);
-	double price_1 = option_1.Price();
-	cout << "Simple Chooser Option price:\t" << setprecision(10) << setprecision(10) << price_1 << endl;	// 6.1071
-	cout << "\n";
-
-	//////////////////////////////////////////		Barrier Options		//////////////////////////////////////
-	// Down-Barrier option parameters (S >= H)
-	double S_2 = 100.0;
-	double K_2 = 100.0;
-	double H = 100.0;
-	double cr = 3;
-	double T_2 = 0.5;
-	double r_2 = 0.08;
-	double sig_2 = 0.25;
-	double b_2 = 0.04;
-	BarrierOption option_2(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "P", "In");
-	BarrierOption option_3(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "C", "In");
-	BarrierOption option_4(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "P", "Out");
-	BarrierOption option_5(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "C", "Out");
-
-	double price_2 = option_2.Price();
-	double price_3 = option_3.Price();
-	double price_4 = option_4.Price();
-	double price_5 = option_5.Price();
-
-	cout << "Down and in put barrier price: \t" << setprecision(10) << price_2 << endl;		// 5.9085
-	cout << "Down and in call barrier price: \t" << setprecision(10) << price_3 << endl;	// 7.8494
-	cout << "Down and out put barrier price: \t" << setprecision(10) << price_4 << endl;	// 3.0
-	cout << "Down and out call barrier price: \t" << setprecision(10) << price_5 << endl;	// 3.0
-
-	// Up-Barrier option parameters (S < H)
-	double H_2 = 105.0;
-
-	BarrierOption option_6(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "P", "In");
-	BarrierOption option_7(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "C", "In");
-	BarrierOption option_8(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "P", "Out");
-	BarrierOption option_9(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "C", "Out");
-
-	double price_6 = option_6.Price();
-	double price_7 = option_7.Price();
-	double price_8 = option_8.Price();
-	double price_9 = option_9.Price();
-
-	cout << "Up and in put barrier price: \t" << setprecision(10) << price_6 << endl;		// 3.3721
-	cout << "Up and in call barrier price: \t" << setprecision(10) << price_7 << endl;		// 8.4482
-	cout << "Up and out put barrier price: \t" << setprecision(10) << price_8 << endl;		// 5.4932
-	cout << "Up and out call barrier price: \t" << setprecision(10) << price_9 << endl;		// 2.3580
-	cout << "\n";
-
-
-	////////////////////////////		Digital Option		///////////////////////////////
-	// Digital Option parameters
-	double S_3 = 100.0;
-	double K_3 = 80.0;
-	double T_3 = 0.75;
-	double r_3 = 0.06;
-	double sig_3 = 0.35;
-	double b_3 = 0;		//	constant dividend yield = risk-free rate
-	DigitalOption option_10(S_3, K_3, T_3, r_3, sig_3, b_3, "P");
-
-	double price_10 = option_10.Price();
-
-	cout << "Digital Put option price: \t" << setprecision(10) << price_10 << endl;		// 0.26710
-	cout << "\n";
-
-
-	///////////////////////////////////		Asset-Or-Nothing Option		//////////////////////////////////
-	// AssetOrNothing Option parameters
-	double S_4 = 70.0;
-	double K_4 = 65.0;
-	double T_4 = 0.5;
-	double r_4 = 0.05;
-	double sig_4 = 0.27;
-	double b_4 = 0.02;		//	constant dividend yield = 0.07
-
-	AssetOrNothingOption option_11(S_4, K_4, T_4, r_4, sig_4, b_4, "P");
-	double price_11 = option_11.Price();
-	cout << "Asset-or-nothing option price: \t" << setprecision(10) << price_11 << endl;	// 20.2069
-	cout << "\n";
-
-
-	////////////////////////////		Cash-or-nothing Option		///////////////////////////////
-	// Cash-or-nothing Option parameters
-	double S_5 = 100.0;
-	double K_5 = 80.0;
-	double T_5 = 0.75;
-	double r_5 = 0.06;
-	double sig_5 = 0.35;
-	double b_5 = 0;		//	constant dividend yield = risk-free rate
-	double cr_2 = 10;
-	CashOrNothingOption option_12(S_5, K_5, cr_2, T_5, r_5, sig_5, b_5, "P");
-
-	double price_12 = option_12.Price();
-
-	cout << "Cash-or-nothing Put option price: \t" << setprecision(10) << price_12 << endl;		// 2.6710
-	cout << "\n";
-	
-
-	////////////////////////////////////		Asian Geometric Option			///////////////////////////////
-	// Asian Geometric option parameters
-	// Cash-or-nothing Option parameters
-	double S_6 = 80.0;
-	double K_6 = 85.0;
-	double T_6 = 0.25;
-	double r_6 = 0.05;
-	double sig_6 = 0.2;
-	double b_6 = 0.08;
-
-	Option option_13(S_6, K_6, T_6, r_6, sig_6, b_6, "P");
-
-	double price_13 = option_13.Price();
-
-	cout << "Asian continuous Geometric Put option price: \t" << setprecision(10) << price_13 << endl;		// 5.2186
-	cout << "\n";
-	
-
-	////////////////////////////		European Option		///////////////////////////////
-	// European Option parameters
-	double S_7 = 60.0;
-	double K_7 = 65.0;
-	double T_7 = 0.25;
-	double r_7 = 0.08;
-	double sig_7 = 0.3;
-	double b_7 = r_7;		//	constant dividend yield = risk-free rate
-
-	EuropeanOption option_14(S_7, K_7, T_7, r_7, sig_7, b_7, "C");
-	EuropeanOption option_15(S_7, K_7, T_7, r_7, sig_7, b_7, "P");
-
-	double price_14 = option_14.Price();
-	double price_15 = option_15.Price();
-
-	cout << "European Call option price: \t" << setprecision(10) << price_14 << endl;		// 2.13337
-	cout << "European Put option price: \t" << setprecision(10) << price_15 << endl;		// 5.84628
-	cout << "\n";
-
-
-	///////////////////////////////////////		Perpetual American Option		////////////////////////////////
-	// Perpetual American Option parameters
-	double S_8 = 110.0;
-	double K_8 = 100.0;
-	double r_8 = 0.1;
-	double sig_8 = 0.1;
-	double b_8 = 0.02;		//	constant dividend yield = risk-free rate
-
-	PerpetualAmericanOption option_16(S_8, K_8, r_8, sig_8, b_8, "C");
-	PerpetualAmericanOption option_17(S_8, K_8, r_8, sig_8, b_8, "P");
-
-	double price_16 = option_16.Price();
-	double price_17 = option_17.Price();
-
-	cout << "Perpetual American Call option price: \t" << setprecision(10) << price_16 << endl;		// 18.50349988
-	cout << "Perpetual American Put option price: \t" << setprecision(10) << price_17 << endl;		// 3.031060383
-	cout << "\n";
-	
-	
-	////////////////////////////////		European Futures Option		/////////////////////////////////
-	// 
-	// Pricing of European options when the underlying security is a forward or futures contract with initial
-	// 
-	// European Futures Option parameters
-	double S_9 = 100.0;
-	double K_9 = 95.0;
-	double T_9 = 0.5;
-	double r_9 = 0.1;
-	double sig_9 = 0.2;
-	//	The cost-of-carry parameter b = 0 for the Black(1976) futures option model
-	//	because,
-	//	the risk-free rate (discounting) = risk-free rate (used for calculating the forward/futures price)
-	double b_9 = 0.0;
-
-	EuropeanOption option_18(S_9, K_9, T_9, r_9, sig_9, b_9, "P");
-	
-	double price_18 = option_18.Price();
-
-	cout << "European Futures Put option price: \t" << setprecision(10) << price_18 << endl;	// 3.189643695
-	cout << "\n";
-
-
-	////////////////////////////	Options on Stock Indices		///////////////////////////////
-	// Parameters
-	double S_10 = 100.0;
-	double K_10 = 95.0;
-	double T_10 = 0.5;
-	double r_10 = 0.1;
-	double sig_10 = 0.2;
-	double q = 0.05;			//	Continuous dividend yield
-	double b_10 = r_10 - q;		//	b = r - q Merton (1973) stock option model with continuous dividend yield
-
-	EuropeanOption option_19(S_10, K_10, T_10, r_10, sig_10, b_10, "P");
-
-	double price_19 = option_19.Price();
-
-	cout << "Price of the option on a stock index: \t" << setprecision(10) << price_19 << endl;		// 2.464787647
-	cout << "\n";
-	
-
-
-	////////////////////////////		European FX options			///////////////////////////////
-	// USD-call/EUR-put option			
-	// 
-	// Option parameters
-	double S_11 = 1.56;				//	current USD/EUR exchange rate
-	double K_11 = 1.6;
-	double r_11 = 0.08;				//	domestic risk-free interest rate (in EUR)
-	double rfr = 0.06;				//	foreign risk-free rate (in USD)
-	double T_11 = 0.5;
-	double sig_11 = 0.12;
-	double b_11 = r_11 - rfr;		//	b = r - rfr Garman and Kohlhagen (1983) currency option model, where rfr = 'foreign' interest rate
-	string type = "C";				//	Call on USD, the foreign risk-free rate
-
-	EuropeanOption option_20(S_11, K_11, T_11, r_11, sig_11, b_11, type);
-
-	double price_20 = option_20.Price();
-
-	cout << "FX option premium (in USD/EUR): \t" << setprecision(10) << price_20 << endl;	// 0.04078	
-	cout << "\n";
-	
-
-	////////////////////////////		Gap Option		///////////////////////////////
-	// Gap Option parameters
-	double S_12 = 50.0;
-	double K1_12 = 50.0;
-	double K2_12 = 57.0;
-	double T_12 = 0.5;
-	double r_12 = 0.09;
-	double sig_12 = 0.2;
-	double b_12 = r_12;			//	constant dividend yield = risk-free rate
-
-	GapOption option_21(S_12, K1_12, K2_12, T_12, r_12, sig_12, b_12, "C");
-
-	double price_21 = option_21.Price();
-
-
-	cout << "Gap option price: \t" << setprecision(10) << price_21 << endl;		//  -0.00525
-	cout << "\n";
-
-
-}
+// Testing the exotic option classes
+//
+// (c) Sudhansh Dua
+
+// Base class
+#include "Option.hpp"
+
+// Derived Classes
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "AmericanOption.hpp"
+#include "AmericanApproxOption.hpp"
+#include "ChooserOption.hpp"
+#include "BarrierOption.hpp"
+#include "BarrierMonteCarlo.hpp"
+#include "DigitalOption.hpp"
+#include "AssetOrNothingOption.hpp"
+#include "CashOrNothingOption.hpp"
+#include "AsianGeometricOption.hpp"
+#include "AsianArithmeticOption.hpp"
+#include "GapOption.hpp"
+
+// Portfolio pricing
+#include "PortfolioPricer.hpp"
+#include "PortfolioStore.hpp"
+#include "ScenarioEngine.hpp"
+#include "HistoricalVaR.hpp"
+#include "Random.hpp"
+#include "TickRepricer.hpp"
+#include "ChebyshevProxy.hpp"
+
+// In-built Header files
+#include <iostream>
+#include <iomanip>
+using namespace std;
+
+
+int main()
+{	
+	
+	////////////////////////////		Chooser Option		///////////////////////////////
+	// Chooser Option parameters
+	double S_1 = 50.0;
+	double K_1 = 50.0;
+	double T_1 = 0.5;
+	double t = 0.25;
+	double r_1 = 0.08;
+	double sig_1 = 0.25;
+	double b_1 = r_1;
+	ChooserOption option_1(S_1, K_1, T_1, t, r_1, sig_1, b_1);
+	double price_1 = option_1.Price();
+	cout << "Simple Chooser Option price:\t" << setprecision(10) << setprecision(10) << price_1 << endl;	// 6.1071
+	cout << "\n";
+
+	//////////////////////////////////////////		Barrier Options		//////////////////////////////////////
+	// Down-Barrier option parameters (S >= H)
+	double S_2 = 100.0;
+	double K_2 = 100.0;
+	double H = 100.0;
+	double cr = 3;
+	double T_2 = 0.5;
+	double r_2 = 0.08;
+	double sig_2 = 0.25;
+	double b_2 = 0.04;
+	BarrierOption option_2(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "P", "In");
+	BarrierOption option_3(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "C", "In");
+	BarrierOption option_4(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "P", "Out");
+	BarrierOption option_5(S_2, H, K_2, cr, T_2, r_2, sig_2, b_2, "C", "Out");
+
+	double price_2 = option_2.Price();
+	double price_3 = option_3.Price();
+	double price_4 = option_4.Price();
+	double price_5 = option_5.Price();
+
+	cout << "Down and in put barrier price: \t" << setprecision(10) << price_2 << endl;		// 5.9085
+	cout << "Down and in call barrier price: \t" << setprecision(10) << price_3 << endl;	// 7.8494
+	cout << "Down and out put barrier price: \t" << setprecision(10) << price_4 << endl;	// 3.0
+	cout << "Down and out call barrier price: \t" << setprecision(10) << price_5 << endl;	// 3.0
+
+	// Up-Barrier option parameters (S < H)
+	double H_2 = 105.0;
+
+	BarrierOption option_6(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "P", "In");
+	BarrierOption option_7(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "C", "In");
+	BarrierOption option_8(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "P", "Out");
+	BarrierOption option_9(S_2, H_2, K_2, cr, T_2, r_2, sig_2, b_2, "C", "Out");
+
+	double price_6 = option_6.Price();
+	double price_7 = option_7.Price();
+	double price_8 = option_8.Price();
+	double price_9 = option_9.Price();
+
+	cout << "Up and in put barrier price: \t" << setprecision(10) << price_6 << endl;		// 3.3721
+	cout << "Up and in call barrier price: \t" << setprecision(10) << price_7 << endl;		// 8.4482
+	cout << "Up and out put barrier price: \t" << setprecision(10) << price_8 << endl;		// 5.4932
+	cout << "Up and out call barrier price: \t" << setprecision(10) << price_9 << endl;		// 2.3580
+
+	// The same up and out call with the barrier checked at the 126 daily closes only
+	ThreadPool pool_barrier;
+	MonteCarloResult result_daily = BarrierMonteCarloPrice(option_9, BarrierMonitoring::Discrete, 126, MonteCarloSettings(), pool_barrier);
+
+	cout << "Daily up and out call, Broadie-Glasserman-Kou: \t" << setprecision(6) << option_9.DiscretePrice(126) << endl;
+	cout << "Daily up and out call, Monte Carlo: \t" << setprecision(6) << result_daily.Price
+		<< " (standard error " << setprecision(2) << result_daily.StdError << ")" << endl;
+	cout << "\n";
+
+
+	////////////////////////////		Digital Option		///////////////////////////////
+	// Digital Option parameters
+	double S_3 = 100.0;
+	double K_3 = 80.0;
+	double T_3 = 0.75;
+	double r_3 = 0.06;
+	double sig_3 = 0.35;
+	double b_3 = 0;		//	constant dividend yield = risk-free rate
+	DigitalOption option_10(S_3, K_3, T_3, r_3, sig_3, b_3, "P");
+
+	double price_10 = option_10.Price();
+
+	cout << "Digital Put option price: \t" << setprecision(10) << price_10 << endl;		// 0.26710
+	cout << "\n";
+
+
+	///////////////////////////////////		Asset-Or-Nothing Option		//////////////////////////////////
+	// AssetOrNothing Option parameters
+	double S_4 = 70.0;
+	double K_4 = 65.0;
+	double T_4 = 0.5;
+	double r_4 = 0.05;
+	double sig_4 = 0.27;
+	double b_4 = 0.02;		//	constant dividend yield = 0.07
+
+	AssetOrNothingOption option_11(S_4, K_4, T_4, r_4, sig_4, b_4, "P");
+	double price_11 = option_11.Price();
+	cout << "Asset-or-nothing option price: \t" << setprecision(10) << price_11 << endl;	// 20.2069
+	cout << "\n";
+
+
+	////////////////////////////		Cash-or-nothing Option		///////////////////////////////
+	// Cash-or-nothing Option parameters
+	double S_5 = 100.0;
+	double K_5 = 80.0;
+	double T_5 = 0.75;
+	double r_5 = 0.06;
+	double sig_5 = 0.35;
+	double b_5 = 0;		//	constant dividend yield = risk-free rate
+	double cr_2 = 10;
+	CashOrNothingOption option_12(S_5, K_5, cr_2, T_5, r_5, sig_5, b_5, "P");
+
+	double price_12 = option_12.Price();
+
+	cout << "Cash-or-nothing Put option price: \t" << setprecision(10) << price_12 << endl;		// 2.6710
+	cout << "\n";
+	
+
+	////////////////////////////////////		Asian Geometric Option			///////////////////////////////
+	// Asian Geometric option parameters
+	double S_6 = 80.0;
+	double K_6 = 85.0;
+	double T_6 = 0.25;
+	double r_6 = 0.05;
+	double sig_6 = 0.2;
+	double b_6 = 0.08;
+
+	AsianGeometricOption option_13(S_6, K_6, T_6, r_6, sig_6, b_6, "P");
+
+	double price_13 = option_13.Price();
+
+	cout << "Asian continuous Geometric Put option price: \t" << setprecision(10) << price_13 << endl;		// 4.6922
+	cout << "\n";
+
+	// Arithmetic average of 13 weekly fixings, by Monte Carlo with the geometric average as control variate
+	AsianArithmeticOption option_asian(S_6, K_6, T_6, r_6, sig_6, b_6, 13, "P");
+	MonteCarloResult result_asian = option_asian.Price();
+
+	cout << "Asian weekly Arithmetic Put option price: \t" << setprecision(6) << result_asian.Price
+		<< " (standard error " << setprecision(2) << result_asian.StdError << ")" << endl;
+	cout << "\n";
+	
+
+	////////////////////////////		European Option		///////////////////////////////
+	// European Option parameters
+	double S_7 = 60.0;
+	double K_7 = 65.0;
+	double T_7 = 0.25;
+	double r_7 = 0.08;
+	double sig_7 = 0.3;
+	double b_7 = r_7;		//	constant dividend yield = risk-free rate
+
+	EuropeanOption option_14(S_7, K_7, T_7, r_7, sig_7, b_7, "C");
+	EuropeanOption option_15(S_7, K_7, T_7, r_7, sig_7, b_7, "P");
+
+	double price_14 = option_14.Price();
+	double price_15 = option_15.Price();
+
+	cout << "European Call option price: \t" << setprecision(10) << price_14 << endl;		// 2.13337
+	cout << "European Put option price: \t" << setprecision(10) << price_15 << endl;		// 5.84628
+	cout << "\n";
+
+	// Price and all sensitivities of the call in one pass
+	OptionGreeks greeks_14 = option_14.Greeks();
+	cout << "European Call option delta: \t" << setprecision(10) << greeks_14.Delta << endl;		// 0.3724828
+	cout << "European Call option gamma: \t" << setprecision(10) << greeks_14.Gamma << endl;		// 0.0420428
+	cout << "European Call option vega: \t" << setprecision(10) << greeks_14.Vega << endl;		// 11.35154
+	cout << "\n";
+
+	// Implied volatility recovered from the put price
+	cout << "European Put implied volatility: \t" << setprecision(10) << option_15.ImpliedVol(price_15) << endl;		// 0.3
+	cout << "\n";
+
+
+	///////////////////////////////////////		Perpetual American Option		////////////////////////////////
+	// Perpetual American Option parameters
+	double S_8 = 110.0;
+	double K_8 = 100.0;
+	double r_8 = 0.1;
+	double sig_8 = 0.1;
+	double b_8 = 0.02;		//	constant dividend yield = risk-free rate
+
+	PerpetualAmericanOption option_16(S_8, K_8, r_8, sig_8, b_8, "C");
+	PerpetualAmericanOption option_17(S_8, K_8, r_8, sig_8, b_8, "P");
+
+	double price_16 = option_16.Price();
+	double price_17 = option_17.Price();
+
+	cout << "Perpetual American Call option price: \t" << setprecision(10) << price_16 << endl;		// 18.50349988
+	cout << "Perpetual American Put option price: \t" << setprecision(10) << price_17 << endl;		// 3.031060383
+
+	// The same put with one year to expiry, on the finite-difference grid
+	AmericanOption option_american(S_8, K_8, 1.0, r_8, sig_8, b_8, "P");
+	FiniteDifferenceResult result_american = option_american.Price(FiniteDifferenceSettings());
+	cout << "1-year American Put option price: \t" << setprecision(6) << result_american.Price
+		<< " (delta " << result_american.Delta << ")" << endl;
+
+	// ... and by the analytic approximations; with a very long expiry they reach the perpetual price
+	AmericanApproxOption option_baw(S_8, K_8, 1.0, r_8, sig_8, b_8, AmericanApproximation::BaroneAdesiWhaley, "P");
+	AmericanApproxOption option_bjs(S_8, K_8, 1.0, r_8, sig_8, b_8, AmericanApproximation::BjerksundStensland, "P");
+	AmericanApproxOption option_long(S_8, K_8, 1000.0, r_8, sig_8, b_8, AmericanApproximation::BjerksundStensland, "C");
+	cout << "1-year American Put, Barone-Adesi-Whaley: \t" << setprecision(6) << option_baw.Price() << endl;
+	cout << "1-year American Put, Bjerksund-Stensland: \t" << setprecision(6) << option_bjs.Price() << endl;
+	cout << "1-year American Put, Leisen-Reimer tree: \t" << setprecision(6) << option_american.Price(LatticeSettings()).Price << endl;
+	cout << "1000-year American Call, Bjerksund-Stensland: \t" << setprecision(10) << option_long.Price() << endl;		// 18.50349988
+	cout << "\n";
+	
+	
+	////////////////////////////////		European Futures Option		/////////////////////////////////
+	// 
+	// Pricing of European options when the underlying security is a forward or futures contract with initial
+	// 
+	// European Futures Option parameters
+	double S_9 = 100.0;
+	double K_9 = 95.0;
+	double T_9 = 0.5;
+	double r_9 = 0.1;
+	double sig_9 = 0.2;
+	//	The cost-of-carry parameter b = 0 for the Black(1976) futures option model
+	//	because,
+	//	the risk-free rate (discounting) = risk-free rate (used for calculating the forward/futures price)
+	double b_9 = 0.0;
+
+	EuropeanOption option_18(S_9, K_9, T_9, r_9, sig_9, b_9, "P");
+	
+	double price_18 = option_18.Price();
+
+	cout << "European Futures Put option price: \t" << setprecision(10) << price_18 << endl;	// 3.189643695
+	cout << "\n";
+
+
+	////////////////////////////	Options on Stock Indices		///////////////////////////////
+	// Parameters
+	double S_10 = 100.0;
+	double K_10 = 95.0;
+	double T_10 = 0.5;
+	double r_10 = 0.1;
+	double sig_10 = 0.2;
+	double q = 0.05;			//	Continuous dividend yield
+	double b_10 = r_10 - q;		//	b = r - q Merton (1973) stock option model with continuous dividend yield
+
+	EuropeanOption option_19(S_10, K_10, T_10, r_10, sig_10, b_10, "P");
+
+	double price_19 = option_19.Price();
+
+	cout << "Price of the option on a stock index: \t" << setprecision(10) << price_19 << endl;		// 2.464787647
+	cout << "\n";
+	
+
+
+	////////////////////////////		European FX options			///////////////////////////////
+	// USD-call/EUR-put option			
+	// 
+	// Option parameters
+	double S_11 = 1.56;				//	current USD/EUR exchange rate
+	double K_11 = 1.6;
+	double r_11 = 0.08;				//	domestic risk-free interest rate (in EUR)
+	double rfr = 0.06;				//	foreign risk-free rate (in USD)
+	double T_11 = 0.5;
+	double sig_11 = 0.12;
+	double b_11 = r_11 - rfr;		//	b = r - rfr Garman and Kohlhagen (1983) currency option model, where rfr = 'foreign' interest rate
+	string type = "C";				//	Call on USD, the foreign risk-free rate
+
+	EuropeanOption option_20(S_11, K_11, T_11, r_11, sig_11, b_11, type);
+
+	double price_20 = option_20.Price();
+
+	cout << "FX option premium (in USD/EUR): \t" << setprecision(10) << price_20 << endl;	// 0.04078	
+	cout << "\n";
+	
+
+	////////////////////////////		Gap Option		///////////////////////////////
+	// Gap Option parameters
+	double S_12 = 50.0;
+	double K1_12 = 50.0;
+	double K2_12 = 57.0;
+	double T_12 = 0.5;
+	double r_12 = 0.09;
+	double sig_12 = 0.2;
+	double b_12 = r_12;			//	constant dividend yield = risk-free rate
+
+	GapOption option_21(S_12, K1_12, K2_12, T_12, r_12, sig_12, b_12, "C");
+
+	double price_21 = option_21.Price();
+
+
+	cout << "Gap option price: \t" << setprecision(10) << price_21 << endl;		//  -0.00525
+	cout << "\n";
+
+
+	////////////////////////////		Portfolio		///////////////////////////////
+	// All of the above, priced together on a thread pool
+	vector<Product> portfolio = { option_1, option_2, option_3, option_4, option_5, option_6, option_7, option_8, option_9,
+		option_10, option_11, option_12, option_13, option_14, option_15, option_16, option_17, option_18, option_19,
+		option_20, option_21 };
+	vector<double> quantities(portfolio.size(), 1.0);
+
+	PortfolioPricer pricer;
+	double value = pricer.Value(portfolio, quantities);
+
+	cout << "Portfolio value (one of each option): \t" << setprecision(10) << value << endl;
+	cout << "\n";
+
+
+	////////////////////////////		Columnar store		///////////////////////////////
+	// The same positions column by column, one partition per product, priced by the batch kernels
+	PortfolioStore store;
+	for (size_t i = 0; i < portfolio.size(); ++i)
+	{
+		store.Add(portfolio[i], quantities[i], 1000 + i);
+	}
+
+	cout << "Columnar store: " << store.Size() << " positions, " << store.Partition(StoreKind::Barrier).Size() << " barriers, "
+		<< store.Partition(StoreKind::Vanilla).Size() << " vanillas" << endl;
+	cout << "Store value: \t" << setprecision(10) << pricer.Value(store) << "\t(portfolio value " << value << ")" << endl;
+	cout << "\n";
+
+
+	////////////////////////////		Scenario grid		///////////////////////////////
+	// The same positions in two books, on the 21 x 11 x 5 spot / vol / time stress grid
+	vector<Position> positions;
+	for (size_t i = 0; i < portfolio.size(); ++i)
+	{
+		positions.push_back(Position{ portfolio[i], 1.0, (i < 9) ? "Chooser and barrier" : "Flow" });
+	}
+
+	ScenarioEngine scenarios;
+	ScenarioReport report = scenarios.Run(positions, ScenarioGrid());
+
+	for (size_t i = 0; i < report.Books.size(); ++i)
+	{
+		cout << report.Books[i] << " book, worst and best scenario P&L: \t" << setprecision(6)
+			<< report.BookValues[i].Min() - report.BookBase[i] << "\t" << report.BookValues[i].Max() - report.BookBase[i] << endl;
+	}
+	cout << "\n";
+
+	////////////////////////////		Historical VaR		///////////////////////////////
+	// A year of synthetic daily moves: 1.5% spot returns, vol against spot, small rate moves
+	vector<MarketMove> history(250);
+	PhiloxStream draws(2024, 0);
+	for (size_t d = 0; d < history.size(); ++d)
+	{
+		double ret = 0.015 * draws.Normal();
+		history[d] = MarketMove{ "day " + to_string(d + 1), ret, -0.5 * ret + 0.003 * draws.Normal(), 0.0005 * draws.Normal() };
+	}
+
+	HistoricalVaR var;
+	VaRReport risk = var.Run(positions, history, { 0.95, 0.99 });
+	for (const RiskMeasure& measure : risk.Measures)
+	{
+		cout << "Historical VaR and ES at " << setprecision(2) << 100.0 * measure.Confidence << "%: \t" << setprecision(6)
+			<< measure.VaR << "\t" << measure.ExpectedShortfall << endl;
+	}
+	cout << "\n";
+
+	////////////////////////////		Tick repricing		///////////////////////////////
+	// option_14 on a few ticks around its spot: small moves come from the cached Greeks, the last one reprices in full
+	TickRepricer ticks(option_14);
+	for (double tick : { 1.0001, 0.9998, 1.0005, 1.03 })
+	{
+		double spot = option_14.S * tick;
+		cout << "Tick to " << setprecision(8) << spot << ": \t" << setprecision(10) << ticks.Tick(spot) << endl;
+	}
+	cout << "Ticks answered from the cache: " << ticks.Hits() << ", full valuations: " << ticks.FullValuations() << endl;
+	cout << "\n";
+
+
+	////////////////////////////		Pricing proxies		///////////////////////////////
+	// option_9 (up-and-out call) over spots below its barrier and vols around its own, against the exact price
+	ProxyBox box;
+	box.Spot = ChebyshevAxis(85.0, 104.5, 24);
+	box.Vol = ChebyshevAxis(0.2, 0.3, 12);
+	ChebyshevProxy proxy(option_9, box);
+	cout << "Proxy coefficients: " << proxy.Coefficients() << ", error bound: " << scientific << setprecision(2) << proxy.ErrorBound() << defaultfloat << endl;
+	for (double spot : { 90.0, 100.0, 104.0 })
+	{
+		cout << "S = " << spot << ", sig = 0.27: \tproxy " << setprecision(10) << proxy.Price(spot, 0.27, T_2, r_2)
+			<< ", exact " << proxy.ExactPrice(spot, 0.27, T_2, r_2) << endl;
+	}
+	cout << "\n";
+
+
+}
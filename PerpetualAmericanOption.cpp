@@ -1,131 +1,123 @@
-// Implementing the class that is defined in the header file: PerpetualAmericanOption.hpp
-//
-// (c) Sudhansh Dua
-
-
-#include "PerpetualAmericanOption.hpp"
-#include <string>
-#include <boost/math/distributions.hpp>
-#include <cmath>
-#include <vector>
-
-
-using namespace std;
-using namespace boost::math;
-
-
-double PerpetualAmericanOption::CallPrice() const
-{
-	return ::PerpetualCall(S, K, r, sig, b);
-}
-
-double PerpetualAmericanOption::PutPrice() const
-{
-	return ::PerpetualPut(S, K, r, sig, b);
-}
-
-void PerpetualAmericanOption::init()		// Initialising all the default values
-{
-	//	Default values
-	r = 0.03;
-	sig = 0.2;
-	K = 105;
-	S = 100;				//	Default stock price 
-	b = r;					//	Black - Scholes(1973) stock option model : b = r
-
-	type = "C";				//	Call option as the default
-}
-
-void PerpetualAmericanOption::copy(const PerpetualAmericanOption& option)
-{
-	r = option.r;
-	sig = option.sig;
-	K = option.K;
-	b = option.b;
-	type = option.type;
-	S = option.S;
-}
-
-
-//	Constructors and destructor
-//	Default Constructor
-PerpetualAmericanOption::PerpetualAmericanOption() : Option()
-{
-	init();
-}
-
-//	Copy constructor
-PerpetualAmericanOption::PerpetualAmericanOption(const PerpetualAmericanOption& option) : Option(option)
-{
-	copy(option);
-}
-
-//	Constructor that accepts values
-PerpetualAmericanOption::PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
-	const double& sig1, const double& b1, const string type1) : Option(), S(S1), K(K1), r(r1), sig(sig1), b(b1), type(type1) {}
-
-//	Destructor
-PerpetualAmericanOption::~PerpetualAmericanOption() {}
-
-
-//	Assignment Operator
-PerpetualAmericanOption& PerpetualAmericanOption::operator = (const PerpetualAmericanOption& option)
-{
-	if (this == &option)
-	{
-		return *this;		//	Self-assignment check!
-	}
-	Option::operator = (option);
-	copy(option);
-	return *this;
-}
-
-
-// Functions that calculate the option price
-double PerpetualAmericanOption::Price() const
-{
-	if (type == "C")
-	{
-		return CallPrice();
-	}
-	else
-	{
-		return PutPrice();
-	}
-}
-
-
-// Modifier functions
-void PerpetualAmericanOption::toggle()				//	Change the option type
-{
-	type = ((type == "C") ? "P" : "C");
-}
-
-// Global functions
-double PerpetualCall(const double S, const double K, const double r, const double sig, const double b)
-{
-	double y1 = 0.5 - (b / (sig * sig)) + sqrt(pow(((b / (sig * sig)) - 0.5), 2) + (2 * r / (sig * sig)));
-
-	if (y1 == 1.0)
-	{
-		return S;
-	}
-	double C = (K / (y1 - 1)) * pow(((y1 - 1) / y1) * (S / K), y1);
-
-	return C;
-}
-
-
-double PerpetualPut(const double S, const double K, const double r, const double sig, const double b)
-{
-	double y2 = 0.5 - (b / (sig * sig)) - sqrt(pow(((b / (sig * sig)) - 0.5), 2) + (2 * r / (sig * sig)));
-
-	if (y2 == 1.0)
-	{
-		return S;
-	}
-	double P = (K / (1 - y2)) * pow(((y2 - 1) / y2) * (S / K), y2);
-
-	return P;
-}
-
+// Implementing the class that is defined in the header file: PerpetualAmericanOption.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "PerpetualAmericanOption.hpp"
+#include <string>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+using namespace std;
+
+
+double PerpetualAmericanOption::CallPrice() const
+{
+	return PerpetualPrice<Call>(S, K, r, sig, b);
+}
+
+double PerpetualAmericanOption::PutPrice() const
+{
+	return PerpetualPrice<Put>(S, K, r, sig, b);
+}
+
+void PerpetualAmericanOption::init()		// Initialising all the default values
+{
+	//	Default values
+	r = 0.03;
+	sig = 0.2;
+	K = 105;
+	S = 100;				//	Default stock price 
+	b = r;					//	Black - Scholes(1973) stock option model : b = r
+	T = numeric_limits<double>::infinity();	//	no expiry
+
+	type = OptionType::Call;				//	Call option as the default
+}
+
+
+//	Constructors and destructor
+//	Default Constructor
+PerpetualAmericanOption::PerpetualAmericanOption() : Option()
+{
+	init();
+}
+
+//	Copy constructor
+PerpetualAmericanOption::PerpetualAmericanOption(const PerpetualAmericanOption& option) : Option(option) {}
+
+//	Constructor that accepts values
+PerpetualAmericanOption::PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
+	const double& sig1, const double& b1, const OptionType type1) : Option(S1, K1, numeric_limits<double>::infinity(), r1, sig1, b1, type1) {}
+
+//	Constructor that parses the option type from a string
+PerpetualAmericanOption::PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
+	const double& sig1, const double& b1, const string& type1)
+	: PerpetualAmericanOption(S1, K1, r1, sig1, b1, ParseOptionType(type1)) {}
+
+//	Destructor
+PerpetualAmericanOption::~PerpetualAmericanOption() {}
+
+
+//	Assignment Operator
+PerpetualAmericanOption& PerpetualAmericanOption::operator = (const PerpetualAmericanOption& option)
+{
+	if (this == &option)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	Option::operator = (option);
+	return *this;
+}
+
+
+// Functions that calculate the option price
+double PerpetualAmericanOption::Price() const
+{
+	if (type == OptionType::Call)
+	{
+		return CallPrice();
+	}
+	else
+	{
+		return PutPrice();
+	}
+}
+
+//	Price and sensitivities in one pass of the kernel on dual numbers (theta is 0: the option never expires)
+OptionGreeks PerpetualAmericanOption::Greeks() const
+{
+	return AutoGreeks([this](const GreeksDual& S1, const GreeksDual&, const GreeksDual& r1, const GreeksDual& sig1, const GreeksDual& b1)
+	{
+		return (type == OptionType::Call) ? PerpetualPrice<Call>(S1, GreeksDual(K), r1, sig1, b1) : PerpetualPrice<Put>(S1, GreeksDual(K), r1, sig1, b1);
+	}, S, T, r, sig, b);
+}
+
+
+
+// Modifier functions
+void PerpetualAmericanOption::toggle()				//	Change the option type
+{
+	type = ((type == OptionType::Call) ? OptionType::Put : OptionType::Call);
+}
+
+
+//	Batch kernel: y = 1/2 - b / sig^2 + phi sqrt((b / sig^2 - 1/2)^2 + 2 r / sig^2) and
+//		price = K / (phi (y - 1)) ((y - 1) / y S / K)^y		(S if y = 1)
+OPTION_TARGET_CLONES
+void BatchPerpetualPrice(const double* __restrict S, const double* __restrict K, const double* __restrict r, const double* __restrict sig, const double* __restrict b,
+	const int* __restrict isCall, double* __restrict price, const size_t n)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double var = sig[i] * sig[i];
+		double phi = (isCall[i] != 0) ? 1.0 : -1.0;
+		double m = (b[i] / var) - 0.5;
+		double y = -m + phi * Numerics::FastSqrt((m * m) + (2 * r[i] / var));
+
+		double value = (K[i] / (phi * (y - 1))) * Numerics::FastExp(y * Numerics::FastLog(((y - 1) / y) * (S[i] / K[i])));
+		price[i] = (y == 1.0) ? S[i] : value;
+	}
+}
@@ -1,58 +1,94 @@
-// Class that defines the derived class: Perpetual American Options
-//
-// (c) Sudhansh Dua
-
-
-#ifndef PerpetualAmericanOption_HPP
-#define PerpetualAmericanOption_HPP
-
-
-#include "Option.hpp"
-#include <string>
-using namespace std;
-
-
-class PerpetualAmericanOption : public Option
-{
-private:
-	// 'Kernel' functions for option calculations
-	double CallPrice() const;					//	Price of a call option
-	double PutPrice() const;					//	Price of a put option
-	void init();							// 	Initialise all default values
-	void copy(const PerpetualAmericanOption& option);		//	copies all values
-
-public:
-	//	Member data
-	double r;			//	risk-free interest rate
-	double sig;			//	Volatility
-	double K;			//	Strike Price
-	double S;			//	current stock price
-	double b;			//	Cost of carry
-	string type;			//	"C" - call option, "P" - put option
-
-
-	//	Constructors and the destructor
-	PerpetualAmericanOption();						//	default constructor
-	PerpetualAmericanOption(const PerpetualAmericanOption& option);		//	Copy constructor
-	PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
-		const double& sig1, const double& b1, const string type1);	//	constructor that accepts values
-	~PerpetualAmericanOption();						//	destructor
-
-	//	Assignment operator
-	PerpetualAmericanOption& operator = (const PerpetualAmericanOption& option);
-
-	// Functions that calculate the option price
-	double Price() const;
-
-	// Modifier functions
-	void toggle();					//	Change option type (Call to Put, Put to Call)
-
-};
-
-//	Global Functions
-
-double PerpetualCall(const double S, const double K, const double r, const double sig, const double b);
-double PerpetualPut(const double S, const double K, const double r, const double sig, const double b);
-
-#endif
-
+// Class that defines the derived class: Perpetual American Options
+//
+// (c) Sudhansh Dua
+
+
+#ifndef PerpetualAmericanOption_HPP
+#define PerpetualAmericanOption_HPP
+
+
+#include "Option.hpp"
+#include <string>
+using namespace std;
+
+
+class PerpetualAmericanOption : public Option
+{
+private:
+	// 'Kernel' functions for option calculations
+	double CallPrice() const;					//	Price of a call option
+	double PutPrice() const;					//	Price of a put option
+	void init();							// 	Initialise all default values
+
+public:
+	//	Constructors and the destructor
+	PerpetualAmericanOption();						//	default constructor
+	PerpetualAmericanOption(const PerpetualAmericanOption& option);		//	Copy constructor
+	PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
+		const double& sig1, const double& b1, const OptionType type1);	//	constructor that accepts values
+	PerpetualAmericanOption(const double& S1, const double& K1, const double& r1,
+		const double& sig1, const double& b1, const string& type1);	//	"C" - call option, "P" - put option
+	~PerpetualAmericanOption();						//	destructor
+
+	//	Assignment operator
+	PerpetualAmericanOption& operator = (const PerpetualAmericanOption& option);
+
+	// Functions that calculate the option price
+	double Price() const;
+	OptionGreeks Greeks() const;		//	Price and sensitivities by automatic differentiation
+
+	// Modifier functions
+	void toggle();					//	Change option type (Call to Put, Put to Call)
+
+};
+
+//	Global Functions
+
+template <class Real>
+inline Real PerpetualCall(const Real& S, const Real& K, const Real& r, const Real& sig, const Real& b)
+{
+	Real y1 = 0.5 - (b / (sig * sig)) + sqrt(pow(((b / (sig * sig)) - 0.5), 2) + (2 * r / (sig * sig)));
+
+	if (y1 == 1.0)
+	{
+		return S;
+	}
+	Real C = (K / (y1 - 1)) * pow(((y1 - 1) / y1) * (S / K), y1);
+
+	return C;
+}
+
+template <class Real>
+inline Real PerpetualPut(const Real& S, const Real& K, const Real& r, const Real& sig, const Real& b)
+{
+	Real y2 = 0.5 - (b / (sig * sig)) - sqrt(pow(((b / (sig * sig)) - 0.5), 2) + (2 * r / (sig * sig)));
+
+	if (y2 == 1.0)
+	{
+		return S;
+	}
+	Real P = (K / (1 - y2)) * pow(((y2 - 1) / y2) * (S / K), y2);
+
+	return P;
+}
+
+//	Compile-time kernel: PerpetualPrice<Call> or PerpetualPrice<Put>
+template <class Type, class Real>
+inline Real PerpetualPrice(const Real& S, const Real& K, const Real& r, const Real& sig, const Real& b)
+{
+	if constexpr (Type::type == OptionType::Call)
+	{
+		return PerpetualCall(S, K, r, sig, b);
+	}
+	else
+	{
+		return PerpetualPut(S, K, r, sig, b);
+	}
+}
+
+//	Batch form with structure-of-arrays inputs (see BatchPrice in Option.hpp): isCall[i] is non-zero for a call. The loop is vectorised (the
+//	power is taken as exp(y log x)) and agrees with PerpetualPrice to within 1e-12 relative.
+void BatchPerpetualPrice(const double* S, const double* K, const double* r, const double* sig, const double* b, const int* isCall,
+	double* price, const size_t n);
+
+#endif
@@ -0,0 +1,400 @@
+// Implementing the functions that are defined in the header file: PortfolioCsv.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "PortfolioCsv.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+using namespace std;
+
+
+//	Columns of a line
+enum CsvField { TradeIdField, ProductField, TypeField, BarrierField, QuantityField, SField, KField, K2Field, HField, CashField,
+	TField, tField, rField, sigField, bField, CsvFields };
+
+
+//	Input mapped read-only for the duration of a read
+class MappedText
+{
+private:
+	void* data;
+	size_t bytes;
+
+public:
+	explicit MappedText(const string& file) : data(nullptr), bytes(0)
+	{
+		int fd = open(file.c_str(), O_RDONLY);
+		struct stat status;
+		if (fd < 0 || fstat(fd, &status) != 0)
+		{
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+			throw runtime_error("ReadPortfolioCsv: cannot open " + file);
+		}
+
+		bytes = static_cast<size_t>(status.st_size);
+		if (bytes > 0)
+		{
+			void* mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped == MAP_FAILED)
+			{
+				close(fd);
+				throw runtime_error("ReadPortfolioCsv: cannot map " + file);
+			}
+			data = mapped;
+			madvise(data, bytes, MADV_SEQUENTIAL);
+		}
+		close(fd);
+	}
+	MappedText(const MappedText& text) = delete;
+	~MappedText()
+	{
+		if (data != nullptr)
+		{
+			munmap(data, bytes);
+		}
+	}
+
+	MappedText& operator = (const MappedText& text) = delete;
+
+	const char* Begin() const { return static_cast<const char*>(data); }
+	const char* End() const { return static_cast<const char*>(data) + bytes; }
+};
+
+
+//	A field of a line, [begin, end) without surrounding blanks
+struct CsvRange
+{
+	const char* begin;
+	const char* end;
+
+	bool Is(const char* text) const
+	{
+		const size_t n = strlen(text);
+		return static_cast<size_t>(end - begin) == n && memcmp(begin, text, n) == 0;
+	}
+};
+
+static CsvRange Trim(const char* begin, const char* end)
+{
+	while (begin < end && (*begin == ' ' || *begin == '\t'))
+	{
+		++begin;
+	}
+	while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+	{
+		--end;
+	}
+	return CsvRange{ begin, end };
+}
+
+//	Parses a number filling a whole field; false if it is not a number
+template <class T>
+static bool ParseNumber(const CsvRange& field, T& value)
+{
+	from_chars_result result = from_chars(field.begin, field.end, value);
+	return result.ec == errc() && result.ptr == field.end && field.begin != field.end;
+}
+
+
+//	Parses the lines of [begin, end), which starts at the beginning of a line, into the partitions of the store.
+//	A malformed line throws runtime_error; its number is counted from the start of the file on that path only.
+static void ParseChunk(const char* file, const char* begin, const char* end, const string& path, PortfolioStore& store)
+{
+	CsvRange fields[CsvFields];
+
+	for (const char* line = begin; line < end; )
+	{
+		const char* next = static_cast<const char*>(memchr(line, '\n', end - line));
+		const char* lineEnd = (next == nullptr) ? end : next;
+		const CsvRange whole = Trim(line, lineEnd);
+
+		auto fail = [file, line, &path](const string& reason)
+		{
+			const size_t number = 1 + count(file, line, '\n');
+			return runtime_error("ReadPortfolioCsv: " + path + ", line " + to_string(number) + ": " + reason);
+		};
+
+		if (whole.begin == whole.end || *whole.begin == '#' || (whole.end - whole.begin >= 8 && memcmp(whole.begin, "trade_id", 8) == 0))
+		{
+			line = lineEnd + 1;
+			continue;
+		}
+
+		size_t n = 0;
+		const char* start = line;
+		for (const char* c = line; ; ++c)
+		{
+			if (c == lineEnd || *c == ',')
+			{
+				if (n == CsvFields)
+				{
+					throw fail("expected " + to_string(CsvFields) + " fields");
+				}
+				fields[n++] = Trim(start, c);
+				start = c + 1;
+				if (c == lineEnd)
+				{
+					break;
+				}
+			}
+		}
+		if (n != CsvFields)
+		{
+			throw fail("expected " + to_string(CsvFields) + " fields");
+		}
+
+		//	a field the product needs
+		auto required = [&fields, &fail](const CsvField field, const char* name)
+		{
+			double value = 0.0;
+			if (!ParseNumber(fields[field], value))
+			{
+				throw fail(string("bad ") + name);
+			}
+			return value;
+		};
+
+		size_t k = 0;
+		while (k < StoreKinds && !fields[ProductField].Is(StoreKindName(static_cast<StoreKind>(k))))
+		{
+			++k;
+		}
+		if (k == StoreKinds)
+		{
+			throw fail("unknown product " + string(fields[ProductField].begin, fields[ProductField].end));
+		}
+		const StoreKind kind = static_cast<StoreKind>(k);
+
+		int isCall = 1;
+		if (kind != StoreKind::Chooser)
+		{
+			if (!fields[TypeField].Is("C") && !fields[TypeField].Is("P"))
+			{
+				throw fail("type must be C or P");
+			}
+			isCall = fields[TypeField].Is("C") ? 1 : 0;
+		}
+
+		uint64_t tradeId = 0;
+		if (!ParseNumber(fields[TradeIdField], tradeId))
+		{
+			throw fail("bad trade_id");
+		}
+
+		const double quantity = required(QuantityField, "quantity");
+		const double S = required(SField, "S"), K = required(KField, "K"), r = required(rField, "r"), sig = required(sigField, "sig"),
+			b = required(bField, "b");
+
+		//	Terms of the kind, checked before the row is appended
+		double T = 0.0, K2 = 0.0, H = 0.0, cr = 0.0, t = 0.0;
+		int isOut = 0;
+		if (kind != StoreKind::Perpetual)
+		{
+			T = required(TField, "T");
+		}
+		switch (kind)
+		{
+		case StoreKind::Barrier:
+			if (!fields[BarrierField].Is("In") && !fields[BarrierField].Is("Out"))
+			{
+				throw fail("barrier must be In or Out");
+			}
+			isOut = fields[BarrierField].Is("Out") ? 1 : 0;
+			H = required(HField, "H");
+			cr = required(CashField, "cash");
+			break;
+		case StoreKind::CashOrNothing:
+			cr = required(CashField, "cash");
+			break;
+		case StoreKind::Gap:
+			K2 = required(K2Field, "K2");
+			break;
+		case StoreKind::Chooser:
+			t = required(tField, "t");
+			break;
+		default:
+			break;
+		}
+
+		StorePartition& p = store.Partition(kind);
+		p.S.push_back(S);
+		p.K.push_back(K);
+		p.r.push_back(r);
+		p.sig.push_back(sig);
+		p.b.push_back(b);
+		p.Quantity.push_back(quantity);
+		p.TradeId.push_back(tradeId);
+		if (kind != StoreKind::Perpetual)
+		{
+			p.T.push_back(T);
+		}
+		if (kind != StoreKind::Chooser)
+		{
+			p.isCall.push_back(isCall);
+		}
+		switch (kind)
+		{
+		case StoreKind::Barrier:
+			p.H.push_back(H);
+			p.cr.push_back(cr);
+			p.isOut.push_back(isOut);
+			break;
+		case StoreKind::CashOrNothing:
+			p.cr.push_back(cr);
+			break;
+		case StoreKind::Gap:
+			p.K2.push_back(K2);
+			break;
+		case StoreKind::Chooser:
+			p.t.push_back(t);
+			break;
+		default:
+			break;
+		}
+
+		line = lineEnd + 1;
+	}
+}
+
+
+PortfolioStore ReadPortfolioCsv(const string& file)
+{
+	ThreadPool pool;
+	return ReadPortfolioCsv(file, pool);
+}
+
+PortfolioStore ReadPortfolioCsv(const string& file, ThreadPool& pool)
+{
+	MappedText text(file);
+	const char* begin = text.Begin();
+	const char* end = text.End();
+	const size_t bytes = end - begin;
+
+	//	Chunks of at least CsvChunkBytes, a few per thread, each ending after a line end
+	const size_t target = max(CsvChunkBytes, bytes / (4 * max<size_t>(1, pool.Size())) + 1);
+	vector<const char*> bounds(1, begin);
+	while (bounds.back() < end)
+	{
+		const char* cut = (static_cast<size_t>(end - bounds.back()) <= target) ? end : bounds.back() + target;
+		if (cut < end)
+		{
+			const char* next = static_cast<const char*>(memchr(cut, '\n', end - cut));
+			cut = (next == nullptr) ? end : next + 1;
+		}
+		bounds.push_back(cut);
+	}
+
+	const size_t chunks = bounds.size() - 1;
+	if (chunks <= 1)
+	{
+		PortfolioStore store;
+		if (chunks == 1)
+		{
+			ParseChunk(begin, begin, end, file, store);
+		}
+		return store;
+	}
+
+	//	One store per chunk, appended in file order, so rows keep the order of the file
+	vector<PortfolioStore> parts(chunks);
+	pool.ParallelFor(chunks, 1, [&](size_t first, size_t last)
+	{
+		for (size_t c = first; c < last; ++c)
+		{
+			ParseChunk(begin, bounds[c], bounds[c + 1], file, parts[c]);
+		}
+	});
+
+	PortfolioStore store;
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		size_t rows = 0;
+		for (const PortfolioStore& part : parts)
+		{
+			rows += part.Partition(static_cast<StoreKind>(k)).Size();
+		}
+		store.Partition(static_cast<StoreKind>(k)).Reserve(rows);
+	}
+	for (const PortfolioStore& part : parts)
+	{
+		store.Append(part);
+	}
+	return store;
+}
+
+
+void WritePortfolioCsv(const PortfolioStore& store, const string& file)
+{
+	ofstream out(file);
+	if (!out)
+	{
+		throw runtime_error("WritePortfolioCsv: cannot open " + file);
+	}
+
+	out << "trade_id,product,type,barrier,quantity,S,K,K2,H,cash,T,t,r,sig,b\n" << setprecision(numeric_limits<double>::max_digits10);
+
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		const StoreKind kind = static_cast<StoreKind>(k);
+		const StorePartition& p = store.Partition(kind);
+
+		//	the value of a column the kind uses, nothing otherwise
+		auto field = [&out](const DoubleColumn& column, const size_t i)
+		{
+			out << ',';
+			if (!column.empty())
+			{
+				out << column[i];
+			}
+		};
+
+		for (size_t i = 0; i < p.Size(); ++i)
+		{
+			out << p.TradeId[i] << ',' << StoreKindName(kind) << ',';
+			if (kind != StoreKind::Chooser)
+			{
+				out << (p.isCall[i] ? "C" : "P");
+			}
+			out << ',';
+			if (kind == StoreKind::Barrier)
+			{
+				out << (p.isOut[i] ? "Out" : "In");
+			}
+			out << ',' << p.Quantity[i];
+
+			field(p.S, i);
+			field(p.K, i);
+			field(p.K2, i);
+			field(p.H, i);
+			field(p.cr, i);
+			field(p.T, i);
+			field(p.t, i);
+			field(p.r, i);
+			field(p.sig, i);
+			field(p.b, i);
+			out << '\n';
+		}
+	}
+
+	if (!out)
+	{
+		throw runtime_error("WritePortfolioCsv: cannot write " + file);
+	}
+}
@@ -0,0 +1,38 @@
+// Reading and writing a book of positions as CSV
+//
+// (c) Sudhansh Dua
+//
+//	One position per line, with a column header first:
+//		trade_id,product,type,barrier,quantity,S,K,K2,H,cash,T,t,r,sig,b
+//	product is a StoreKind name (StoreKindName: vanilla, barrier, digital, cash-or-nothing, ...), type is C or P (empty
+//	for a chooser) and barrier is In or Out (barrier options only). K2 is the payoff strike of a gap, H the barrier,
+//	cash the rebate of a barrier or the payout of a cash-or-nothing, T is empty for a perpetual and t is the choice
+//	date of a chooser. Fields a product does not use are left empty and ignored.
+
+
+#ifndef PortfolioCsv_HPP
+#define PortfolioCsv_HPP
+
+
+#include "PortfolioStore.hpp"
+#include "ThreadPool.hpp"
+#include <string>
+using namespace std;
+
+
+//	Reads a book into a columnar store. Blank lines and lines starting with '#' are skipped, and so is the column
+//	header. Throws runtime_error if the file cannot be opened or a line is malformed, naming the line.
+//
+//	The file is mapped into memory and cut at line ends into chunks of at least CsvChunkBytes, a few per thread of
+//	the pool (one per hardware thread by default), which are parsed in parallel. Numbers are read in place by
+//	from_chars and each row is appended straight to the columns of its partition: no string per field and no
+//	option object per row. The rows of each partition keep the order of the file.
+const size_t CsvChunkBytes = 1 << 22;
+PortfolioStore ReadPortfolioCsv(const string& file);
+PortfolioStore ReadPortfolioCsv(const string& file, ThreadPool& pool);
+
+//	Writes every position of the store, partition by partition, with enough digits to read back the same doubles
+void WritePortfolioCsv(const PortfolioStore& store, const string& file);
+
+
+#endif
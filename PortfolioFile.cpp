@@ -0,0 +1,405 @@
+// Implementing the class and functions that are defined in the header file: PortfolioFile.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "PortfolioFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+using namespace std;
+
+
+//	Layout
+
+uint32_t PortfolioFileColumns(const StoreKind kind)
+{
+	auto bit = [](const PortfolioColumn column) { return 1u << static_cast<uint32_t>(column); };
+
+	uint32_t columns = bit(PortfolioColumn::S) | bit(PortfolioColumn::K) | bit(PortfolioColumn::r) | bit(PortfolioColumn::sig)
+		| bit(PortfolioColumn::b) | bit(PortfolioColumn::Quantity) | bit(PortfolioColumn::TradeId);
+	if (kind != StoreKind::Perpetual)
+	{
+		columns |= bit(PortfolioColumn::T);
+	}
+	if (kind != StoreKind::Chooser)
+	{
+		columns |= bit(PortfolioColumn::isCall);
+	}
+
+	switch (kind)
+	{
+	case StoreKind::Barrier:
+		columns |= bit(PortfolioColumn::H) | bit(PortfolioColumn::cr) | bit(PortfolioColumn::isOut);
+		break;
+	case StoreKind::CashOrNothing:
+		columns |= bit(PortfolioColumn::cr);
+		break;
+	case StoreKind::Gap:
+		columns |= bit(PortfolioColumn::K2);
+		break;
+	case StoreKind::Chooser:
+		columns |= bit(PortfolioColumn::t);
+		break;
+	default:
+		break;
+	}
+	return columns;
+}
+
+//	Bytes per row of a column
+static size_t Width(const size_t column)
+{
+	const PortfolioColumn c = static_cast<PortfolioColumn>(column);
+	return (c == PortfolioColumn::isCall || c == PortfolioColumn::isOut) ? sizeof(int) : sizeof(double);
+}
+
+//	Bytes rounded up to the next alignment boundary
+static uint64_t Padded(const uint64_t bytes)
+{
+	return (bytes + PortfolioFileAlignment - 1) / PortfolioFileAlignment * PortfolioFileAlignment;
+}
+
+//	Bytes of a section of rows rows with the given columns
+static uint64_t SectionBytes(const uint32_t columns, const uint64_t rows)
+{
+	uint64_t bytes = 0;
+	for (size_t c = 0; c < PortfolioColumns; ++c)
+	{
+		if (columns & (1u << c))
+		{
+			bytes += Padded(rows * Width(c));
+		}
+	}
+	return bytes;
+}
+
+
+uint64_t PortfolioChecksum(const void* data, const size_t bytes, uint64_t hash)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, p + i, sizeof(word));
+		hash = (hash ^ word) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+//	Checksum of the header, with its Checksum field zero, and of the section table
+static uint64_t HeaderChecksum(const PortfolioFileHeader& header, const PortfolioFileSection* sections)
+{
+	PortfolioFileHeader copy = header;
+	copy.Checksum = 0;
+	uint64_t hash = PortfolioChecksum(&copy, sizeof(copy));
+	return PortfolioChecksum(sections, header.Sections * sizeof(PortfolioFileSection), hash);
+}
+
+
+//	Writing
+
+//	Column c of a partition, and its number of rows
+static const void* ColumnData(const StorePartition& p, const size_t column, size_t& rows)
+{
+	const DoubleColumn* doubles[] = { &p.S, &p.K, &p.T, &p.r, &p.sig, &p.b, &p.K2, &p.H, &p.cr, &p.t };
+
+	switch (static_cast<PortfolioColumn>(column))
+	{
+	case PortfolioColumn::isCall:
+		rows = p.isCall.size();
+		return p.isCall.data();
+	case PortfolioColumn::isOut:
+		rows = p.isOut.size();
+		return p.isOut.data();
+	case PortfolioColumn::Quantity:
+		rows = p.Quantity.size();
+		return p.Quantity.data();
+	case PortfolioColumn::TradeId:
+		rows = p.TradeId.size();
+		return p.TradeId.data();
+	default:
+		rows = doubles[column]->size();
+		return doubles[column]->data();
+	}
+}
+
+
+void WritePortfolioFile(const PortfolioStore& store, const string& file)
+{
+	PortfolioFileHeader header = {};
+	memcpy(header.Magic, PortfolioFileMagic, sizeof(header.Magic));
+	header.Version = PortfolioFileVersion;
+	header.Alignment = PortfolioFileAlignment;
+	header.ByteOrder = PortfolioFileByteOrder;
+	header.Sections = StoreKinds;
+	header.HeaderBytes = sizeof(PortfolioFileHeader) + StoreKinds * sizeof(PortfolioFileSection);
+
+	//	Section table and checksums: a column is hashed with its padding, the partial last block through a zeroed copy
+	PortfolioFileSection sections[StoreKinds] = {};
+	uint64_t offset = Padded(header.HeaderBytes);
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		const StoreKind kind = static_cast<StoreKind>(k);
+		const StorePartition& p = store.Partition(kind);
+		PortfolioFileSection& section = sections[k];
+
+		section.Kind = static_cast<uint32_t>(k);
+		section.Columns = PortfolioFileColumns(kind);
+		section.Rows = p.Size();
+		section.Offset = offset;
+		section.Bytes = SectionBytes(section.Columns, section.Rows);
+		section.Checksum = PortfolioChecksumSeed;
+
+		for (size_t c = 0; c < PortfolioColumns; ++c)
+		{
+			if (!(section.Columns & (1u << c)))
+			{
+				continue;
+			}
+
+			size_t rows = 0;
+			const unsigned char* column = static_cast<const unsigned char*>(ColumnData(p, c, rows));
+			if (rows != section.Rows)
+			{
+				throw invalid_argument(string("WritePortfolioFile: a column of the ") + StoreKindName(kind)
+					+ " partition does not have one row per position");
+			}
+
+			const size_t bytes = rows * Width(c);
+			const size_t whole = bytes / PortfolioFileAlignment * PortfolioFileAlignment;
+			section.Checksum = PortfolioChecksum(column, whole, section.Checksum);
+			if (whole < bytes)
+			{
+				unsigned char last[PortfolioFileAlignment] = {};
+				memcpy(last, column + whole, bytes - whole);
+				section.Checksum = PortfolioChecksum(last, sizeof(last), section.Checksum);
+			}
+		}
+
+		header.Positions += section.Rows;
+		offset += section.Bytes;
+	}
+	header.FileBytes = offset;
+	header.Checksum = HeaderChecksum(header, sections);
+
+	//	Written next to the target and renamed over it, so that a service mapping the old file keeps a consistent view
+	const string temporary = file + ".tmp";
+	{
+		ofstream out(temporary, ios::binary | ios::trunc);
+		if (!out)
+		{
+			throw runtime_error("WritePortfolioFile: cannot open " + temporary);
+		}
+
+		const char zeros[PortfolioFileAlignment] = {};
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+		out.write(zeros, Padded(header.HeaderBytes) - header.HeaderBytes);
+
+		for (size_t k = 0; k < StoreKinds; ++k)
+		{
+			const StorePartition& p = store.Partition(static_cast<StoreKind>(k));
+			for (size_t c = 0; c < PortfolioColumns; ++c)
+			{
+				if (sections[k].Columns & (1u << c))
+				{
+					size_t rows = 0;
+					const char* column = static_cast<const char*>(ColumnData(p, c, rows));
+					const size_t bytes = rows * Width(c);
+					out.write(column, bytes);
+					out.write(zeros, Padded(bytes) - bytes);
+				}
+			}
+		}
+
+		if (!out.flush())
+		{
+			throw runtime_error("WritePortfolioFile: cannot write " + temporary);
+		}
+	}
+
+	if (rename(temporary.c_str(), file.c_str()) != 0)
+	{
+		remove(temporary.c_str());
+		throw runtime_error("WritePortfolioFile: cannot replace " + file);
+	}
+}
+
+
+//	MappedPortfolio
+
+//	Constructors and destructor
+MappedPortfolio::MappedPortfolio(const string& file) : data(nullptr), bytes(0), header(nullptr), sections(nullptr), views()
+{
+	auto fail = [this, &file](const string& reason)
+	{
+		if (data != nullptr)
+		{
+			munmap(data, bytes);
+			data = nullptr;
+		}
+		return runtime_error("MappedPortfolio: " + file + ": " + reason);
+	};
+
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw fail("cannot open");
+	}
+
+	struct stat status;
+	if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(PortfolioFileHeader)))
+	{
+		close(fd);
+		throw fail("too short for a header");
+	}
+
+	bytes = static_cast<size_t>(status.st_size);
+	void* mapped = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		throw fail("cannot map");
+	}
+	data = mapped;
+
+	//	Header
+	const unsigned char* base = static_cast<const unsigned char*>(data);
+	header = reinterpret_cast<const PortfolioFileHeader*>(base);
+
+	if (memcmp(header->Magic, PortfolioFileMagic, sizeof(header->Magic)) != 0)
+	{
+		throw fail("not a portfolio file");
+	}
+	if (header->ByteOrder != PortfolioFileByteOrder)
+	{
+		throw fail("written with another byte order");
+	}
+	if (header->Version != PortfolioFileVersion)
+	{
+		throw fail("version " + to_string(header->Version) + ", this reader opens version " + to_string(PortfolioFileVersion));
+	}
+	if (header->Alignment != PortfolioFileAlignment || header->Sections != StoreKinds
+		|| header->HeaderBytes != sizeof(PortfolioFileHeader) + StoreKinds * sizeof(PortfolioFileSection) || header->HeaderBytes > bytes)
+	{
+		throw fail("unexpected layout");
+	}
+	if (header->FileBytes != bytes)
+	{
+		throw fail("truncated or extended: " + to_string(bytes) + " bytes, the header says " + to_string(header->FileBytes));
+	}
+
+	sections = reinterpret_cast<const PortfolioFileSection*>(base + sizeof(PortfolioFileHeader));
+	if (HeaderChecksum(*header, sections) != header->Checksum)
+	{
+		throw fail("header checksum mismatch");
+	}
+
+	//	Sections
+	uint64_t positions = 0;
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		const StoreKind kind = static_cast<StoreKind>(k);
+		const PortfolioFileSection& section = sections[k];
+		const string name = StoreKindName(kind);
+
+		if (section.Kind != k || section.Columns != PortfolioFileColumns(kind))
+		{
+			throw fail("section " + to_string(k) + " is not the " + name + " section");
+		}
+		if (section.Rows > bytes || section.Bytes != SectionBytes(section.Columns, section.Rows))
+		{
+			throw fail(name + " section: size does not match its rows");
+		}
+		if (section.Offset % PortfolioFileAlignment != 0 || section.Offset < header->HeaderBytes || section.Offset > bytes
+			|| section.Bytes > bytes - section.Offset)
+		{
+			throw fail(name + " section: out of bounds or misaligned");
+		}
+		positions += section.Rows;
+
+		const double* columns[PortfolioColumns] = {};
+		const unsigned char* column = base + section.Offset;
+		for (size_t c = 0; c < PortfolioColumns; ++c)
+		{
+			if (section.Columns & (1u << c))
+			{
+				columns[c] = reinterpret_cast<const double*>(column);
+				column += Padded(section.Rows * Width(c));
+			}
+		}
+
+		PartitionView& view = views[k];
+		view.Kind = kind;
+		view.Rows = section.Rows;
+		view.S = columns[static_cast<size_t>(PortfolioColumn::S)];
+		view.K = columns[static_cast<size_t>(PortfolioColumn::K)];
+		view.T = columns[static_cast<size_t>(PortfolioColumn::T)];
+		view.r = columns[static_cast<size_t>(PortfolioColumn::r)];
+		view.sig = columns[static_cast<size_t>(PortfolioColumn::sig)];
+		view.b = columns[static_cast<size_t>(PortfolioColumn::b)];
+		view.K2 = columns[static_cast<size_t>(PortfolioColumn::K2)];
+		view.H = columns[static_cast<size_t>(PortfolioColumn::H)];
+		view.cr = columns[static_cast<size_t>(PortfolioColumn::cr)];
+		view.t = columns[static_cast<size_t>(PortfolioColumn::t)];
+		view.isCall = reinterpret_cast<const int*>(columns[static_cast<size_t>(PortfolioColumn::isCall)]);
+		view.isOut = reinterpret_cast<const int*>(columns[static_cast<size_t>(PortfolioColumn::isOut)]);
+		view.Quantity = columns[static_cast<size_t>(PortfolioColumn::Quantity)];
+		view.TradeId = reinterpret_cast<const uint64_t*>(columns[static_cast<size_t>(PortfolioColumn::TradeId)]);
+	}
+
+	if (positions != header->Positions)
+	{
+		throw fail("the sections do not add up to the positions of the header");
+	}
+}
+
+MappedPortfolio::~MappedPortfolio()
+{
+	if (data != nullptr)
+	{
+		munmap(data, bytes);
+	}
+}
+
+
+const PortfolioFileHeader& MappedPortfolio::Header() const
+{
+	return *header;
+}
+
+const PortfolioFileSection& MappedPortfolio::Section(const StoreKind kind) const
+{
+	return sections[static_cast<size_t>(kind)];
+}
+
+
+const PartitionView& MappedPortfolio::Partition(const StoreKind kind) const
+{
+	return views[static_cast<size_t>(kind)];
+}
+
+vector<PartitionView> MappedPortfolio::Views() const
+{
+	return vector<PartitionView>(views, views + StoreKinds);
+}
+
+size_t MappedPortfolio::Size() const
+{
+	return header->Positions;
+}
+
+
+bool MappedPortfolio::Verify(const StoreKind kind) const
+{
+	const PortfolioFileSection& section = Section(kind);
+	return PortfolioChecksum(static_cast<const unsigned char*>(data) + section.Offset, section.Bytes) == section.Checksum;
+}
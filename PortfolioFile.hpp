@@ -0,0 +1,122 @@
+// Binary portfolio file, mapped into memory and priced in place
+//
+// (c) Sudhansh Dua
+//
+//	The file mirrors the columns of a PortfolioStore, so that a service maps it and prices the pages directly, with
+//	no parsing, no copy and no construction of option objects:
+//
+//		PortfolioFileHeader		64 bytes
+//		PortfolioFileSection	64 bytes per StoreKind, in StoreKind order
+//		sections				each one starting on a PortfolioFileAlignment boundary
+//
+//	A section holds the columns its kind uses (PortfolioFileColumns), in the order of PortfolioColumn, each column
+//	starting on a PortfolioFileAlignment boundary and padded with zeros to the next one. Doubles and trade IDs take 8
+//	bytes, the isCall / isOut flags 4 (int). Everything is little-endian; the ByteOrder field rejects a file written
+//	with another byte order.
+//
+//	The header checksum covers the header (with its Checksum field zero) and the section table, and is checked on
+//	every open. Each section has its own checksum over its bytes, padding included, which MappedPortfolio::Verify
+//	checks on request only: opening a file touches nothing but its first pages. Both are 64-bit FNV-1a over 8-byte
+//	words (PortfolioChecksum).
+//
+//	Versions: a reader opens files of its own PortfolioFileVersion only. Any change of layout bumps the version;
+//	Reserved fields are written as zero.
+
+
+#ifndef PortfolioFile_HPP
+#define PortfolioFile_HPP
+
+
+#include "PortfolioStore.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+const uint32_t PortfolioFileVersion = 1;
+const uint32_t PortfolioFileAlignment = 64;
+const uint64_t PortfolioFileByteOrder = 0x0102030405060708ULL;
+const char PortfolioFileMagic[8] = { 'O', 'P', 'T', 'B', 'O', 'O', 'K', '\0' };
+
+
+struct PortfolioFileHeader
+{
+	char Magic[8];				//	PortfolioFileMagic
+	uint32_t Version;			//	PortfolioFileVersion
+	uint32_t Alignment;			//	PortfolioFileAlignment
+	uint64_t ByteOrder;			//	PortfolioFileByteOrder, as written
+	uint32_t Sections;			//	StoreKinds
+	uint32_t HeaderBytes;		//	header and section table
+	uint64_t Positions;			//	rows in all sections
+	uint64_t FileBytes;
+	uint64_t Checksum;			//	header (this field zero) and section table
+	uint64_t Reserved;
+};
+
+struct PortfolioFileSection
+{
+	uint32_t Kind;				//	StoreKind
+	uint32_t Columns;			//	PortfolioFileColumns(Kind)
+	uint64_t Rows;
+	uint64_t Offset;			//	from the start of the file
+	uint64_t Bytes;				//	columns and their padding
+	uint64_t Checksum;			//	of the Bytes bytes at Offset
+	uint64_t Reserved[3];
+};
+
+static_assert(sizeof(PortfolioFileHeader) == 64, "PortfolioFileHeader must be 64 bytes");
+static_assert(sizeof(PortfolioFileSection) == 64, "PortfolioFileSection must be 64 bytes");
+
+
+//	Columns of a section, in file order
+enum class PortfolioColumn { S, K, T, r, sig, b, K2, H, cr, t, isCall, isOut, Quantity, TradeId };
+const size_t PortfolioColumns = 14;
+
+//	Bit c is set if the kind uses column c (see StorePartition)
+uint32_t PortfolioFileColumns(const StoreKind kind);
+
+//	64-bit FNV-1a over the bytes / 8 words at data (bytes a multiple of 8), continuing from hash
+const uint64_t PortfolioChecksumSeed = 0xcbf29ce484222325ULL;
+uint64_t PortfolioChecksum(const void* data, const size_t bytes, const uint64_t hash = PortfolioChecksumSeed);
+
+
+//	Writes the store to a file. Throws invalid_argument if a partition has a column of the wrong length for its kind
+//	and runtime_error if the file cannot be written.
+void WritePortfolioFile(const PortfolioStore& store, const string& file);
+
+
+//	A portfolio file mapped read-only into memory. Its partitions are views of the mapped pages, priced by
+//	PortfolioPricer like those of a PortfolioStore; they stay valid for the lifetime of the MappedPortfolio.
+class MappedPortfolio
+{
+private:
+	void* data;
+	size_t bytes;
+	const PortfolioFileHeader* header;
+	const PortfolioFileSection* sections;
+	PartitionView views[StoreKinds];
+
+public:
+	//	Maps the file and checks the header, its checksum and the bounds, alignment and columns of every section.
+	//	Throws runtime_error, naming the file and the fault, if any of them is wrong.
+	explicit MappedPortfolio(const string& file);
+	MappedPortfolio(const MappedPortfolio& portfolio) = delete;
+	~MappedPortfolio();
+
+	MappedPortfolio& operator = (const MappedPortfolio& portfolio) = delete;
+
+	const PortfolioFileHeader& Header() const;
+	const PortfolioFileSection& Section(const StoreKind kind) const;
+
+	const PartitionView& Partition(const StoreKind kind) const;
+	vector<PartitionView> Views() const;		//	one per partition, in StoreKind order
+	size_t Size() const;						//	positions in all partitions
+
+	//	Recomputes the checksum of a section (reading all its pages) and compares it with the table
+	bool Verify(const StoreKind kind) const;
+};
+
+
+#endif
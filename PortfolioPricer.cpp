@@ -0,0 +1,120 @@
+// Implementing the class that is defined in the header file: PortfolioPricer.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "PortfolioPricer.hpp"
+#include "PortfolioStore.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+
+using namespace std;
+
+
+double Price(const Product& product)
+{
+	return visit([](const auto& option) { return option.Price(); }, product);
+}
+
+OptionGreeks Greeks(const Product& product)
+{
+	return visit([](const auto& option) { return option.Greeks(); }, product);
+}
+
+
+//	Constructors and destructor
+PortfolioPricer::PortfolioPricer() : pool(), chunk(256) {}
+
+PortfolioPricer::PortfolioPricer(const size_t threads, const size_t chunk1) : pool(threads), chunk(chunk1) {}
+
+PortfolioPricer::~PortfolioPricer() {}
+
+
+size_t PortfolioPricer::Threads() const
+{
+	return pool.Size();
+}
+
+
+void PortfolioPricer::Price(const Product* portfolio, double* prices, const size_t n)
+{
+	pool.ParallelFor(n, chunk, [portfolio, prices](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			prices[i] = ::Price(portfolio[i]);
+		}
+	});
+}
+
+vector<double> PortfolioPricer::Price(const vector<Product>& portfolio)
+{
+	vector<double> prices(portfolio.size());
+	Price(portfolio.data(), prices.data(), portfolio.size());
+	return prices;
+}
+
+
+double PortfolioPricer::Value(const vector<Product>& portfolio, const vector<double>& quantities)
+{
+	if (quantities.size() != portfolio.size())
+	{
+		throw invalid_argument("PortfolioPricer::Value: one quantity per product is required");
+	}
+
+	vector<double> prices = Price(portfolio);
+
+	double value = 0.0;
+	for (size_t i = 0; i < prices.size(); ++i)
+	{
+		value += quantities[i] * prices[i];
+	}
+	return value;
+}
+
+
+void PortfolioPricer::Price(const PartitionView& partition, double* prices)
+{
+	//	whole multiples of 8 rows per task keep every task but the last on aligned rows of the columns
+	const size_t rows = max<size_t>(8, (chunk + 7) / 8 * 8);
+	pool.ParallelFor(partition.Rows, rows, [&partition, prices](size_t begin, size_t end)
+	{
+		partition.Price(begin, end, prices + begin);
+	});
+}
+
+void PortfolioPricer::Price(const PortfolioStore& store, const StoreKind kind, double* prices)
+{
+	Price(store.Partition(kind).View(), prices);
+}
+
+vector<double> PortfolioPricer::Price(const PortfolioStore& store, const StoreKind kind)
+{
+	vector<double> prices(store.Partition(kind).Size());
+	Price(store, kind, prices.data());
+	return prices;
+}
+
+
+double PortfolioPricer::Value(const vector<PartitionView>& partitions)
+{
+	double value = 0.0;
+	vector<double> prices;
+	for (const PartitionView& partition : partitions)
+	{
+		prices.resize(partition.Rows);
+		Price(partition, prices.data());
+
+		for (size_t i = 0; i < prices.size(); ++i)
+		{
+			value += partition.Quantity[i] * prices[i];
+		}
+	}
+	return value;
+}
+
+double PortfolioPricer::Value(const PortfolioStore& store)
+{
+	return Value(store.Views());
+}
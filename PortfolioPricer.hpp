@@ -0,0 +1,94 @@
+// Class that prices a portfolio of options in parallel
+//
+// (c) Sudhansh Dua
+//
+//	A portfolio is a vector of Product, which holds any of the option classes of the library by value. The products
+//	are priced in chunks on a work-stealing thread pool (ThreadPool.hpp). Each price is written to its own slot and
+//	totals are summed in portfolio order, so the results do not depend on the number of threads. A PortfolioStore
+//	holding the same positions column by column is priced partition by partition with the batch kernels.
+
+
+#ifndef PortfolioPricer_HPP
+#define PortfolioPricer_HPP
+
+
+#include "Option.hpp"
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "ChooserOption.hpp"
+#include "BarrierOption.hpp"
+#include "DigitalOption.hpp"
+#include "AssetOrNothingOption.hpp"
+#include "CashOrNothingOption.hpp"
+#include "AsianGeometricOption.hpp"
+#include "GapOption.hpp"
+#include "AmericanApproxOption.hpp"
+#include "ThreadPool.hpp"
+#include <string>
+#include <variant>
+#include <vector>
+using namespace std;
+
+
+class PortfolioStore;
+struct PartitionView;
+enum class StoreKind;
+
+
+typedef variant<Option, EuropeanOption, PerpetualAmericanOption, ChooserOption, BarrierOption, DigitalOption,
+	AssetOrNothingOption, CashOrNothingOption, AsianGeometricOption, GapOption, AmericanApproxOption> Product;
+
+
+//	A holding of a product: the number of contracts (negative if short) and the book it belongs to
+struct Position
+{
+	Product Contract;
+	double Quantity;
+	string Book;
+};
+
+
+//	Price of any product
+double Price(const Product& product);
+
+//	Price and sensitivities of any product (analytic for EuropeanOption, automatic differentiation otherwise)
+OptionGreeks Greeks(const Product& product);
+
+
+class PortfolioPricer
+{
+private:
+	ThreadPool pool;
+	size_t chunk;			//	products per task
+
+public:
+	//	Constructors and destructor
+	PortfolioPricer();													//	one thread per hardware thread, 256 products per task
+	PortfolioPricer(const size_t threads, const size_t chunk1);		//	threads = 0 prices on the calling thread
+	PortfolioPricer(const PortfolioPricer& pricer) = delete;
+	~PortfolioPricer();
+
+	PortfolioPricer& operator = (const PortfolioPricer& pricer) = delete;
+
+	size_t Threads() const;
+
+	//	prices[i] = Price(portfolio[i]) for i = 0 .. n-1
+	void Price(const Product* portfolio, double* prices, const size_t n);
+	vector<double> Price(const vector<Product>& portfolio);
+
+	//	sum of quantities[i] * Price(portfolio[i]), added up in portfolio order
+	double Value(const vector<Product>& portfolio, const vector<double>& quantities);
+
+	//	Prices of the rows of one partition of a columnar store (PortfolioStore.hpp), by its batch kernel, in tasks
+	//	of a multiple of 8 rows
+	void Price(const PartitionView& partition, double* prices);
+	void Price(const PortfolioStore& store, const StoreKind kind, double* prices);
+	vector<double> Price(const PortfolioStore& store, const StoreKind kind);
+
+	//	sum of Quantity * price over the partitions, added up partition by partition in row order
+	double Value(const vector<PartitionView>& partitions);
+	double Value(const PortfolioStore& store);
+};
+
+
+#endif
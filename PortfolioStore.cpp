@@ -0,0 +1,382 @@
+// Implementing the classes that are defined in the header file: PortfolioStore.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "PortfolioStore.hpp"
+#include "ScenarioKernels.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+
+using namespace std;
+
+
+const char* StoreKindName(const StoreKind kind)
+{
+	static const char* const names[StoreKinds] = { "vanilla", "barrier", "digital", "cash-or-nothing", "asset-or-nothing", "gap",
+		"chooser", "asian", "perpetual" };
+	return names[static_cast<size_t>(kind)];
+}
+
+
+//	PartitionView
+void PartitionView::Price(const size_t begin, const size_t end, double* prices) const
+{
+	const size_t n = end - begin;
+	if (end > Rows || begin > end)
+	{
+		throw out_of_range("PartitionView::Price: rows out of range");
+	}
+	if (n == 0)
+	{
+		return;
+	}
+
+	switch (Kind)
+	{
+	case StoreKind::Vanilla:
+		BatchPrice(S + begin, K + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::Barrier:
+		BatchBarrierPrice(S + begin, H + begin, K + begin, cr + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin,
+			isOut + begin, prices, n);
+		break;
+	case StoreKind::Digital:
+		BatchDigitalPrice(S + begin, K + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::CashOrNothing:
+		BatchCashOrNothingPrice(S + begin, K + begin, cr + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::AssetOrNothing:
+		BatchAoNPrice(S + begin, K + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::Gap:
+		BatchGapPrice(S + begin, K + begin, K2 + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::Chooser:
+		BatchChooserPrice(S + begin, K + begin, T + begin, t + begin, r + begin, sig + begin, b + begin, prices, n);
+		break;
+	case StoreKind::Asian:
+		BatchAsianGeometricPrice(S + begin, K + begin, T + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	case StoreKind::Perpetual:
+		BatchPerpetualPrice(S + begin, K + begin, r + begin, sig + begin, b + begin, isCall + begin, prices, n);
+		break;
+	}
+}
+
+
+//	StorePartition
+size_t StorePartition::Size() const
+{
+	return Quantity.size();
+}
+
+void StorePartition::Reserve(const size_t n)
+{
+	S.reserve(n);
+	K.reserve(n);
+	r.reserve(n);
+	sig.reserve(n);
+	b.reserve(n);
+	Quantity.reserve(n);
+	TradeId.reserve(n);
+
+	if (Kind != StoreKind::Perpetual)
+	{
+		T.reserve(n);
+	}
+	if (Kind != StoreKind::Chooser)
+	{
+		isCall.reserve(n);
+	}
+
+	switch (Kind)
+	{
+	case StoreKind::Barrier:
+		H.reserve(n);
+		cr.reserve(n);
+		isOut.reserve(n);
+		break;
+	case StoreKind::CashOrNothing:
+		cr.reserve(n);
+		break;
+	case StoreKind::Gap:
+		K2.reserve(n);
+		break;
+	case StoreKind::Chooser:
+		t.reserve(n);
+		break;
+	default:
+		break;
+	}
+}
+
+void StorePartition::Clear()
+{
+	for (DoubleColumn* column : { &S, &K, &T, &r, &sig, &b, &K2, &H, &cr, &t, &Quantity })
+	{
+		column->clear();
+	}
+	isCall.clear();
+	isOut.clear();
+	TradeId.clear();
+}
+
+
+void StorePartition::Price(const size_t begin, const size_t end, double* prices) const
+{
+	View().Price(begin, end, prices);
+}
+
+
+Product StorePartition::Contract(const size_t i) const
+{
+	if (i >= Size())
+	{
+		throw out_of_range("StorePartition::Contract: row out of range");
+	}
+
+	const OptionType type = (Kind == StoreKind::Chooser || isCall[i] != 0) ? OptionType::Call : OptionType::Put;
+
+	switch (Kind)
+	{
+	case StoreKind::Vanilla:
+		return EuropeanOption(S[i], K[i], T[i], r[i], sig[i], b[i], type);
+	case StoreKind::Barrier:
+		return BarrierOption(S[i], H[i], K[i], cr[i], T[i], r[i], sig[i], b[i], type, (isOut[i] != 0) ? BarrierType::Out : BarrierType::In);
+	case StoreKind::Digital:
+		return DigitalOption(S[i], K[i], T[i], r[i], sig[i], b[i], type);
+	case StoreKind::CashOrNothing:
+		return CashOrNothingOption(S[i], K[i], cr[i], T[i], r[i], sig[i], b[i], type);
+	case StoreKind::AssetOrNothing:
+		return AssetOrNothingOption(S[i], K[i], T[i], r[i], sig[i], b[i], type);
+	case StoreKind::Gap:
+		return GapOption(S[i], K[i], K2[i], T[i], r[i], sig[i], b[i], type);
+	case StoreKind::Chooser:
+		return ChooserOption(S[i], K[i], T[i], t[i], r[i], sig[i], b[i]);
+	case StoreKind::Asian:
+		return AsianGeometricOption(S[i], K[i], T[i], r[i], sig[i], b[i], type);
+	default:
+		return PerpetualAmericanOption(S[i], K[i], r[i], sig[i], b[i], type);
+	}
+}
+
+
+PartitionView StorePartition::View() const
+{
+	//	null for an empty column, so that a view never points into storage the kind does not use
+	auto column = [](const auto& values) { return values.empty() ? nullptr : values.data(); };
+
+	PartitionView view;
+	view.Kind = Kind;
+	view.Rows = Size();
+	view.S = column(S);
+	view.K = column(K);
+	view.T = column(T);
+	view.r = column(r);
+	view.sig = column(sig);
+	view.b = column(b);
+	view.K2 = column(K2);
+	view.H = column(H);
+	view.cr = column(cr);
+	view.t = column(t);
+	view.isCall = column(isCall);
+	view.isOut = column(isOut);
+	view.Quantity = column(Quantity);
+	view.TradeId = column(TradeId);
+	return view;
+}
+
+
+//	PortfolioStore
+
+//	Constructors and destructor
+PortfolioStore::PortfolioStore()
+{
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		partitions[k].Kind = static_cast<StoreKind>(k);
+	}
+}
+
+PortfolioStore::PortfolioStore(const PortfolioStore& store)
+{
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		partitions[k] = store.partitions[k];
+	}
+}
+
+PortfolioStore::~PortfolioStore() {}
+
+PortfolioStore& PortfolioStore::operator = (const PortfolioStore& store)
+{
+	if (this == &store)
+	{
+		return *this;
+	}
+
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		partitions[k] = store.partitions[k];
+	}
+	return *this;
+}
+
+
+void PortfolioStore::Add(const Product& product, const double quantity, const uint64_t tradeId)
+{
+	visit([this, quantity, tradeId](const auto& option)
+	{
+		typedef decay_t<decltype(option)> Kind;
+
+		StoreKind kind = StoreKind::Vanilla;
+		if constexpr (is_same<Kind, BarrierOption>::value)
+		{
+			kind = StoreKind::Barrier;
+		}
+		else if constexpr (is_same<Kind, DigitalOption>::value)
+		{
+			kind = StoreKind::Digital;
+		}
+		else if constexpr (is_same<Kind, CashOrNothingOption>::value)
+		{
+			kind = StoreKind::CashOrNothing;
+		}
+		else if constexpr (is_same<Kind, AssetOrNothingOption>::value)
+		{
+			kind = StoreKind::AssetOrNothing;
+		}
+		else if constexpr (is_same<Kind, GapOption>::value)
+		{
+			kind = StoreKind::Gap;
+		}
+		else if constexpr (is_same<Kind, ChooserOption>::value)
+		{
+			kind = StoreKind::Chooser;
+		}
+		else if constexpr (is_same<Kind, AsianGeometricOption>::value)
+		{
+			kind = StoreKind::Asian;
+		}
+		else if constexpr (is_same<Kind, PerpetualAmericanOption>::value)
+		{
+			kind = StoreKind::Perpetual;
+		}
+		else if constexpr (is_same<Kind, AmericanApproxOption>::value)
+		{
+			throw invalid_argument("PortfolioStore::Add: AmericanApproxOption has no partition");
+		}
+
+		StorePartition& p = partitions[static_cast<size_t>(kind)];
+		p.S.push_back(option.S);
+		p.r.push_back(option.r);
+		p.sig.push_back(option.sig);
+		p.b.push_back(option.b);
+		p.Quantity.push_back(quantity);
+		p.TradeId.push_back(tradeId);
+
+		if constexpr (is_same<Kind, GapOption>::value)
+		{
+			p.K.push_back(option.K1);
+			p.K2.push_back(option.K2);
+		}
+		else
+		{
+			p.K.push_back(option.K);
+		}
+		if constexpr (!is_same<Kind, PerpetualAmericanOption>::value)
+		{
+			p.T.push_back(option.T);
+		}
+		if constexpr (is_same<Kind, ChooserOption>::value)
+		{
+			p.t.push_back(option.t);
+		}
+		else
+		{
+			p.isCall.push_back((option.type == OptionType::Call) ? 1 : 0);
+		}
+		if constexpr (is_same<Kind, BarrierOption>::value)
+		{
+			p.H.push_back(option.H);
+			p.cr.push_back(option.cr);
+			p.isOut.push_back((option.InOrOut == BarrierType::Out) ? 1 : 0);
+		}
+		if constexpr (is_same<Kind, CashOrNothingOption>::value)
+		{
+			p.cr.push_back(option.cr);
+		}
+	}, product);
+}
+
+
+const StorePartition& PortfolioStore::Partition(const StoreKind kind) const
+{
+	return partitions[static_cast<size_t>(kind)];
+}
+
+StorePartition& PortfolioStore::Partition(const StoreKind kind)
+{
+	return partitions[static_cast<size_t>(kind)];
+}
+
+
+size_t PortfolioStore::Size() const
+{
+	size_t n = 0;
+	for (const StorePartition& p : partitions)
+	{
+		n += p.Size();
+	}
+	return n;
+}
+
+void PortfolioStore::Clear()
+{
+	for (StorePartition& p : partitions)
+	{
+		p.Clear();
+	}
+}
+
+
+void PortfolioStore::Append(const PortfolioStore& store)
+{
+	if (this == &store)
+	{
+		PortfolioStore copy(store);
+		Append(copy);
+		return;
+	}
+
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		StorePartition& to = partitions[k];
+		const StorePartition& from = store.partitions[k];
+
+		DoubleColumn StorePartition::* columns[] = { &StorePartition::S, &StorePartition::K, &StorePartition::T, &StorePartition::r,
+			&StorePartition::sig, &StorePartition::b, &StorePartition::K2, &StorePartition::H, &StorePartition::cr, &StorePartition::t,
+			&StorePartition::Quantity };
+		for (DoubleColumn StorePartition::* column : columns)
+		{
+			(to.*column).insert((to.*column).end(), (from.*column).begin(), (from.*column).end());
+		}
+		to.isCall.insert(to.isCall.end(), from.isCall.begin(), from.isCall.end());
+		to.isOut.insert(to.isOut.end(), from.isOut.begin(), from.isOut.end());
+		to.TradeId.insert(to.TradeId.end(), from.TradeId.begin(), from.TradeId.end());
+	}
+}
+
+
+vector<PartitionView> PortfolioStore::Views() const
+{
+	vector<PartitionView> views;
+	for (const StorePartition& p : partitions)
+	{
+		views.push_back(p.View());
+	}
+	return views;
+}
@@ -0,0 +1,151 @@
+// Columnar storage of a book of options, partitioned by product
+//
+// (c) Sudhansh Dua
+//
+//	A PortfolioStore keeps each position in the partition of its product (vanilla, barrier, digital, cash-or-nothing,
+//	asset-or-nothing, gap, chooser, geometric Asian, perpetual American) as one row of column arrays: one array per
+//	contract term, plus the quantity and the trade ID. A partition is priced by the batch kernel of its product
+//	(BatchPrice, BatchDigitalPrice, ..., and BatchBarrierPrice of ScenarioKernels.hpp) straight from the columns, with
+//	no dispatch per position and no pointer chasing. A position costs 60 to 88 bytes, against sizeof(Product) (128 with
+//	GCC on x86-64) plus its quantity for a vector<Product>; see tools/PortfolioStoreBenchmark.cpp.
+//
+//	Every column starts on a 64-byte boundary (StoreAlignment), so rows 8k onwards are aligned for AVX-512 loads;
+//	PortfolioPricer prices a partition in chunks of a multiple of 8 rows. A partition only fills the columns its
+//	product uses (see StorePartition); the others stay empty. Rows keep their order of insertion within a partition.
+//
+//	AmericanApproxOption has no partition: its batch kernel needs runs of equal market terms to pay off
+//	(BatchAmericanApprox), so such positions stay in a vector<Product>.
+
+
+#ifndef PortfolioStore_HPP
+#define PortfolioStore_HPP
+
+
+#include "PortfolioPricer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+using namespace std;
+
+
+const size_t StoreAlignment = 64;
+
+
+//	Allocator of StoreAlignment-aligned storage for the columns
+template <class T>
+struct AlignedAllocator
+{
+	typedef T value_type;
+
+	AlignedAllocator() {}
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U>&) {}
+
+	T* allocate(const size_t n)
+	{
+		return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(StoreAlignment)));
+	}
+
+	void deallocate(T* p, const size_t)
+	{
+		::operator delete(p, align_val_t(StoreAlignment));
+	}
+
+	template <class U>
+	bool operator == (const AlignedAllocator<U>&) const { return true; }
+	template <class U>
+	bool operator != (const AlignedAllocator<U>&) const { return false; }
+};
+
+typedef vector<double, AlignedAllocator<double>> DoubleColumn;
+typedef vector<int, AlignedAllocator<int>> FlagColumn;
+typedef vector<uint64_t, AlignedAllocator<uint64_t>> IdColumn;
+
+
+//	Partitions, in the order they are stored and valued
+enum class StoreKind { Vanilla, Barrier, Digital, CashOrNothing, AssetOrNothing, Gap, Chooser, Asian, Perpetual };
+const size_t StoreKinds = 9;
+
+//	"vanilla", "barrier", "digital", "cash-or-nothing", "asset-or-nothing", "gap", "chooser", "asian", "perpetual"
+const char* StoreKindName(const StoreKind kind);
+
+
+//	Read-only view of the columns of one partition, wherever they live (a StorePartition or a mapped file,
+//	MappedPortfolio in PortfolioFile.hpp); the columns a kind does not use are null
+struct PartitionView
+{
+	StoreKind Kind;
+	size_t Rows;
+
+	const double *S, *K, *T, *r, *sig, *b;
+	const double *K2, *H, *cr, *t;
+	const int *isCall, *isOut;
+	const double* Quantity;
+	const uint64_t* TradeId;
+
+	//	prices[0 .. end - begin) for the rows [begin, end), by the batch kernel of the kind
+	void Price(const size_t begin, const size_t end, double* prices) const;
+};
+
+
+//	Columns of one partition; row i is one position
+struct StorePartition
+{
+	StoreKind Kind;
+
+	DoubleColumn S, K, T, r, sig, b;	//	every kind, except T for perpetuals; K is the trigger strike K1 of a gap
+	DoubleColumn K2;					//	gap: payoff strike
+	DoubleColumn H;						//	barrier
+	DoubleColumn cr;					//	barrier (rebate) and cash-or-nothing (payout)
+	DoubleColumn t;						//	chooser: choice date
+	FlagColumn isCall;					//	every kind except chooser: non-zero for a call
+	FlagColumn isOut;					//	barrier: non-zero for a knock-out
+
+	DoubleColumn Quantity;				//	number of contracts (negative if short)
+	IdColumn TradeId;
+
+	size_t Size() const;
+	void Reserve(const size_t n);		//	the columns of this kind
+	void Clear();
+
+	//	prices[0 .. end - begin) for the rows [begin, end), by the batch kernel of the kind
+	void Price(const size_t begin, const size_t end, double* prices) const;
+
+	//	Row i as a Product
+	Product Contract(const size_t i) const;
+
+	PartitionView View() const;
+};
+
+
+class PortfolioStore
+{
+private:
+	StorePartition partitions[StoreKinds];
+
+public:
+	//	Constructors and destructor
+	PortfolioStore();
+	PortfolioStore(const PortfolioStore& store);
+	~PortfolioStore();
+
+	PortfolioStore& operator = (const PortfolioStore& store);
+
+	//	Appends a position to the partition of its product. Throws invalid_argument for an AmericanApproxOption.
+	void Add(const Product& product, const double quantity, const uint64_t tradeId);
+
+	const StorePartition& Partition(const StoreKind kind) const;
+	StorePartition& Partition(const StoreKind kind);		//	for loaders that fill the columns directly
+
+	size_t Size() const;				//	positions in all partitions
+	void Clear();
+
+	//	Appends the rows of every partition of store after those of the same partition here
+	void Append(const PortfolioStore& store);
+
+	vector<PartitionView> Views() const;	//	one per partition, in StoreKind order
+};
+
+
+#endif
@@ -0,0 +1,83 @@
+// Implementing the functions that are declared in the header file: Random.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "Random.hpp"
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Uniforms (normal = false) or normals of the draws of a block of paths. Each Philox block gives a pair of draws
+//	of one path, so the draws are generated a pair at a time, one path per lane; a pair that straddles either end of
+//	[firstDraw, firstDraw + draws) writes only its half inside.
+OPTION_TARGET_CLONES
+static void Fill(const uint64_t seed, const uint64_t firstPath, const size_t count, const uint64_t firstDraw, const size_t draws,
+	double* out, const bool normal)
+{
+	const uint64_t lastDraw = firstDraw + draws;
+
+	for (uint64_t pair = firstDraw >> 1; 2 * pair < lastDraw; ++pair)
+	{
+		const uint64_t draw = 2 * pair;
+
+		if (draw >= firstDraw && draw + 1 < lastDraw)
+		{
+			double* row0 = out + (draw - firstDraw) * count;
+			double* row1 = row0 + count;
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				double u0, u1;
+				PhiloxUniformPair(seed, firstPath + i, pair, u0, u1);
+				row0[i] = u0;
+				row1[i] = u1;
+			}
+		}
+		else if (draw >= firstDraw)
+		{
+			double* row0 = out + (draw - firstDraw) * count;
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				double u0, u1;
+				PhiloxUniformPair(seed, firstPath + i, pair, u0, u1);
+				row0[i] = u0;
+			}
+		}
+		else
+		{
+			double* row1 = out;				//	draw + 1 == firstDraw
+			OPTION_SIMD_LOOP
+			for (size_t i = 0; i < count; ++i)
+			{
+				double u0, u1;
+				PhiloxUniformPair(seed, firstPath + i, pair, u0, u1);
+				row1[i] = u1;
+			}
+		}
+	}
+
+	if (normal)
+	{
+		const size_t n = count * draws;
+		OPTION_SIMD_LOOP
+		for (size_t i = 0; i < n; ++i)
+		{
+			out[i] = InverseNormalCdf(out[i]);
+		}
+	}
+}
+
+
+void FillUniforms(const uint64_t seed, const uint64_t firstPath, const size_t count, const uint64_t firstDraw, const size_t draws, double* out)
+{
+	Fill(seed, firstPath, count, firstDraw, draws, out, false);
+}
+
+void FillNormals(const uint64_t seed, const uint64_t firstPath, const size_t count, const uint64_t firstDraw, const size_t draws, double* out)
+{
+	Fill(seed, firstPath, count, firstDraw, draws, out, true);
+}
@@ -0,0 +1,147 @@
+// Counter-based random numbers for the Monte Carlo engines
+//
+// (c) Sudhansh Dua
+//
+//	Philox4x32-10 (Salmon, Moraes, Dror & Shaw 2011, "Parallel random numbers: as easy as 1, 2, 3") maps a 128-bit
+//	counter and a 64-bit key to 128 random bits through ten rounds of 32 x 32 -> 64 bit multiplications, with no
+//	state carried from one output to the next. Here the key is the seed and the counter is (pair, path):
+//		counter = { pair (low, high 32 bits), path (low, high 32 bits) },	key = seed (low, high 32 bits)
+//	and each output gives the uniforms of draws 2 pair and 2 pair + 1 of the path, 64 bits each. Draw d of path p is
+//	therefore computed directly from (seed, p, d):
+//	->	there is no shared generator state, so threads need no locks and no per-thread streams
+//	->	skipping ahead to any path, or to any draw of a path, costs nothing
+//	->	the numbers do not depend on how the paths are split between threads or blocks, so neither do the prices
+//	Philox passes the BigCrush battery of TestU01 and has a period of 2^128 per key.
+//
+//	Uniforms are (k + 1/2) / 2^52 with k the top 52 bits of the 64, so they lie strictly inside (0, 1), and normals
+//	come from them by Numerics::InverseNormalCdf (Acklam, relative error < 1.15e-9). The inverse CDF keeps the
+//	normals monotone in the uniforms, which antithetic variates and quasi-random points need, where Box-Muller
+//	would mix two uniforms into each normal.
+//
+//	The bulk forms (FillUniforms, FillNormals) generate a block of paths at a time, one path per lane of a
+//	vectorised loop (compiled for AVX-512, AVX2 and a scalar fallback, see Numerics.hpp), and are what the engines
+//	use; PhiloxStream draws one path sequentially. Both give the same uniforms for the same (seed, path, draw); the
+//	normals may differ in the last bits where the vectorised loop contracts to FMA instructions.
+
+
+#ifndef Random_HPP
+#define Random_HPP
+
+
+#include "Numerics.hpp"
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+
+//	Philox4x32 constants: the multipliers and the Weyl increments of the key
+const uint32_t PhiloxM0 = 0xD2511F53U;
+const uint32_t PhiloxM1 = 0xCD9E8D57U;
+const uint32_t PhiloxW0 = 0x9E3779B9U;
+const uint32_t PhiloxW1 = 0xBB67AE85U;
+
+
+//	One Philox4x32-10 block: ten rounds on the counter c with the key (k0, k1), in place. Branch-free and vectorisable.
+inline void Philox4x32(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1)
+{
+	for (int round = 0; round < 10; ++round)
+	{
+		uint64_t p0 = static_cast<uint64_t>(PhiloxM0) * c0;
+		uint64_t p1 = static_cast<uint64_t>(PhiloxM1) * c2;
+
+		uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+		uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+		c1 = static_cast<uint32_t>(p1);
+		c3 = static_cast<uint32_t>(p0);
+		c0 = n0;
+		c2 = n2;
+
+		k0 += PhiloxW0;
+		k1 += PhiloxW1;
+	}
+}
+
+
+//	Uniform in (0, 1) from 64 random bits: (k + 1/2) / 2^52 from the top 52 bits, through the mantissa (AVX2 has no
+//	vector uint64 -> double conversion)
+inline double BitsToUniform(const uint32_t high, const uint32_t low)
+{
+	uint64_t bits = ((static_cast<uint64_t>(high) << 20) | (low >> 12)) | 0x3FF0000000000000ULL;		//	1 + k / 2^52
+	return (Numerics::AsDouble(bits) - 1.0) + (0.5 / 4503599627370496.0);
+}
+
+
+//	Uniforms of draws 2 pair and 2 pair + 1 of a path
+inline void PhiloxUniformPair(const uint64_t seed, const uint64_t path, const uint64_t pair, double& u0, double& u1)
+{
+	uint32_t c0 = static_cast<uint32_t>(pair);
+	uint32_t c1 = static_cast<uint32_t>(pair >> 32);
+	uint32_t c2 = static_cast<uint32_t>(path);
+	uint32_t c3 = static_cast<uint32_t>(path >> 32);
+	Philox4x32(c0, c1, c2, c3, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+
+	u0 = BitsToUniform(c1, c0);
+	u1 = BitsToUniform(c3, c2);
+}
+
+//	Uniform of one draw of a path (half of a Philox block is discarded: prefer the bulk forms in loops)
+inline double PhiloxUniform(const uint64_t seed, const uint64_t path, const uint64_t draw)
+{
+	double u0, u1;
+	PhiloxUniformPair(seed, path, draw >> 1, u0, u1);
+	return (draw & 1) ? u1 : u0;
+}
+
+
+//	Bulk forms for count paths starting at firstPath, and draws [firstDraw, firstDraw + draws) of each. The output is
+//	laid out draw by draw, out[d * count + i] for draw firstDraw + d of path firstPath + i, which is the order in which
+//	an engine that keeps one path per lane consumes it.
+void FillUniforms(const uint64_t seed, const uint64_t firstPath, const size_t count, const uint64_t firstDraw, const size_t draws, double* out);
+void FillNormals(const uint64_t seed, const uint64_t firstPath, const size_t count, const uint64_t firstDraw, const size_t draws, double* out);
+
+
+//	Sequential draws along one path, for code that simulates one path at a time
+class PhiloxStream
+{
+private:
+	uint64_t seed;
+	uint64_t path;
+	uint64_t draw;				//	next draw
+	uint64_t cachedPair;		//	pair of draws held in cache, or ~0 if none
+	double cache[2];
+
+public:
+	PhiloxStream(const uint64_t seed1, const uint64_t path1, const uint64_t draw1 = 0)
+		: seed(seed1), path(path1), draw(draw1), cachedPair(~0ULL), cache{ 0.0, 0.0 } {}
+
+	//	Skip-ahead: move to another path, or n draws along this one
+	void Seek(const uint64_t path1, const uint64_t draw1 = 0)
+	{
+		path = path1;
+		draw = draw1;
+		cachedPair = ~0ULL;
+	}
+
+	void Skip(const uint64_t n)
+	{
+		draw += n;
+	}
+
+	double Uniform()
+	{
+		uint64_t pair = draw >> 1;
+		if (pair != cachedPair)
+		{
+			PhiloxUniformPair(seed, path, pair, cache[0], cache[1]);
+			cachedPair = pair;
+		}
+		return cache[draw++ & 1];
+	}
+
+	double Normal()
+	{
+		return Numerics::InverseNormalCdf(Uniform());
+	}
+};
+
+#endif
@@ -0,0 +1,350 @@
+// Implementing the classes that are defined in the header file: RepricingService.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "RepricingService.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+
+using namespace std;
+
+
+//	LatencyHistogram
+
+const size_t LatencyExact = 32;				//	one bucket per nanosecond below this
+const size_t LatencySubBuckets = 32;		//	buckets per power of two above it
+const size_t LatencyBuckets = LatencyExact + (63 - 5) * LatencySubBuckets;
+
+//	Bucket of a latency
+static size_t LatencyBucket(const int64_t nanoseconds)
+{
+	if (nanoseconds < static_cast<int64_t>(LatencyExact))
+	{
+		return (nanoseconds < 0) ? 0 : static_cast<size_t>(nanoseconds);
+	}
+	const uint64_t v = static_cast<uint64_t>(nanoseconds);
+	const size_t octave = 63 - __builtin_clzll(v);			//	>= 5
+	const size_t sub = (v >> (octave - 5)) & (LatencySubBuckets - 1);
+	return LatencyExact + (octave - 5) * LatencySubBuckets + sub;
+}
+
+//	Largest latency of a bucket
+static double LatencyUpperEdge(const size_t bucket)
+{
+	if (bucket < LatencyExact)
+	{
+		return static_cast<double>(bucket);
+	}
+	const size_t octave = 5 + (bucket - LatencyExact) / LatencySubBuckets;
+	const size_t sub = (bucket - LatencyExact) % LatencySubBuckets;
+	return ldexp(static_cast<double>(LatencySubBuckets + sub + 1), static_cast<int>(octave) - 5) - 1.0;
+}
+
+
+//	Constructors and destructor
+LatencyHistogram::LatencyHistogram() : counts(LatencyBuckets, 0), total(0), largest(0) {}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& histogram)
+	: counts(histogram.counts), total(histogram.total), largest(histogram.largest) {}
+
+LatencyHistogram::~LatencyHistogram() {}
+
+LatencyHistogram& LatencyHistogram::operator = (const LatencyHistogram& histogram)
+{
+	if (this == &histogram)
+	{
+		return *this;
+	}
+
+	counts = histogram.counts;
+	total = histogram.total;
+	largest = histogram.largest;
+
+	return *this;
+}
+
+
+void LatencyHistogram::Record(const int64_t nanoseconds)
+{
+	++counts[LatencyBucket(nanoseconds)];
+	++total;
+	largest = max(largest, nanoseconds);
+}
+
+void LatencyHistogram::Clear()
+{
+	fill(counts.begin(), counts.end(), 0);
+	total = 0;
+	largest = 0;
+}
+
+
+uint64_t LatencyHistogram::Count() const
+{
+	return total;
+}
+
+int64_t LatencyHistogram::Max() const
+{
+	return largest;
+}
+
+double LatencyHistogram::Percentile(const double p) const
+{
+	if (total == 0)
+	{
+		return 0.0;
+	}
+
+	//	rank of the percentile among the total latencies, 1-based
+	const uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(min(max(p, 0.0), 100.0) / 100.0 * total)));
+	uint64_t seen = 0;
+	for (size_t bucket = 0; bucket < counts.size(); ++bucket)
+	{
+		seen += counts[bucket];
+		if (seen >= rank)
+		{
+			return min(LatencyUpperEdge(bucket), static_cast<double>(largest));
+		}
+	}
+	return static_cast<double>(largest);
+}
+
+
+//	RepricingService
+
+const size_t ServiceDrainLimit = 4096;		//	updates drained before the dirty underlyings are repriced
+const size_t ServiceIdleSpins = 64;			//	empty polls before the pricing thread yields
+
+
+//	Constructors and destructor
+RepricingService::RepricingService(const vector<Position>& positions, const vector<uint32_t>& underlying, const size_t capacity)
+	: contracts(), dependents(), input(capacity), output(capacity), worker(), running(false), pending(),
+	dirty(), latency(), received(0), rejected(0), coalesced(0), repriced(0), published(0), dropped(0)
+{
+	if (underlying.size() != positions.size())
+	{
+		throw invalid_argument("RepricingService::RepricingService: one underlying per position is required");
+	}
+
+	const size_t count = underlying.empty() ? 0 : *max_element(underlying.begin(), underlying.end()) + size_t(1);
+	dependents.resize(count);
+	pending.resize(count, MarketUpdate{ 0, 0, 0.0, 0.0, 0.0, 0 });
+	dirty.reserve(count);
+
+	contracts.reserve(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		contracts.push_back(positions[i].Contract);
+		dependents[underlying[i]].push_back(i);
+	}
+}
+
+RepricingService::~RepricingService()
+{
+	Stop();
+}
+
+
+void RepricingService::Start()
+{
+	if (worker.joinable())
+	{
+		throw logic_error("RepricingService::Start: already running");
+	}
+	running.store(true);
+	worker = thread(&RepricingService::Run, this);
+}
+
+void RepricingService::Stop()
+{
+	if (!worker.joinable())
+	{
+		return;
+	}
+	running.store(false);
+	worker.join();
+}
+
+
+bool RepricingService::Publish(MarketUpdate update)
+{
+	if (update.Underlying >= pending.size())
+	{
+		throw invalid_argument("RepricingService::Publish: unknown underlying " + to_string(update.Underlying));
+	}
+	if ((update.Fields & (MarketSpot | MarketVol | MarketRate)) == 0)
+	{
+		throw invalid_argument("RepricingService::Publish: the update sets no field");
+	}
+
+	update.Stamp = Now();
+	if (!input.TryPush(update))
+	{
+		rejected.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+bool RepricingService::Poll(PriceUpdate& price)
+{
+	return output.TryPop(price);
+}
+
+
+void RepricingService::Run()
+{
+	size_t idle = 0;
+	for (;;)
+	{
+		//	read before draining, so that the updates published before Stop are all priced
+		const bool stopping = !running.load();
+
+		MarketUpdate update;
+		size_t drained = 0;
+		while (drained < ServiceDrainLimit && input.TryPop(update))
+		{
+			Merge(update);
+			++drained;
+		}
+		received.fetch_add(drained, memory_order_relaxed);
+
+		if (!dirty.empty())
+		{
+			for (const uint32_t underlying : dirty)
+			{
+				Reprice(underlying);
+			}
+			dirty.clear();
+			idle = 0;
+			continue;
+		}
+
+		if (stopping && drained == 0)
+		{
+			return;
+		}
+		if (++idle >= ServiceIdleSpins)
+		{
+			this_thread::yield();
+			idle = 0;
+		}
+	}
+}
+
+void RepricingService::Merge(const MarketUpdate& update)
+{
+	MarketUpdate& merged = pending[update.Underlying];
+	if (merged.Fields == 0)
+	{
+		merged = update;
+		dirty.push_back(update.Underlying);
+		return;
+	}
+
+	coalesced.fetch_add(1, memory_order_relaxed);
+	if (update.Fields & MarketSpot)
+	{
+		merged.Spot = update.Spot;
+	}
+	if (update.Fields & MarketVol)
+	{
+		merged.Vol = update.Vol;
+	}
+	if (update.Fields & MarketRate)
+	{
+		merged.Rate = update.Rate;
+	}
+	merged.Fields |= update.Fields;
+	merged.Stamp = min(merged.Stamp, update.Stamp);
+}
+
+void RepricingService::Reprice(const uint32_t underlying)
+{
+	MarketUpdate& update = pending[underlying];
+	const vector<size_t>& positions = dependents[underlying];
+
+	for (const size_t i : positions)
+	{
+		visit([&update](auto& option)
+		{
+			if (update.Fields & MarketSpot)
+			{
+				option.S = update.Spot;
+			}
+			if (update.Fields & MarketVol)
+			{
+				option.sig = update.Vol;
+			}
+			if (update.Fields & MarketRate)
+			{
+				if (option.b != 0.0)
+				{
+					option.b += update.Rate - option.r;
+				}
+				option.r = update.Rate;
+			}
+		}, contracts[i]);
+
+		const PriceUpdate price{ i, underlying, ::Price(contracts[i]), update.Stamp };
+		if (output.TryPush(price))
+		{
+			published.fetch_add(1, memory_order_relaxed);
+		}
+		else
+		{
+			dropped.fetch_add(1, memory_order_relaxed);
+		}
+	}
+
+	repriced.fetch_add(positions.size(), memory_order_relaxed);
+	latency.Record(Now() - update.Stamp);
+	update.Fields = 0;
+}
+
+
+size_t RepricingService::Positions() const
+{
+	return contracts.size();
+}
+
+size_t RepricingService::Underlyings() const
+{
+	return dependents.size();
+}
+
+ServiceStats RepricingService::Stats() const
+{
+	return ServiceStats{ received.load(memory_order_relaxed), rejected.load(memory_order_relaxed), coalesced.load(memory_order_relaxed),
+		repriced.load(memory_order_relaxed), published.load(memory_order_relaxed), dropped.load(memory_order_relaxed) };
+}
+
+
+LatencyHistogram RepricingService::Latency() const
+{
+	if (worker.joinable())
+	{
+		throw logic_error("RepricingService::Latency: the pricing thread is running");
+	}
+	return latency;
+}
+
+const Product& RepricingService::Contract(const size_t position) const
+{
+	if (worker.joinable())
+	{
+		throw logic_error("RepricingService::Contract: the pricing thread is running");
+	}
+	return contracts.at(position);
+}
+
+
+int64_t RepricingService::Now()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,147 @@
+// Continuous repricing of positions from a stream of market updates
+//
+// (c) Sudhansh Dua
+//
+//	A RepricingService owns a copy of the positions, each tied to an underlying. Market updates (new spot, vol
+//	and / or rate levels of an underlying) are published from any thread into a lock-free MpscRing. A pricing
+//	thread drains that ring, coalesces the updates of each underlying into one (the latest level of every field, the
+//	stamp of the oldest), applies it to the contracts that depend on the underlying and reprices only those. Each
+//	new price goes out through an SpscRing to one consumer thread, which polls it.
+//
+//	A rate update moves the cost of carry b by the same amount, except where b = 0 (a futures option), as in the
+//	historical VaR engine. Publish and Poll are the entry points that are safe to call while the service runs: Publish
+//	from any number of threads, Poll from one thread at a time. Everything else belongs to the owning thread.
+//
+//	Tick-to-price latency runs from the stamp Publish puts on an update to the moment the last price it causes is
+//	pushed onto the output ring; a coalesced update counts from its oldest tick. Latencies go into a log-linear
+//	histogram (about 3% resolution) with percentiles. When the output ring is full, prices are dropped and
+//	counted rather than stalling the pricing thread; size it for the consumer.
+
+
+#ifndef RepricingService_HPP
+#define RepricingService_HPP
+
+
+#include "PortfolioPricer.hpp"
+#include "RingBuffer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+//	Fields of a MarketUpdate that carry a new level
+const uint32_t MarketSpot = 1, MarketVol = 2, MarketRate = 4;
+
+struct MarketUpdate
+{
+	uint32_t Underlying;		//	index, below the number of underlyings of the service
+	uint32_t Fields;			//	MarketSpot | MarketVol | MarketRate
+	double Spot, Vol, Rate;		//	new levels of the fields set
+	int64_t Stamp;				//	set by Publish: steady clock, nanoseconds
+};
+
+struct PriceUpdate
+{
+	size_t Position;			//	index in the positions of the service
+	uint32_t Underlying;
+	double Price;				//	of one contract
+	int64_t Stamp;				//	of the oldest market update behind this price
+};
+
+
+//	Counts of latencies in nanoseconds: exact below 32 ns, then 32 buckets per power of two
+class LatencyHistogram
+{
+private:
+	vector<uint64_t> counts;
+	uint64_t total;
+	int64_t largest;
+
+public:
+	//	Constructors and destructor
+	LatencyHistogram();
+	LatencyHistogram(const LatencyHistogram& histogram);
+	~LatencyHistogram();
+
+	LatencyHistogram& operator = (const LatencyHistogram& histogram);
+
+	void Record(const int64_t nanoseconds);
+	void Clear();
+
+	uint64_t Count() const;
+	int64_t Max() const;
+	double Percentile(const double p) const;		//	upper edge of the bucket holding percentile p (0 .. 100), in ns
+};
+
+
+struct ServiceStats
+{
+	uint64_t Received;			//	market updates drained
+	uint64_t Rejected;			//	refused by Publish, the input ring being full
+	uint64_t Coalesced;			//	merged into an update of the same underlying that was still pending
+	uint64_t Repriced;			//	position repricings
+	uint64_t Published;			//	prices pushed onto the output ring
+	uint64_t Dropped;			//	prices lost to a full output ring
+};
+
+
+class RepricingService
+{
+private:
+	vector<Product> contracts;
+	vector<vector<size_t>> dependents;	//	positions of each underlying
+
+	MpscRing<MarketUpdate> input;
+	SpscRing<PriceUpdate> output;
+
+	//	Pricing thread
+	thread worker;
+	atomic<bool> running;
+	vector<MarketUpdate> pending;		//	coalesced update of each underlying
+	vector<uint32_t> dirty;				//	underlyings with a pending update, in order of arrival
+	LatencyHistogram latency;
+
+	atomic<uint64_t> received, rejected, coalesced, repriced, published, dropped;
+
+	void Run();									//	pricing loop
+	void Merge(const MarketUpdate& update);		//	into the pending update of its underlying
+	void Reprice(const uint32_t underlying);	//	applies its pending update and publishes the prices
+
+public:
+	//	Constructors and destructor
+	//	positions[i] depends on underlying[i]; there are max(underlying) + 1 underlyings. The rings hold capacity
+	//	updates and prices (rounded up to powers of two; the update ring has at least MpscMinCapacity slots).
+	RepricingService(const vector<Position>& positions, const vector<uint32_t>& underlying, const size_t capacity = 1 << 16);
+	RepricingService(const RepricingService& service) = delete;
+	~RepricingService();														//	stops the pricing thread
+
+	RepricingService& operator = (const RepricingService& service) = delete;
+
+	void Start();		//	starts the pricing thread
+	void Stop();		//	prices the updates already published, then joins the pricing thread
+
+	//	Any thread: stamps the update and queues it; false (and counted) if the input ring is full. Throws
+	//	invalid_argument for an unknown underlying or an update that sets no field.
+	bool Publish(MarketUpdate update);
+
+	//	One consumer thread: the next price, if any
+	bool Poll(PriceUpdate& price);
+
+	size_t Positions() const;
+	size_t Underlyings() const;
+	ServiceStats Stats() const;
+
+	//	Tick-to-price latencies so far; throws logic_error while the pricing thread runs
+	LatencyHistogram Latency() const;
+
+	//	Contract of a position with the market applied so far; throws logic_error while the pricing thread runs
+	const Product& Contract(const size_t position) const;
+
+	static int64_t Now();		//	steady clock, nanoseconds
+};
+
+
+#endif
@@ -0,0 +1,203 @@
+// Bounded lock-free ring buffers: single producer / single consumer and multiple producers / single consumer
+//
+// (c) Sudhansh Dua
+//
+//	Both rings hold a power-of-two number of slots, allocated once, and never block: TryPush returns false when the
+//	ring is full and TryPop when it is empty, so the caller chooses between spinning, yielding and dropping.
+//
+//	SpscRing: the producer owns the tail and the consumer the head, each on its own cache line, with a cached copy
+//	of the other index so that an index of the other thread is read only when the ring looks full (or empty).
+//
+//	MpscRing: producers claim a slot by a compare-and-swap on the tail; every slot carries a sequence number that
+//	says whether it is free for the push of round n or holds the value of round n, so a consumer never reads a slot
+//	a producer has claimed but not yet filled. The single consumer owns the head. An MpscRing has at least
+//	MpscMinCapacity slots: with one slot, a free slot and a filled one carry the same sequence number, so a second
+//	push would be accepted before the first was popped, and no pop would succeed after it.
+//
+//	T must be default constructible and copy assignable; a value is copied in and out.
+
+
+#ifndef RingBuffer_HPP
+#define RingBuffer_HPP
+
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+using namespace std;
+
+
+const size_t RingCacheLine = 64;
+const size_t MpscMinCapacity = 2;
+
+
+//	Smallest power of two >= n; throws invalid_argument for 0
+inline size_t RingCapacity(const size_t n)
+{
+	if (n == 0)
+	{
+		throw invalid_argument("RingCapacity: a ring needs at least one slot");
+	}
+	size_t capacity = 1;
+	while (capacity < n)
+	{
+		capacity <<= 1;
+	}
+	return capacity;
+}
+
+
+template <class T>
+class SpscRing
+{
+private:
+	unique_ptr<T[]> slots;
+	size_t mask;
+
+	alignas(RingCacheLine) atomic<size_t> head;		//	next slot to pop, written by the consumer
+	size_t cachedTail;								//	consumer's copy of tail
+
+	alignas(RingCacheLine) atomic<size_t> tail;		//	next slot to push, written by the producer
+	size_t cachedHead;								//	producer's copy of head
+
+public:
+	//	Constructors and destructor
+	explicit SpscRing(const size_t capacity1)		//	rounded up to a power of two
+		: slots(new T[RingCapacity(capacity1)]), mask(RingCapacity(capacity1) - 1), head(0), cachedTail(0), tail(0), cachedHead(0) {}
+	SpscRing(const SpscRing<T>& ring) = delete;
+	~SpscRing() {}
+
+	SpscRing<T>& operator = (const SpscRing<T>& ring) = delete;
+
+	size_t Capacity() const
+	{
+		return mask + 1;
+	}
+
+	//	Values in the ring; exact only when neither side is running
+	size_t Size() const
+	{
+		return tail.load(memory_order_acquire) - head.load(memory_order_acquire);
+	}
+
+	//	Producer only
+	bool TryPush(const T& value)
+	{
+		const size_t t = tail.load(memory_order_relaxed);
+		if (t - cachedHead > mask)
+		{
+			cachedHead = head.load(memory_order_acquire);
+			if (t - cachedHead > mask)
+			{
+				return false;
+			}
+		}
+		slots[t & mask] = value;
+		tail.store(t + 1, memory_order_release);
+		return true;
+	}
+
+	//	Consumer only
+	bool TryPop(T& value)
+	{
+		const size_t h = head.load(memory_order_relaxed);
+		if (h == cachedTail)
+		{
+			cachedTail = tail.load(memory_order_acquire);
+			if (h == cachedTail)
+			{
+				return false;
+			}
+		}
+		value = slots[h & mask];
+		head.store(h + 1, memory_order_release);
+		return true;
+	}
+};
+
+
+template <class T>
+class MpscRing
+{
+private:
+	struct Slot
+	{
+		atomic<size_t> sequence;		//	i + n capacity: free for push n; i + n capacity + 1: holds the value of push n
+		T value;
+	};
+
+	unique_ptr<Slot[]> slots;
+	size_t mask;
+
+	alignas(RingCacheLine) atomic<size_t> tail;		//	next slot to claim, shared by the producers
+	alignas(RingCacheLine) size_t head;				//	next slot to pop, owned by the consumer
+
+public:
+	//	Constructors and destructor
+	explicit MpscRing(const size_t capacity1)		//	rounded up to a power of two, and to at least MpscMinCapacity
+		: slots(new Slot[max(MpscMinCapacity, RingCapacity(capacity1))]), mask(max(MpscMinCapacity, RingCapacity(capacity1)) - 1),
+		tail(0), head(0)
+	{
+		for (size_t i = 0; i <= mask; ++i)
+		{
+			slots[i].sequence.store(i, memory_order_relaxed);
+		}
+	}
+	MpscRing(const MpscRing<T>& ring) = delete;
+	~MpscRing() {}
+
+	MpscRing<T>& operator = (const MpscRing<T>& ring) = delete;
+
+	size_t Capacity() const
+	{
+		return mask + 1;
+	}
+
+	//	Any thread
+	bool TryPush(const T& value)
+	{
+		size_t t = tail.load(memory_order_relaxed);
+		for (;;)
+		{
+			Slot& slot = slots[t & mask];
+			const size_t sequence = slot.sequence.load(memory_order_acquire);
+			const ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - t);
+			if (lag == 0)
+			{
+				if (tail.compare_exchange_weak(t, t + 1, memory_order_relaxed))
+				{
+					slot.value = value;
+					slot.sequence.store(t + 1, memory_order_release);
+					return true;
+				}
+			}
+			else if (lag < 0)
+			{
+				return false;				//	the slot still holds the value of the previous round: full
+			}
+			else
+			{
+				t = tail.load(memory_order_relaxed);
+			}
+		}
+	}
+
+	//	Consumer only
+	bool TryPop(T& value)
+	{
+		Slot& slot = slots[head & mask];
+		if (slot.sequence.load(memory_order_acquire) != head + 1)
+		{
+			return false;					//	empty, or the next push is claimed but not yet written
+		}
+		value = slot.value;
+		slot.sequence.store(head + mask + 1, memory_order_release);
+		++head;
+		return true;
+	}
+};
+
+
+#endif
@@ -0,0 +1,353 @@
+// Implementing the classes and functions that are defined in the header file: ScenarioEngine.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "ScenarioEngine.hpp"
+#include "ScenarioKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+
+using namespace std;
+
+
+vector<double> Ladder(const double first, const double last, const size_t points)
+{
+	vector<double> ladder(points);
+	for (size_t i = 0; i < points; ++i)
+	{
+		ladder[i] = (points == 1) ? first : first + (last - first) * static_cast<double>(i) / static_cast<double>(points - 1);
+	}
+	return ladder;
+}
+
+
+//	ScenarioGrid
+ScenarioGrid::ScenarioGrid()
+	: SpotShifts(Ladder(-0.2, 0.2, 21)), VolShifts(Ladder(-0.05, 0.05, 11)),
+	TimeShifts{ 0.0, 1.0 / 365.0, 7.0 / 365.0, 30.0 / 365.0, 90.0 / 365.0 } {}
+
+ScenarioGrid::ScenarioGrid(const vector<double>& spotShifts, const vector<double>& volShifts, const vector<double>& timeShifts)
+	: SpotShifts(spotShifts), VolShifts(volShifts), TimeShifts(timeShifts) {}
+
+size_t ScenarioGrid::Size() const
+{
+	return SpotShifts.size() * VolShifts.size() * TimeShifts.size();
+}
+
+
+//	ScenarioCube
+ScenarioCube::ScenarioCube() : spots(0), vols(0), times(0), values() {}
+
+ScenarioCube::ScenarioCube(const size_t spots1, const size_t vols1, const size_t times1)
+	: spots(spots1), vols(vols1), times(times1), values(spots1 * vols1 * times1, 0.0) {}
+
+ScenarioCube::ScenarioCube(const ScenarioGrid& grid)
+	: ScenarioCube(grid.SpotShifts.size(), grid.VolShifts.size(), grid.TimeShifts.size()) {}
+
+ScenarioCube::ScenarioCube(const ScenarioCube& cube)
+	: spots(cube.spots), vols(cube.vols), times(cube.times), values(cube.values) {}
+
+ScenarioCube::~ScenarioCube() {}
+
+ScenarioCube& ScenarioCube::operator = (const ScenarioCube& cube)
+{
+	if (this == &cube)
+	{
+		return *this;		//	Self-assignment check!
+	}
+	spots = cube.spots;
+	vols = cube.vols;
+	times = cube.times;
+	values = cube.values;
+	return *this;
+}
+
+size_t ScenarioCube::Spots() const
+{
+	return spots;
+}
+
+size_t ScenarioCube::Vols() const
+{
+	return vols;
+}
+
+size_t ScenarioCube::Times() const
+{
+	return times;
+}
+
+size_t ScenarioCube::Size() const
+{
+	return values.size();
+}
+
+double& ScenarioCube::operator () (const size_t spot, const size_t vol, const size_t time)
+{
+	return values[(time * vols + vol) * spots + spot];
+}
+
+double ScenarioCube::operator () (const size_t spot, const size_t vol, const size_t time) const
+{
+	return values[(time * vols + vol) * spots + spot];
+}
+
+double* ScenarioCube::Row(const size_t vol, const size_t time)
+{
+	return values.data() + (time * vols + vol) * spots;
+}
+
+const double* ScenarioCube::Data() const
+{
+	return values.data();
+}
+
+void ScenarioCube::Add(const ScenarioCube& cube, const double weight)
+{
+	if (cube.spots != spots || cube.vols != vols || cube.times != times)
+	{
+		throw invalid_argument("ScenarioCube::Add: the cubes have different shapes");
+	}
+
+	const size_t n = values.size();
+	double* v = values.data();
+	const double* w = cube.values.data();
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		v[i] += weight * w[i];
+	}
+}
+
+double ScenarioCube::Min() const
+{
+	return values.empty() ? 0.0 : *min_element(values.begin(), values.end());
+}
+
+double ScenarioCube::Max() const
+{
+	return values.empty() ? 0.0 : *max_element(values.begin(), values.end());
+}
+
+
+//	Shifted market of a node
+static double ShiftedVol(const double sig, const double shift)
+{
+	return max(sig + shift, ScenarioMinimumVol);
+}
+
+static double ShiftedTime(const double T, const double shift)
+{
+	return max(T - shift, ScenarioMinimumTime);
+}
+
+
+//	Every node of the grid for one product: the hoisted row kernels where the product has one, Price() otherwise
+void ScenarioPrices(const Product& product, const ScenarioGrid& grid, double* out)
+{
+	const size_t spots = grid.SpotShifts.size();
+	const size_t vols = grid.VolShifts.size();
+	const size_t times = grid.TimeShifts.size();
+
+	visit([&](const auto& option)
+	{
+		typedef decay_t<decltype(option)> Kind;
+
+		//	Spot ladder of this position
+		vector<double> spot(spots), logSpot(spots);
+		const double logS = log(option.S);
+		for (size_t i = 0; i < spots; ++i)
+		{
+			spot[i] = option.S * (1.0 + grid.SpotShifts[i]);
+			logSpot[i] = logS + log1p(grid.SpotShifts[i]);
+		}
+
+		const double phi = (option.type == OptionType::Call) ? 1.0 : -1.0;
+
+		//	Constant along every axis: the log of the strike (of the trigger strike K1 for a gap option) and the barrier
+		constexpr bool black = is_same<Kind, Option>::value || is_same<Kind, EuropeanOption>::value || is_same<Kind, DigitalOption>::value
+			|| is_same<Kind, AssetOrNothingOption>::value || is_same<Kind, CashOrNothingOption>::value || is_same<Kind, GapOption>::value;
+		BlackLanes blackLanes;
+		BarrierLanes barrierLanes;
+		BarrierContract contract;
+
+		double logK = 0.0;
+		if constexpr (is_same<Kind, GapOption>::value)
+		{
+			logK = log(option.K1);
+		}
+		else
+		{
+			logK = log(option.K);
+		}
+		if constexpr (is_same<Kind, BarrierOption>::value)
+		{
+			contract.H = option.H;
+			contract.K = option.K;
+			contract.logH = log(option.H);
+			contract.logK = logK;
+			contract.cr = option.cr;
+			contract.call = (option.type == OptionType::Call);
+			contract.out = (option.InOrOut == BarrierType::Out);
+		}
+
+		for (size_t k = 0; k < times; ++k)
+		{
+			//	Constant along the vol and spot axes
+			const double T = ShiftedTime(option.T, grid.TimeShifts[k]);
+			const double sqrtT = sqrt(T);
+			const double df = exp(-option.r * T);
+			const double carry = exp((option.b - option.r) * T);
+
+			for (size_t j = 0; j < vols; ++j)
+			{
+				//	Constant along the spot axis: the terms of the lanes, set once and copied across the ladder
+				const double sig = ShiftedVol(option.sig, grid.VolShifts[j]);
+				const size_t lanes = min(spots, KernelLanes);
+				double* row = out + (k * vols + j) * spots;
+
+				if constexpr (black)
+				{
+					blackLanes.drift[0] = (option.b + 0.5 * sig * sig) * T;			//	of d1
+					blackLanes.s[0] = sig * sqrtT;
+					if constexpr (is_same<Kind, DigitalOption>::value)
+					{
+						blackLanes.a[0] = 0.0;
+						blackLanes.c[0] = df;
+					}
+					else if constexpr (is_same<Kind, AssetOrNothingOption>::value)
+					{
+						blackLanes.a[0] = df;
+						blackLanes.c[0] = 0.0;
+					}
+					else if constexpr (is_same<Kind, CashOrNothingOption>::value)
+					{
+						blackLanes.a[0] = 0.0;
+						blackLanes.c[0] = option.cr * df;
+					}
+					else if constexpr (is_same<Kind, GapOption>::value)
+					{
+						blackLanes.a[0] = phi * carry;
+						blackLanes.c[0] = -phi * option.K2 * df;
+					}
+					else
+					{
+						blackLanes.a[0] = phi * carry;
+						blackLanes.c[0] = -phi * option.K * df;
+					}
+					blackLanes.Fill(lanes);
+
+					for (size_t start = 0; start < spots; start += KernelLanes)
+					{
+						BlackLanePrices(spot.data() + start, logSpot.data() + start, min(spots - start, KernelLanes), logK, phi, blackLanes,
+							blackLanes.a[0] != 0.0, blackLanes.c[0] != 0.0, row + start);
+					}
+				}
+				else if constexpr (is_same<Kind, BarrierOption>::value)
+				{
+					barrierLanes.Set(0, sig, option.r, option.b, sqrtT, df, carry);
+					barrierLanes.Fill(lanes);
+
+					for (size_t start = 0; start < spots; start += KernelLanes)
+					{
+						BarrierLanePrices(spot.data() + start, logSpot.data() + start, min(spots - start, KernelLanes), contract, barrierLanes, row + start);
+					}
+				}
+				else
+				{
+					//	No hoisted kernel: reprice the shifted contract
+					Kind shifted(option);
+					shifted.T = T;
+					shifted.sig = sig;
+					if constexpr (is_same<Kind, ChooserOption>::value)
+					{
+						shifted.t = min(ShiftedTime(option.t, grid.TimeShifts[k]), T);
+					}
+
+					for (size_t i = 0; i < spots; ++i)
+					{
+						shifted.S = spot[i];
+						row[i] = shifted.Price();
+					}
+				}
+			}
+		}
+	}, product);
+}
+
+
+//	ScenarioEngine
+ScenarioEngine::ScenarioEngine() : pool() {}
+
+ScenarioEngine::ScenarioEngine(const size_t threads) : pool(threads) {}
+
+ScenarioEngine::~ScenarioEngine() {}
+
+size_t ScenarioEngine::Threads() const
+{
+	return pool.Size();
+}
+
+
+ScenarioReport ScenarioEngine::Run(const vector<Position>& portfolio, const ScenarioGrid& grid)
+{
+	if (grid.Size() == 0)
+	{
+		throw invalid_argument("ScenarioEngine::Run: every ladder of the grid needs at least one point");
+	}
+	for (double shift : grid.SpotShifts)
+	{
+		if (!(shift > -1.0))
+		{
+			throw invalid_argument("ScenarioEngine::Run: spot shifts must be greater than -1");
+		}
+	}
+
+	const size_t n = portfolio.size();
+	ScenarioReport report;
+	report.Base.resize(n);
+	report.Positions.assign(n, ScenarioCube(grid));
+
+	//	Each position writes its own cube
+	pool.ParallelFor(n, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const Position& position = portfolio[i];
+			ScenarioCube& cube = report.Positions[i];
+
+			double* values = cube.Row(0, 0);
+			ScenarioPrices(position.Contract, grid, values);
+			for (size_t k = 0; k < cube.Size(); ++k)
+			{
+				values[k] *= position.Quantity;
+			}
+			report.Base[i] = position.Quantity * ::Price(position.Contract);
+		}
+	});
+
+	//	Books, summed in portfolio order
+	unordered_map<string, size_t> books;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const string& book = portfolio[i].Book;
+		auto found = books.find(book);
+		size_t index = (found != books.end()) ? found->second : report.Books.size();
+		if (index == report.Books.size())
+		{
+			books[book] = index;
+			report.Books.push_back(book);
+			report.BookBase.push_back(0.0);
+			report.BookValues.push_back(ScenarioCube(grid));
+		}
+		report.BookBase[index] += report.Base[i];
+		report.BookValues[index].Add(report.Positions[i]);
+	}
+
+	return report;
+}
@@ -0,0 +1,297 @@
+// Implementing the functions that are defined in the header file: ScenarioKernels.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "ScenarioKernels.hpp"
+
+
+using namespace std;
+using namespace Numerics;
+
+
+//	Black-Scholes family
+OPTION_TARGET_CLONES
+void BlackLanePrices(const double* __restrict S, const double* __restrict logS, const size_t n, const double logK, const double phi,
+	const BlackLanes& lanes, const bool hasA, const bool hasC, double* __restrict out)
+{
+	const double* __restrict drift = lanes.drift;
+	const double* __restrict s = lanes.s;
+	const double* __restrict a = lanes.a;
+	const double* __restrict c = lanes.c;
+	double arg[2 * KernelLanes], N[2 * KernelLanes];
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		double d1 = (logS[i] - logK + drift[i]) / s[i];
+		arg[i] = phi * d1;
+		arg[n + i] = phi * (d1 - s[i]);
+		N[i] = 0.0;
+		N[n + i] = 0.0;
+	}
+
+	const size_t first = hasA ? 0 : n;
+	const size_t last = hasC ? 2 * n : n;
+	if (last > first)
+	{
+		NormalCdf(arg + first, N + first, last - first);
+	}
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < n; ++i)
+	{
+		out[i] = a[i] * S[i] * N[i] + c[i] * N[n + i];
+	}
+}
+
+//	Barriers
+
+//	Arguments of the CDFs, in the order of AllBarrierPrices; the last four are those of the rebate
+enum BarrierArgument { X1, X1s, X2, X2s, Y1, Y1s, MY1, MY1s, Y2, Y2s, MY2, MY2s, Z, Z2, MZ, MZ2, BarrierArguments };
+
+//	The contract terms are read at [Step * i]: Step 0 shares one contract across the lanes and Step 1 gives each lane
+//	its own
+template <bool Call, bool Out, bool Rebate, size_t Step>
+OPTION_TARGET_CLONES
+static void BarrierLoop(const double* __restrict S, const double* __restrict logS, const size_t m, const double* __restrict H,
+	const double* __restrict K, const double* __restrict logH, const double* __restrict logK, const double* __restrict cr,
+	const BarrierLanes& lanes, double* __restrict out)
+{
+	const double* __restrict s = lanes.s;
+	const double* __restrict m1s = lanes.m1s;
+	const double* __restrict twoMu = lanes.twoMu;
+	const double* __restrict twoMu1 = lanes.twoMu1;
+	const double* __restrict carry = lanes.carry;
+	const double* __restrict df = lanes.df;
+	const double* __restrict psiS = lanes.psiS;
+	const double* __restrict muPlusPsi = lanes.muPlusPsi;
+	const double* __restrict muMinusPsi = lanes.muMinusPsi;
+	const size_t arguments = Rebate ? BarrierArguments : Z;
+
+	if (m == 0)
+	{
+		return;
+	}
+
+	double arg[BarrierArguments * KernelLanes], N[BarrierArguments * KernelLanes];
+	double pow2mu1[KernelLanes], pow2mu[KernelLanes], powPlus[KernelLanes], powMinus[KernelLanes];
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < m; ++i)
+	{
+		const double invS = 1.0 / s[i];
+		const double logHS = logH[Step * i] - logS[i];
+		const double logSK = logS[i] - logK[Step * i];
+
+		double x1 = (logSK * invS) + m1s[i];
+		double x2 = (-logHS * invS) + m1s[i];
+		double y1 = ((2.0 * logHS + logSK) * invS) + m1s[i];
+		double y2 = (logHS * invS) + m1s[i];
+
+		arg[X1 * m + i] = x1;
+		arg[X1s * m + i] = x1 - s[i];
+		arg[X2 * m + i] = x2;
+		arg[X2s * m + i] = x2 - s[i];
+		arg[Y1 * m + i] = y1;
+		arg[Y1s * m + i] = y1 - s[i];
+		arg[MY1 * m + i] = -y1;
+		arg[MY1s * m + i] = s[i] - y1;
+		arg[Y2 * m + i] = y2;
+		arg[Y2s * m + i] = y2 - s[i];
+		arg[MY2 * m + i] = -y2;
+		arg[MY2s * m + i] = s[i] - y2;
+
+		pow2mu1[i] = FastExp(twoMu1[i] * logHS);
+		pow2mu[i] = FastExp(twoMu[i] * logHS);
+
+		if (Rebate)
+		{
+			double z = (logHS * invS) + psiS[i];
+			double z2 = z - (2.0 * psiS[i]);
+			arg[Z * m + i] = z;
+			arg[Z2 * m + i] = z2;
+			arg[MZ * m + i] = -z;
+			arg[MZ2 * m + i] = -z2;
+
+			powPlus[i] = FastExp(muPlusPsi[i] * logHS);
+			powMinus[i] = FastExp(muMinusPsi[i] * logHS);
+		}
+	}
+
+	NormalCdf(arg, N, arguments * m);
+
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < m; ++i)
+	{
+		const double Hi = H[Step * i], Ki = K[Step * i], cri = cr[Step * i];
+		const double Si = S[i], SC = Si * carry[i], KD = Ki * df[i];
+		const bool kAboveH = (Ki > Hi);
+		const double Nx1 = N[X1 * m + i], Nx1s = N[X1s * m + i], Nx2 = N[X2 * m + i], Nx2s = N[X2s * m + i];
+
+		double A = Call ? (SC * Nx1) - (KD * Nx1s) : (KD * (1 - Nx1s)) - (SC * (1 - Nx1));
+		double B = Call ? (SC * Nx2) - (KD * Nx2s) : (KD * (1 - Nx2s)) - (SC * (1 - Nx2));
+
+		double CDown = (SC * pow2mu1[i] * N[Y1 * m + i]) - (KD * pow2mu[i] * N[Y1s * m + i]);
+		double CUp = (SC * pow2mu1[i] * N[MY1 * m + i]) - (KD * pow2mu[i] * N[MY1s * m + i]);
+		double DDown = (SC * pow2mu1[i] * N[Y2 * m + i]) - (KD * pow2mu[i] * N[Y2s * m + i]);
+		double DUp = (SC * pow2mu1[i] * N[MY2 * m + i]) - (KD * pow2mu[i] * N[MY2s * m + i]);
+
+		double EDown = 0.0, EUp = 0.0, FDown = 0.0, FUp = 0.0;
+		if (Rebate)
+		{
+			EDown = cri * df[i] * (Nx2s - (pow2mu[i] * N[Y2s * m + i]));
+			EUp = cri * df[i] * ((1 - Nx2s) - (pow2mu[i] * N[MY2s * m + i]));
+			FDown = cri * ((powPlus[i] * N[Z * m + i]) + (powMinus[i] * N[Z2 * m + i]));
+			FUp = cri * ((powPlus[i] * N[MZ * m + i]) + (powMinus[i] * N[MZ2 * m + i]));
+		}
+
+		double outDown, outUp;
+		if (Call)
+		{
+			outDown = kAboveH ? (A - CDown + FDown) : (B - DDown + FDown);
+			outUp = kAboveH ? FUp : (A - B + CUp - DUp + FUp);
+		}
+		else
+		{
+			outDown = kAboveH ? (A - B - CDown + DDown + FDown) : FDown;
+			outUp = kAboveH ? (B + DUp + FUp) : (A + CUp + FUp);
+		}
+
+		const bool down = (Si >= Hi);
+		double outPrice = down ? outDown : outUp;
+		out[i] = Out ? outPrice : A + (down ? EDown + FDown : EUp + FUp) - outPrice;		//	in from in/out parity
+	}
+}
+
+//	The variant and the rebate are resolved once, outside the loops
+template <size_t Step>
+static void BarrierVariant(const double* S, const double* logS, const size_t n, const bool call, const bool out, const bool rebate,
+	const double* H, const double* K, const double* logH, const double* logK, const double* cr, const BarrierLanes& lanes, double* prices)
+{
+	if (call && out)
+	{
+		rebate ? BarrierLoop<true, true, true, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices)
+			: BarrierLoop<true, true, false, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices);
+	}
+	else if (call)
+	{
+		rebate ? BarrierLoop<true, false, true, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices)
+			: BarrierLoop<true, false, false, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices);
+	}
+	else if (out)
+	{
+		rebate ? BarrierLoop<false, true, true, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices)
+			: BarrierLoop<false, true, false, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices);
+	}
+	else
+	{
+		rebate ? BarrierLoop<false, false, true, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices)
+			: BarrierLoop<false, false, false, Step>(S, logS, n, H, K, logH, logK, cr, lanes, prices);
+	}
+}
+
+void BarrierLanePrices(const double* S, const double* logS, const size_t n, const BarrierContract& contract, const BarrierLanes& lanes,
+	double* out)
+{
+	BarrierVariant<0>(S, logS, n, contract.call, contract.out, contract.cr != 0.0, &contract.H, &contract.K, &contract.logH,
+		&contract.logK, &contract.cr, lanes, out);
+}
+
+void BarrierLanePrices(const double* S, const double* logS, const size_t n, const bool call, const bool out,
+	const BarrierContractLanes& contracts, const BarrierLanes& lanes, double* prices)
+{
+	bool rebate = false;
+	for (size_t i = 0; i < n; ++i)
+	{
+		rebate = rebate || (contracts.cr[i] != 0.0);
+	}
+	BarrierVariant<1>(S, logS, n, call, out, rebate, contracts.H, contracts.K, contracts.logH, contracts.logK, contracts.cr, lanes, prices);
+}
+
+
+//	Batch form over rows: each block of KernelLanes rows is priced in up to four calls, one per variant
+OPTION_TARGET_CLONES
+static void SetBarrierLanes(const double* __restrict S, const double* __restrict H, const double* __restrict K, const double* __restrict cr,
+	const double* __restrict T, const double* __restrict r, const double* __restrict sig, const double* __restrict b, const size_t m,
+	double* __restrict logS, BarrierContractLanes& contracts, BarrierLanes& lanes)
+{
+	OPTION_SIMD_LOOP
+	for (size_t i = 0; i < m; ++i)
+	{
+		logS[i] = FastLog(S[i]);
+		contracts.H[i] = H[i];
+		contracts.K[i] = K[i];
+		contracts.logH[i] = FastLog(H[i]);
+		contracts.logK[i] = FastLog(K[i]);
+		contracts.cr[i] = cr[i];
+
+		//	BarrierLanes::Set, with the fast square root
+		const double var = sig[i] * sig[i];
+		const double mu = (b[i] - (var * 0.5)) / var;
+		const double psi = FastSqrt((mu * mu) + (2.0 * r[i] / var));
+		const double s = sig[i] * FastSqrt(T[i]);
+		lanes.s[i] = s;
+		lanes.m1s[i] = (1.0 + mu) * s;
+		lanes.twoMu[i] = 2.0 * mu;
+		lanes.twoMu1[i] = 2.0 * (mu + 1.0);
+		lanes.carry[i] = FastExp((b[i] - r[i]) * T[i]);
+		lanes.df[i] = FastExp(-r[i] * T[i]);
+		lanes.psiS[i] = psi * s;
+		lanes.muPlusPsi[i] = mu + psi;
+		lanes.muMinusPsi[i] = mu - psi;
+	}
+}
+
+void BatchBarrierPrice(const double* S, const double* H, const double* K, const double* cr, const double* T, const double* r,
+	const double* sig, const double* b, const int* isCall, const int* isOut, double* price, const size_t n)
+{
+	//	Rows of one variant gathered into lanes
+	struct Block
+	{
+		double S[KernelLanes], H[KernelLanes], K[KernelLanes], cr[KernelLanes], T[KernelLanes], r[KernelLanes], sig[KernelLanes],
+			b[KernelLanes], logS[KernelLanes], prices[KernelLanes];
+		size_t row[KernelLanes];
+		BarrierContractLanes contracts;
+		BarrierLanes lanes;
+	};
+	Block block;
+
+	for (size_t start = 0; start < n; start += KernelLanes)
+	{
+		const size_t end = min(n, start + KernelLanes);
+		for (int variant = 0; variant < 4; ++variant)
+		{
+			const bool call = (variant & 1) != 0, out = (variant & 2) != 0;
+			size_t m = 0;
+			for (size_t i = start; i < end; ++i)
+			{
+				if ((isCall[i] != 0) == call && (isOut[i] != 0) == out)
+				{
+					block.S[m] = S[i];
+					block.H[m] = H[i];
+					block.K[m] = K[i];
+					block.cr[m] = cr[i];
+					block.T[m] = T[i];
+					block.r[m] = r[i];
+					block.sig[m] = sig[i];
+					block.b[m] = b[i];
+					block.row[m] = i;
+					++m;
+				}
+			}
+			if (m == 0)
+			{
+				continue;
+			}
+
+			SetBarrierLanes(block.S, block.H, block.K, block.cr, block.T, block.r, block.sig, block.b, m, block.logS, block.contracts,
+				block.lanes);
+			BarrierLanePrices(block.S, block.logS, m, call, out, block.contracts, block.lanes, block.prices);
+			for (size_t i = 0; i < m; ++i)
+			{
+				price[block.row[i]] = block.prices[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,63 @@
+// Sobol low-discrepancy sequence for quasi-Monte Carlo, with optional Owen scrambling
+//
+// (c) Sudhansh Dua
+//
+//	Coordinate d of point n of the sequence is the XOR of the direction numbers V_d[b] of the bits b set in n, as a
+//	32-bit binary fraction. The direction numbers of the first dimension are V[b] = 2^(31 - b); those of the others
+//	come from the primitive polynomials and initial values of Joe & Kuo (2008), file new-joe-kuo-6.21201, which give
+//	good two-dimensional projections. The first SobolMaxDimension dimensions are tabulated (Sobol.cpp).
+//
+//	Every point is computed directly from its index, so a block of paths needs no state from the blocks before it,
+//	and the bulk form fills a block of points one point per lane of a vectorised loop. The first 2^m points of any
+//	dimension put exactly one point in each interval [k / 2^m, (k + 1) / 2^m): path counts that are powers of two
+//	(and blocks of MonteCarloBlock paths) get the full benefit of the sequence.
+//
+//	Scrambling: a nested uniform (Owen 1995) scramble randomises the points while keeping their equidistribution,
+//	which removes the bias of the unscrambled sequence and lets independent scrambles (seeds) measure the error.
+//	It is computed by hashing, in the form of Burley (2020), "Practical hash-based Owen scrambling": the bits of the
+//	coordinate are reversed, put through the Laine-Karras permutation keyed by a per-dimension seed (which only
+//	lets a bit depend on the bits above it) and reversed back.
+//
+//	Uniforms are (k + 1/2) / 2^32 for the 32-bit coordinate k, strictly inside (0, 1); normals come from them by
+//	Numerics::InverseNormalCdf, which keeps the ordering and therefore the stratification of the points.
+
+
+#ifndef Sobol_HPP
+#define Sobol_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+
+const size_t SobolMaxDimension = 1024;
+
+
+class SobolSequence
+{
+private:
+	size_t dimensions;
+	vector<uint32_t> directions;		//	32 direction numbers per dimension
+	vector<uint32_t> seeds;				//	scrambling seed of each dimension; empty if the sequence is not scrambled
+
+public:
+	//	Throws invalid_argument unless 1 <= dimensions <= SobolMaxDimension
+	SobolSequence(const size_t dimensions1, const bool scramble = false, const uint64_t seed = 1);
+
+	size_t Dimensions() const;
+	bool Scrambled() const;
+
+	//	Coordinate of point index in dimension d, as a 32-bit binary fraction; throws invalid_argument unless
+	//	d < Dimensions()
+	uint32_t Coordinate(const uint64_t index, const size_t d) const;
+
+	//	Bulk forms for count points from firstPoint and dimensions [firstDimension, firstDimension + dims), laid out
+	//	dimension by dimension, out[d * count + i], as Random.hpp lays out the draws of its paths. Points are indexed
+	//	modulo 2^32. Throws invalid_argument unless firstDimension + dims <= Dimensions().
+	void FillUniforms(const uint64_t firstPoint, const size_t count, const size_t firstDimension, const size_t dims, double* out) const;
+	void FillNormals(const uint64_t firstPoint, const size_t count, const size_t firstDimension, const size_t dims, double* out) const;
+};
+
+#endif
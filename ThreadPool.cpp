@@ -0,0 +1,182 @@
+// Implementing the class that is defined in the header file: ThreadPool.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "ThreadPool.hpp"
+#include <exception>
+
+
+using namespace std;
+
+
+//	Constructors and destructor
+ThreadPool::ThreadPool() : ThreadPool(thread::hardware_concurrency()) {}
+
+ThreadPool::ThreadPool(const size_t threads) : queued(0), stop(false)
+{
+	for (size_t i = 0; i < threads; ++i)
+	{
+		queues.emplace_back(new Queue);
+	}
+	for (size_t i = 0; i < threads; ++i)
+	{
+		workers.emplace_back(&ThreadPool::Run, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> guard(sleepLock);
+		stop = true;
+	}
+	wake.notify_all();
+
+	for (thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+
+size_t ThreadPool::Size() const
+{
+	return workers.size();
+}
+
+
+//	Task queues
+bool ThreadPool::Pop(const size_t index, Task& task)
+{
+	Queue& queue = *queues[index];
+	lock_guard<mutex> guard(queue.lock);
+	if (queue.tasks.empty())
+	{
+		return false;
+	}
+	task = move(queue.tasks.back());
+	queue.tasks.pop_back();
+	queued.fetch_sub(1);
+	return true;
+}
+
+bool ThreadPool::Steal(const size_t thief, Task& task)
+{
+	const size_t count = queues.size();
+	for (size_t k = 1; k <= count; ++k)
+	{
+		size_t victim = (thief + k) % count;		//	start with the next worker, so thieves spread out
+		if (victim == thief)
+		{
+			continue;
+		}
+
+		Queue& queue = *queues[victim];
+		lock_guard<mutex> guard(queue.lock);
+		if (!queue.tasks.empty())
+		{
+			task = move(queue.tasks.front());
+			queue.tasks.pop_front();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void ThreadPool::Run(const size_t index)
+{
+	Task task;
+	while (true)
+	{
+		if (Pop(index, task) || Steal(index, task))
+		{
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		unique_lock<mutex> guard(sleepLock);
+		wake.wait(guard, [this] { return stop || queued.load() > 0; });
+		if (stop && queued.load() == 0)
+		{
+			return;
+		}
+	}
+}
+
+
+void ThreadPool::ParallelFor(const size_t n, const size_t chunk, const function<void(size_t, size_t)>& body)
+{
+	const size_t step = (chunk == 0) ? 1 : chunk;
+	const size_t chunks = (n + step - 1) / step;
+
+	if (workers.empty() || chunks <= 1)
+	{
+		for (size_t begin = 0; begin < n; begin += step)
+		{
+			body(begin, (n - begin < step) ? n : begin + step);
+		}
+		return;
+	}
+
+	atomic<size_t> remaining(chunks);
+	exception_ptr error;
+	mutex errorLock;
+
+	//	Worker w receives the w-th contiguous block of chunks
+	const size_t count = queues.size();
+	for (size_t c = 0; c < chunks; ++c)
+	{
+		size_t begin = c * step;
+		size_t end = (n - begin < step) ? n : begin + step;
+
+		Task task = [&body, &remaining, &error, &errorLock, begin, end]
+		{
+			try
+			{
+				body(begin, end);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> guard(errorLock);
+				if (!error)
+				{
+					error = current_exception();
+				}
+			}
+			remaining.fetch_sub(1);
+		};
+
+		Queue& queue = *queues[(c * count) / chunks];
+		lock_guard<mutex> guard(queue.lock);
+		queue.tasks.push_back(move(task));
+		queued.fetch_add(1);
+	}
+	{
+		lock_guard<mutex> guard(sleepLock);			//	no worker can miss the wake-up between its check and its wait
+	}
+	wake.notify_all();
+
+	//	The calling thread steals until every chunk has been taken, then waits for the last ones to finish
+	Task task;
+	while (remaining.load() > 0)
+	{
+		if (Steal(count, task))
+		{
+			task();
+			task = nullptr;
+		}
+		else
+		{
+			this_thread::yield();
+		}
+	}
+
+	if (error)
+	{
+		rethrow_exception(error);
+	}
+}
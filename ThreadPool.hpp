@@ -0,0 +1,67 @@
+// Class that defines a work-stealing thread pool
+//
+// (c) Sudhansh Dua
+//
+//	Every worker owns a queue of tasks. A worker takes its own tasks newest first and, when its queue is empty,
+//	steals the oldest task of another worker. ParallelFor splits a range into chunks, hands each worker a contiguous
+//	block of chunks and lets idle workers (and the calling thread) steal the rest, so uneven chunks balance out.
+
+
+#ifndef ThreadPool_HPP
+#define ThreadPool_HPP
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+class ThreadPool
+{
+private:
+	typedef function<void()> Task;
+
+	struct Queue
+	{
+		mutex lock;
+		deque<Task> tasks;
+	};
+
+	vector<unique_ptr<Queue>> queues;		//	one queue per worker
+	vector<thread> workers;
+
+	mutex sleepLock;						//	guards stop and the sleeping workers
+	condition_variable wake;
+	atomic<size_t> queued;					//	tasks waiting in all queues
+	bool stop;
+
+	bool Pop(const size_t index, Task& task);		//	newest task of queue index
+	bool Steal(const size_t thief, Task& task);		//	oldest task of any other queue
+	void Run(const size_t index);					//	worker loop
+
+public:
+	//	Constructors and destructor
+	ThreadPool();											//	one worker per hardware thread
+	explicit ThreadPool(const size_t threads);				//	0 runs everything on the calling thread
+	ThreadPool(const ThreadPool& pool) = delete;
+	~ThreadPool();											//	finishes the queued tasks and joins the workers
+
+	ThreadPool& operator = (const ThreadPool& pool) = delete;
+
+	size_t Size() const;			//	number of worker threads
+
+	//	Calls body(begin, end) for consecutive chunks [begin, end) of [0, n), each at most chunk long, and returns
+	//	when all of them are done. The calling thread works on the chunks too. If a chunk throws, the first
+	//	exception is rethrown here after the remaining chunks have finished.
+	void ParallelFor(const size_t n, const size_t chunk, const function<void(size_t, size_t)>& body);
+};
+
+
+#endif
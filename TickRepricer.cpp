@@ -0,0 +1,180 @@
+// Implementing the class that is defined in the header file: TickRepricer.hpp
+//
+// (c) Sudhansh Dua
+
+
+#include "TickRepricer.hpp"
+#include <cmath>
+#include <type_traits>
+
+
+using namespace std;
+
+
+//	TickSettings
+TickSettings::TickSettings() : MaxMove(0.01), ErrorBound(1e-4) {}
+
+TickSettings::TickSettings(const double maxMove, const double errorBound) : MaxMove(maxMove), ErrorBound(errorBound) {}
+
+
+//	Spot of a product
+static void SetSpot(Product& product, const double S)
+{
+	visit([S](auto& option) { option.S = S; }, product);
+}
+
+static double GetSpot(const Product& product)
+{
+	return visit([](const auto& option) { return option.S; }, product);
+}
+
+
+//	Constructors and destructor
+TickRepricer::TickRepricer(const Product& product, const TickSettings& settings1)
+	: contract(product), settings(settings1), S0(0.0), V0(0.0), delta(0.0), gamma(0.0), speed(0.0), speed2(0.0), barrier(false), H(0.0),
+	S(0.0), V(0.0), hits(0), full(0)
+{
+	Reset(product);
+}
+
+TickRepricer::TickRepricer(const TickRepricer& repricer)
+	: contract(repricer.contract), settings(repricer.settings), S0(repricer.S0), V0(repricer.V0), delta(repricer.delta),
+	gamma(repricer.gamma), speed(repricer.speed), speed2(repricer.speed2), barrier(repricer.barrier), H(repricer.H), S(repricer.S), V(repricer.V),
+	hits(repricer.hits), full(repricer.full) {}
+
+TickRepricer::~TickRepricer() {}
+
+TickRepricer& TickRepricer::operator = (const TickRepricer& repricer)
+{
+	if (this == &repricer)
+	{
+		return *this;
+	}
+
+	contract = repricer.contract;
+	settings = repricer.settings;
+	S0 = repricer.S0;
+	V0 = repricer.V0;
+	delta = repricer.delta;
+	gamma = repricer.gamma;
+	speed = repricer.speed;
+	speed2 = repricer.speed2;
+	barrier = repricer.barrier;
+	H = repricer.H;
+	S = repricer.S;
+	V = repricer.V;
+	hits = repricer.hits;
+	full = repricer.full;
+
+	return *this;
+}
+
+
+void TickRepricer::Revalue(const double S1)
+{
+	SetSpot(contract, S1);
+	OptionGreeks greeks = ::Greeks(contract);
+
+	//	Speed and its slope by central differences of the (exact) Gamma
+	const double h = S1 * TickSpeedBump;
+	Product bumped(contract);
+	SetSpot(bumped, S1 + h);
+	double gammaUp = ::Greeks(bumped).Gamma;
+	SetSpot(bumped, S1 - h);
+	double gammaDown = ::Greeks(bumped).Gamma;
+
+	S0 = S1;
+	V0 = greeks.Price;
+	delta = greeks.Delta;
+	gamma = greeks.Gamma;
+	speed = (gammaUp - gammaDown) / (2.0 * h);
+	speed2 = (gammaUp - 2.0 * gamma + gammaDown) / (h * h);
+
+	S = S1;
+	V = V0;
+	++full;
+}
+
+
+double TickRepricer::Tick(const double S1)
+{
+	const double dS = S1 - S0;
+	const bool sameSide = !barrier || ((S1 >= H) == (S0 >= H));
+
+	//	A NaN Gamma or speed fails the comparison and falls back too
+	if (sameSide && fabs(dS) <= settings.MaxMove * S0 && ErrorEstimate(S1) <= settings.ErrorBound)
+	{
+		S = S1;
+		V = V0 + dS * (delta + 0.5 * gamma * dS);
+		++hits;
+		return V;
+	}
+
+	Revalue(S1);
+	return V;
+}
+
+
+void TickRepricer::Reset(const Product& product)
+{
+	contract = product;
+	barrier = holds_alternative<BarrierOption>(contract);
+	H = barrier ? get<BarrierOption>(contract).H : 0.0;
+	Revalue(GetSpot(contract));
+}
+
+
+double TickRepricer::Price() const
+{
+	return V;
+}
+
+double TickRepricer::Spot() const
+{
+	return S;
+}
+
+double TickRepricer::Delta() const
+{
+	return delta + gamma * (S - S0);
+}
+
+double TickRepricer::Gamma() const
+{
+	return gamma;
+}
+
+double TickRepricer::ErrorEstimate(const double S1) const
+{
+	//	The third- and fourth-order remainder terms, with a margin for the higher orders and the differencing error
+	const double dS = fabs(S1 - S0);
+	return TickErrorMargin * (fabs(speed) / 6.0 + fabs(speed2) * dS / 24.0) * dS * dS * dS;
+}
+
+
+const Product& TickRepricer::Contract() const
+{
+	return contract;
+}
+
+
+size_t TickRepricer::Hits() const
+{
+	return hits;
+}
+
+size_t TickRepricer::FullValuations() const
+{
+	return full;
+}
+
+double TickRepricer::HitRate() const
+{
+	return (hits + full == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + full);
+}
+
+void TickRepricer::ResetCounters()
+{
+	hits = 0;
+	full = 0;
+}
@@ -0,0 +1,95 @@
+// Incremental repricing of a product on spot ticks, from cached Greeks with an error-bounded fallback
+//
+// (c) Sudhansh Dua
+//
+//	A TickRepricer keeps the last full valuation of a product at the spot S0: the price V0, Delta and Gamma
+//	(Greeks(product), PortfolioPricer.hpp), and the speed dGamma/dS and its slope from central differences of Gamma at
+//	S0 (1 +- TickSpeedBump). A tick to spot S = S0 + dS is answered by the second-order Taylor update
+//		V = V0 + Delta dS + Gamma dS^2 / 2
+//	as long as
+//	->	the move is small: |dS| <= MaxMove S0
+//	->	the estimated error, the third- and fourth-order remainder terms times TickErrorMargin, is within ErrorBound;
+//		the margin covers the higher orders and the differencing, so the actual error stays within the bound
+//	->	for a barrier option, the spot stays on the same side of the barrier (the price is not smooth across it)
+//	Otherwise the product is repriced in full at S, which becomes the new S0. The updates always start from S0, so
+//	errors do not build up from tick to tick. Digital-like payoffs near expiry have a large speed and fall back on
+//	their own.
+//
+//	Only the spot is cached against: a change of any other market input (volatility, rates, time) needs Reset() with
+//	the updated contract. A full valuation costs three Greeks() calls; a Taylor update a few nanoseconds. The counters
+//	report how the ticks were answered, to tune MaxMove and ErrorBound against a latency budget
+//	(tools/TickBenchmark.cpp).
+
+
+#ifndef TickRepricer_HPP
+#define TickRepricer_HPP
+
+
+#include "PortfolioPricer.hpp"
+#include <cstddef>
+using namespace std;
+
+
+const double TickSpeedBump = 1e-3;		//	relative spot bump of the finite-difference speed
+const double TickErrorMargin = 1.5;		//	safety factor on the estimated error of a Taylor update
+
+
+struct TickSettings
+{
+	double MaxMove;			//	largest relative move from S0 answered by the Taylor update (default 0.01)
+	double ErrorBound;		//	largest error of an update, in price units (default 1e-4)
+
+	TickSettings();
+	TickSettings(const double maxMove, const double errorBound);
+};
+
+
+class TickRepricer
+{
+private:
+	Product contract;			//	with S at the last full valuation
+	TickSettings settings;
+
+	//	Cached at the last full valuation
+	double S0, V0, delta, gamma, speed, speed2;		//	speed2 = d(speed)/dS
+	bool barrier;				//	barrier option, with its barrier at H
+	double H;
+
+	//	Last answer
+	double S, V;
+
+	size_t hits, full;
+
+	void Revalue(const double S1);		//	full valuation at S1
+
+public:
+	//	Constructors and destructor
+	explicit TickRepricer(const Product& product, const TickSettings& settings1 = TickSettings());		//	values the product in full
+	TickRepricer(const TickRepricer& repricer);
+	~TickRepricer();
+
+	TickRepricer& operator = (const TickRepricer& repricer);
+
+	//	Price at spot S1: a Taylor update from the cache, or a full valuation that refreshes it
+	double Tick(const double S1);
+
+	//	New contract terms (or a move of the other market inputs): values it in full at its own spot
+	void Reset(const Product& product);
+
+	double Price() const;			//	last answer
+	double Spot() const;			//	spot of the last answer
+	double Delta() const;			//	Delta + Gamma dS at the last spot
+	double Gamma() const;			//	cached Gamma
+	double ErrorEstimate(const double S1) const;		//	estimated error of a Taylor update to S1
+
+	const Product& Contract() const;		//	contract at the spot of the last full valuation
+
+	//	Counters: ticks answered from the cache, and full valuations (the constructor's and Reset's included)
+	size_t Hits() const;
+	size_t FullValuations() const;
+	double HitRate() const;			//	hits / (hits + full)
+	void ResetCounters();
+};
+
+
+#endif
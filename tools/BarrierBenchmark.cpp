@@ -0,0 +1,162 @@
+// Convergence and throughput of the barrier Monte Carlo engine against the closed forms
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/BarrierBenchmark.cpp BarrierMonteCarlo.cpp BarrierOption.cpp Option.cpp
+//			MonteCarlo.cpp Numerics.cpp Random.cpp Sobol.cpp BrownianBridge.cpp ThreadPool.cpp -o BarrierBenchmark
+//	and run as BarrierBenchmark [threads] (one per hardware thread by default).
+//
+//	The report has three parts:
+//	->	convergence: a continuously monitored barrier priced on grids of 1 to 64 steps with 10^4 to 10^6 paths,
+//		against BarrierOption::Price(). Without a rebate the Brownian-bridge estimator is unbiased on any grid, so the
+//		error stays within a few standard errors; with an out rebate the step grid shows as a bias in the timing of
+//		the payment. Throughput is in millions of path-steps per second.
+//	->	all eight variants, with and without rebate, on a 16-step grid
+//	->	daily monitoring (252 dates) simulated exactly, against the Broadie-Glasserman-Kou correction
+//		(BarrierOption::DiscretePrice) and the continuous closed form
+
+
+#include "BarrierMonteCarlo.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static string Name(const BarrierOption& option)
+{
+	string name = (option.S >= option.H) ? "Down-and-" : "Up-and-";
+	name += (option.InOrOut == BarrierType::In) ? "In " : "Out ";
+	name += (option.type == OptionType::Call) ? "Call" : "Put";
+	return name;
+}
+
+
+int main(int argc, char* argv[])
+{
+	ThreadPool pool((argc > 1) ? static_cast<size_t>(atoi(argv[1])) : thread::hardware_concurrency());
+
+	cout << fixed;
+
+	//	Closed form
+	BarrierOption option(100.0, 95.0, 100.0, 0.0, 1.0, 0.08, 0.25, 0.04, OptionType::Call, BarrierType::Out);
+	double exact = 0.0;
+	const size_t calls = 1000000;
+	double seconds = Time([&]()
+	{
+		for (size_t i = 0; i < calls; ++i)
+		{
+			option.S = 100.0 + 1e-9 * static_cast<double>(i % 2);
+			exact += option.Price();
+		}
+	});
+	option.S = 100.0;
+	exact = option.Price();
+
+	cout << "Barrier Monte Carlo against BarrierOption::Price(), " << pool.Size() << " worker thread(s)" << endl << endl;
+	cout << Name(option) << ", S = 100, H = 95, K = 100, T = 1, r = 0.08, sig = 0.25, b = 0.04" << endl;
+	cout << "Closed form: " << setprecision(6) << exact << " (" << setprecision(1) << 1e9 * seconds / calls << " ns per price)" << endl;
+
+	//	Convergence on a continuously monitored barrier
+	for (double cr : { 0.0, 3.0 })
+	{
+		option.cr = cr;
+		exact = option.Price();
+
+		cout << endl << "Continuous monitoring, rebate " << setprecision(1) << cr << ", closed form " << setprecision(6) << exact << endl;
+		cout << left << setw(8) << "steps" << setw(10) << "paths" << setw(12) << "price" << setw(12) << "std error"
+			<< setw(12) << "error" << setw(12) << "error / se" << "Mpath-steps/s" << right << endl;
+
+		for (size_t steps : { 1, 4, 16, 64 })
+		{
+			for (size_t paths : { 10000, 100000, 1000000 })
+			{
+				MonteCarloSettings settings;
+				settings.Paths = paths;
+
+				MonteCarloResult result;
+				seconds = Time([&]() { result = BarrierMonteCarloPrice(option, BarrierMonitoring::Continuous, steps, settings, pool); });
+
+				double error = result.Price - exact;
+				cout << left << setw(8) << steps << setw(10) << paths << setprecision(6) << setw(12) << result.Price
+					<< setw(12) << result.StdError << setw(12) << error << setprecision(2) << setw(12) << error / result.StdError
+					<< setprecision(1) << 1e-6 * static_cast<double>(paths * steps) / seconds << right << endl;
+			}
+		}
+	}
+
+	//	The eight variants
+	cout << endl << "All variants, continuous monitoring, 16 steps, 10^6 paths (K = 100, H = 95 or 105)" << endl;
+	cout << left << setw(22) << "variant" << setw(8) << "rebate" << setw(12) << "closed form" << setw(12) << "Monte Carlo"
+		<< setw(12) << "std error" << "error / se" << right << endl;
+
+	for (double H : { 95.0, 105.0 })
+	{
+		for (BarrierType InOrOut : { BarrierType::In, BarrierType::Out })
+		{
+			for (OptionType type : { OptionType::Call, OptionType::Put })
+			{
+				for (double cr : { 0.0, 3.0 })
+				{
+					BarrierOption variant(100.0, H, 100.0, cr, 1.0, 0.08, 0.25, 0.04, type, InOrOut);
+					MonteCarloSettings settings;
+					settings.Paths = 1000000;
+
+					exact = variant.Price();
+					MonteCarloResult result = BarrierMonteCarloPrice(variant, BarrierMonitoring::Continuous, 16, settings, pool);
+
+					cout << left << setw(22) << Name(variant) << setprecision(1) << setw(8) << cr << setprecision(6) << setw(12) << exact
+						<< setw(12) << result.Price << setw(12) << result.StdError << setprecision(2) << (result.Price - exact) / result.StdError
+						<< right << endl;
+				}
+			}
+		}
+	}
+
+	//	Daily monitoring
+	const size_t dates = 252;
+	cout << endl << "Daily monitoring (" << dates << " dates), 10^6 paths" << endl;
+	cout << left << setw(22) << "variant" << setw(8) << "rebate" << setw(12) << "Monte Carlo" << setw(12) << "std error"
+		<< setw(12) << "BGK" << setw(12) << "continuous" << "BGK error / se" << right << endl;
+
+	for (double H : { 95.0, 105.0 })
+	{
+		for (BarrierType InOrOut : { BarrierType::In, BarrierType::Out })
+		{
+			for (OptionType type : { OptionType::Call, OptionType::Put })
+			{
+				BarrierOption variant(100.0, H, 100.0, 3.0, 1.0, 0.08, 0.25, 0.04, type, InOrOut);
+				MonteCarloSettings settings;
+				settings.Paths = 1000000;
+
+				MonteCarloResult result;
+				seconds = Time([&]() { result = BarrierMonteCarloPrice(variant, BarrierMonitoring::Discrete, dates, settings, pool); });
+				double corrected = variant.DiscretePrice(dates);
+
+				cout << left << setw(22) << Name(variant) << setprecision(1) << setw(8) << variant.cr << setprecision(6) << setw(12) << result.Price
+					<< setw(12) << result.StdError << setw(12) << corrected << setw(12) << variant.Price() << setprecision(2)
+					<< (corrected - result.Price) / result.StdError << right << endl;
+			}
+		}
+	}
+	cout << endl << "Throughput at " << dates << " steps: " << setprecision(1)
+		<< 1e-6 * static_cast<double>(1000000 * dates) / seconds << " Mpath-steps/s" << endl;
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+// Chebyshev proxies of barrier, chooser and gap prices against the exact kernels
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/ChebyshevBenchmark.cpp ChebyshevProxy.cpp PortfolioPricer.cpp PortfolioStore.cpp
+//			ScenarioKernels.cpp Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp BarrierOption.cpp
+//			DigitalOption.cpp AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp
+//			AmericanApproxOption.cpp ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o ChebyshevBenchmark
+//
+//	Each contract gets proxies over a spot box alone and over spot x vol, spot x vol x time and all four axes, at two
+//	degrees. The report gives the time to build, the number of coefficients, the error bound the proxy reports, the
+//	largest error over 100,000 random points of the box, and the time per price of the proxy and of the exact kernel
+//	at those points. A last line per contract checks that a spot outside the box is priced by the exact kernel.
+
+
+#include "ChebyshevProxy.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//	Box of the given axes (spot, vol, time, rate) around the contract, with degree n on the spot, n / 2 on the vol and the time and n / 4 on the rate
+static ProxyBox Box(const double S, const double sig, const double T, const double r, const size_t axes, const size_t n, const double lowerSpot)
+{
+	ProxyBox box;
+	box.Spot = ChebyshevAxis(lowerSpot, 1.25 * S, n);
+	if (axes > 1)
+	{
+		box.Vol = ChebyshevAxis(sig - 0.05, sig + 0.05, n / 2);
+	}
+	if (axes > 2)
+	{
+		box.Time = ChebyshevAxis(T - 30.0 / 365.0, T, n / 2);
+	}
+	if (axes > 3)
+	{
+		box.Rate = ChebyshevAxis(r - 0.01, r + 0.01, n / 4);
+	}
+	return box;
+}
+
+
+int main()
+{
+	struct Case
+	{
+		string name;
+		Product contract;
+		double lowerSpot;
+	};
+
+	vector<Case> cases =
+	{
+		{ "Down-and-out call", BarrierOption(100.0, 90.0, 100.0, 0.0, 0.5, 0.05, 0.25, 0.03, OptionType::Call, BarrierType::Out), 90.0 },
+		{ "Down-and-in put, rebate", BarrierOption(100.0, 90.0, 100.0, 2.0, 0.5, 0.05, 0.25, 0.03, OptionType::Put, BarrierType::In), 90.0 },
+		{ "Chooser", ChooserOption(100.0, 100.0, 0.5, 0.25, 0.05, 0.25, 0.03), 75.0 },
+		{ "Gap call", GapOption(100.0, 105.0, 100.0, 0.5, 0.05, 0.25, 0.03, OptionType::Call), 75.0 },
+	};
+
+	const size_t samples = 100000;
+	mt19937_64 generator(7);
+	uniform_real_distribution<double> u(0.0, 1.0);
+
+	cout << fixed;
+	for (const Case& c : cases)
+	{
+		double S = 0.0, sig = 0.0, T = 0.0, r = 0.0;
+		visit([&](const auto& option) { S = option.S; sig = option.sig; T = option.T; r = option.r; }, c.contract);
+
+		cout << endl << c.name << endl;
+		cout << left << setw(8) << "axes" << setw(8) << "degree" << setw(10) << "build ms" << setw(8) << "coefs" << setw(12) << "bound"
+			<< setw(12) << "max error" << setw(12) << "proxy ns" << "exact ns" << right << endl;
+
+		for (size_t axes = 1; axes <= 4; ++axes)
+		{
+			for (size_t n : { 12, 24 })
+			{
+				ProxyBox box = Box(S, sig, T, r, axes, n, c.lowerSpot);
+				ChebyshevProxy* proxy = nullptr;
+				double build = Time([&]() { proxy = new ChebyshevProxy(c.contract, box); });
+
+				//	Random points of the box; fixed axes at the contract's values
+				vector<double> points(4 * samples);
+				const ChebyshevAxis* ranges[4] = { &box.Spot, &box.Vol, &box.Time, &box.Rate };
+				const double values[4] = { S, sig, T, r };
+				for (size_t i = 0; i < samples; ++i)
+				{
+					for (size_t a = 0; a < 4; ++a)
+					{
+						const ChebyshevAxis& range = *ranges[a];
+						points[4 * i + a] = (range.Degree == 0) ? values[a] : range.Lower + (range.Upper - range.Lower) * u(generator);
+					}
+				}
+
+				vector<double> approximate(samples), exact(samples);
+				double proxyTime = Time([&]()
+				{
+					for (size_t i = 0; i < samples; ++i)
+					{
+						const double* p = &points[4 * i];
+						approximate[i] = proxy->Price(p[0], p[1], p[2], p[3]);
+					}
+				});
+				double exactTime = Time([&]()
+				{
+					for (size_t i = 0; i < samples; ++i)
+					{
+						const double* p = &points[4 * i];
+						exact[i] = proxy->ExactPrice(p[0], p[1], p[2], p[3]);
+					}
+				});
+
+				double maxError = 0.0;
+				for (size_t i = 0; i < samples; ++i)
+				{
+					maxError = max(maxError, fabs(approximate[i] - exact[i]));
+				}
+
+				cout << left << setw(8) << axes << setw(8) << n << setprecision(1) << setw(10) << 1e3 * build << setw(8) << proxy->Coefficients()
+					<< scientific << setprecision(2) << setw(12) << proxy->ErrorBound() << setw(12) << maxError << fixed << setprecision(1)
+					<< setw(12) << 1e9 * proxyTime / samples << 1e9 * exactTime / samples << right << endl;
+
+				delete proxy;
+			}
+		}
+
+		ChebyshevProxy proxy(c.contract, Box(S, sig, T, r, 1, 24, c.lowerSpot));
+		const double outside = 1.5 * S;
+		cout << "Outside the box, S = " << setprecision(1) << outside << ": proxy " << setprecision(10) << proxy.Price(outside)
+			<< ", exact " << proxy.ExactPrice(outside, sig, T, r) << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+// CachedEuropeanOption accessors against the stateless global kernels
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -I. tools/EuropeanCacheBenchmark.cpp CachedEuropeanOption.cpp EuropeanOption.cpp Option.cpp ImpliedVolatility.cpp
+//			Numerics.cpp -o EuropeanCacheBenchmark
+//
+//	Three access patterns, 1,000,000 steps each: Price, Delta, Gamma and Vega called back to back on an unchanged
+//	option; a spot tick followed by Price and Delta; and a vol move followed by Price and Vega. Each step is timed
+//	through the member functions, which share the memoised terms, and through CallPrice, CallDelta, ... (each of which
+//	recomputes d1 and its factors). The report gives the time per step, the cache hit rate and the largest difference.
+
+
+#include "CachedEuropeanOption.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+int main()
+{
+	const size_t steps = 1000000;
+	const double K = 100.0, T = 0.5, r = 0.05, b = 0.03;
+
+	mt19937_64 generator(11);
+	normal_distribution<double> z(0.0, 1.0);
+	vector<double> spots(steps), vols(steps);
+	double S = 100.0, sig = 0.2;
+	for (size_t i = 0; i < steps; ++i)
+	{
+		S *= exp(1e-4 * z(generator));
+		sig = max(0.05, sig + 1e-4 * z(generator));
+		spots[i] = S;
+		vols[i] = sig;
+	}
+
+	cout << left << setw(28) << "pattern" << setw(14) << "members ns" << setw(14) << "globals ns" << setw(10) << "speedup"
+		<< setw(10) << "hit rate" << "max difference" << right << endl;
+
+	auto report = [](const string& name, const double members, const double globals, const double hitRate, const double difference)
+	{
+		cout << left << fixed << setprecision(1) << setw(28) << name << setw(14) << 1e9 * members / steps << setw(14)
+			<< 1e9 * globals / steps << setprecision(2) << setw(10) << globals / members << setprecision(3) << setw(10) << hitRate
+			<< scientific << setprecision(2) << difference << right << endl;
+	};
+
+	//	Price, Delta, Gamma and Vega of an unchanged option
+	{
+		CachedEuropeanOption option(EuropeanOption(100.0, K, T, r, 0.2, b, OptionType::Call));
+		double sum = 0.0, check = 0.0;
+		double members = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				sum += option.Price() + option.Delta() + option.Gamma() + option.Vega();
+			}
+		});
+		double globals = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				check += CallPrice(100.0, K, T, r, 0.2, b) + CallDelta(100.0, K, T, r, 0.2, b) + CallGamma(100.0, K, T, r, 0.2, b)
+					+ CallVega(100.0, K, T, r, 0.2, b);
+			}
+		});
+		report("unchanged, 4 accessors", members, globals, option.CacheHitRate(), fabs(sum - check) / steps);
+	}
+
+	//	Spot ticks: Price and Delta after each
+	{
+		CachedEuropeanOption option(EuropeanOption(100.0, K, T, r, 0.2, b, OptionType::Call));
+		double difference = 0.0;
+		vector<double> prices(steps), deltas(steps);
+		double members = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				option.SetSpot(spots[i]);
+				prices[i] = option.Price();
+				deltas[i] = option.Delta();
+			}
+		});
+		double globals = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				double price = CallPrice(spots[i], K, T, r, 0.2, b);
+				double delta = CallDelta(spots[i], K, T, r, 0.2, b);
+				difference = max(difference, fabs(price - prices[i]) + fabs(delta - deltas[i]));
+			}
+		});
+		report("spot tick, Price + Delta", members, globals, option.CacheHitRate(), difference);
+	}
+
+	//	Vol moves: Price and Vega after each
+	{
+		CachedEuropeanOption option(EuropeanOption(100.0, K, T, r, 0.2, b, OptionType::Call));
+		double difference = 0.0;
+		vector<double> prices(steps), vegas(steps);
+		double members = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				option.SetVol(vols[i]);
+				prices[i] = option.Price();
+				vegas[i] = option.Vega();
+			}
+		});
+		double globals = Time([&]()
+		{
+			for (size_t i = 0; i < steps; ++i)
+			{
+				double price = CallPrice(100.0, K, T, r, vols[i], b);
+				double vega = CallVega(100.0, K, T, r, vols[i], b);
+				difference = max(difference, fabs(price - prices[i]) + fabs(vega - vegas[i]));
+			}
+		});
+		report("vol move, Price + Vega", members, globals, option.CacheHitRate(), difference);
+	}
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+// Accuracy report for the Gaussian functions in Numerics.hpp against boost::math
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O2 -I. tools/NormalAccuracy.cpp Numerics.cpp -o NormalAccuracy
+//
+//	For every accuracy tier of N(x), and for n(x), the report gives the largest absolute and relative error
+//	over a set of regions covering the whole double range, and the largest difference between the packed
+//	(array) forms and the scalar forms (the packed forms may use FMA instructions, the scalar forms need not).
+
+
+#include "Numerics.hpp"
+#include <boost/math/distributions.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+using namespace boost::math;
+
+
+struct Region
+{
+	string name;
+	vector<double> x;
+};
+
+struct Errors
+{
+	double maxAbs = 0.0;
+	double maxRel = 0.0;
+	double worstX = 0.0;
+};
+
+
+//	Points on a uniform grid [lo, hi]
+vector<double> Uniform(double lo, double hi, size_t n)
+{
+	vector<double> x(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		x[i] = lo + (hi - lo) * i / (n - 1);
+	}
+	return x;
+}
+
+//	Points on a logarithmic grid lo .. hi, both signs
+vector<double> Logarithmic(double lo, double hi, size_t n)
+{
+	vector<double> x;
+	double step = pow(hi / lo, 1.0 / (n - 1));
+	for (double v = lo; v <= hi; v *= step)
+	{
+		x.push_back(v);
+		x.push_back(-v);
+	}
+	return x;
+}
+
+
+Errors Compare(const vector<double>& x, const vector<double>& approx, const vector<double>& exact)
+{
+	Errors e;
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		double abs_err = fabs(approx[i] - exact[i]);
+		double rel_err = (exact[i] >= numeric_limits<double>::min()) ? abs_err / exact[i] : 0.0;
+		if (abs_err > e.maxAbs || (isnan(approx[i]) != isnan(exact[i])))
+		{
+			e.maxAbs = (isnan(approx[i]) != isnan(exact[i])) ? numeric_limits<double>::infinity() : abs_err;
+			e.worstX = x[i];
+		}
+		e.maxRel = max(e.maxRel, rel_err);
+	}
+	return e;
+}
+
+
+int main()
+{
+	normal_distribution<> standard_normal(0.0, 1.0);
+
+	vector<Region> regions;
+	regions.push_back({ "|x| <= 7.07 (uniform)", Uniform(-7.07, 7.07, 2000001) });
+	regions.push_back({ "7.07 < |x| <= 37.5 (uniform)", Uniform(7.07, 37.5, 500001) });
+	regions.back().x.insert(regions.back().x.end(), regions.back().x.begin(), regions.back().x.end());
+	for (size_t i = 0; i < regions.back().x.size() / 2; ++i)
+	{
+		regions.back().x[i] = -regions.back().x[i];
+	}
+	regions.push_back({ "1e-300 <= |x| <= 1e300 (log)", Logarithmic(1e-300, 1e300, 200001) });
+	regions.push_back({ "special values", { 0.0, -0.0, numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(),
+		numeric_limits<double>::max(), -numeric_limits<double>::max(), numeric_limits<double>::denorm_min() } });
+
+	const Numerics::NormalTier tiers[] = { Numerics::NormalTier::Fast, Numerics::NormalTier::Accurate, Numerics::NormalTier::Exact };
+	const string tierNames[] = { "N(x) Fast", "N(x) Accurate", "N(x) Exact" };
+
+	cout << "Accuracy of the Numerics.hpp Gaussian functions against boost::math::normal_distribution" << endl;
+	cout << "(relative errors are measured where the boost value is a normal double)" << endl << endl;
+	cout << left << setw(32) << "Region" << setw(16) << "Function" << setw(14) << "max abs" << setw(14) << "max rel"
+		<< setw(16) << "worst x" << "packed - scalar" << endl;
+
+	double max_packed_diff = 0.0;
+	for (const Region& region : regions)
+	{
+		const vector<double>& x = region.x;
+		vector<double> cdf_exact(x.size()), pdf_exact(x.size());
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			double xc = isinf(x[i]) ? copysign(numeric_limits<double>::max(), x[i]) : x[i];		//	boost rejects infinities
+			cdf_exact[i] = cdf(standard_normal, xc);
+			pdf_exact[i] = pdf(standard_normal, xc);
+		}
+
+		for (int t = 0; t < 4; ++t)
+		{
+			vector<double> scalar(x.size()), packed(x.size());
+			if (t < 3)
+			{
+				for (size_t i = 0; i < x.size(); ++i)
+				{
+					scalar[i] = (t == 0) ? Numerics::NormalCdf<Numerics::NormalTier::Fast>(x[i])
+						: ((t == 1) ? Numerics::NormalCdf<Numerics::NormalTier::Accurate>(x[i]) : Numerics::NormalCdf<Numerics::NormalTier::Exact>(x[i]));
+				}
+				Numerics::NormalCdf(x.data(), packed.data(), x.size(), tiers[t]);
+			}
+			else
+			{
+				for (size_t i = 0; i < x.size(); ++i)
+				{
+					scalar[i] = Numerics::NormalPdf(x[i]);
+				}
+				Numerics::NormalPdf(x.data(), packed.data(), x.size());
+			}
+
+			double packed_diff = 0.0;
+			for (size_t i = 0; i < x.size(); ++i)
+			{
+				packed_diff = (isnan(scalar[i]) && isnan(packed[i])) ? packed_diff : max(packed_diff, fabs(scalar[i] - packed[i]));
+			}
+			packed_diff = (packed_diff == packed_diff) ? packed_diff : numeric_limits<double>::infinity();
+			max_packed_diff = max(max_packed_diff, packed_diff);
+
+			Errors e = Compare(x, scalar, (t < 3) ? cdf_exact : pdf_exact);
+			cout << left << setw(32) << region.name << setw(16) << ((t < 3) ? tierNames[t] : "n(x)")
+				<< setw(14) << setprecision(3) << scientific << e.maxAbs << setw(14) << e.maxRel
+				<< setw(16) << setprecision(6) << defaultfloat << e.worstX << setprecision(3) << scientific << packed_diff << defaultfloat << endl;
+		}
+	}
+
+	//	The packed forms must agree with the scalar forms to rounding
+	return (max_packed_diff <= 1e-15) ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// Converts a CSV book into a binary portfolio file
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/PortfolioConvert.cpp PortfolioFile.cpp PortfolioCsv.cpp PortfolioStore.cpp
+//			ScenarioKernels.cpp PortfolioPricer.cpp Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp
+//			BarrierOption.cpp DigitalOption.cpp AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp
+//			AmericanApproxOption.cpp ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o PortfolioConvert
+//
+//	Usage:
+//		PortfolioConvert book.csv book.bin		reads the CSV (PortfolioCsv.hpp) and writes the binary file (PortfolioFile.hpp)
+//		PortfolioConvert --sample n book.csv	writes a random book of n positions, spread over the nine products
+//
+//	A conversion reports the positions of each partition, the time to read the CSV and to write the file, and the
+//	time to map the file back and value it.
+
+
+#include "PortfolioFile.hpp"
+#include "PortfolioCsv.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//	Random book of n positions, the products in turn
+static PortfolioStore Sample(const size_t n)
+{
+	mt19937_64 generator(29);
+	uniform_real_distribution<double> u(0.0, 1.0);
+
+	PortfolioStore store;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double S = 60.0 + 80.0 * u(generator), K = 80.0 + 40.0 * u(generator), T = 0.1 + 1.9 * u(generator);
+		const double r = 0.01 + 0.05 * u(generator), sig = 0.1 + 0.4 * u(generator), b = r - 0.03 * u(generator);
+		const OptionType type = (u(generator) < 0.5) ? OptionType::Call : OptionType::Put;
+
+		Product contract;
+		switch (static_cast<StoreKind>(i % StoreKinds))
+		{
+		case StoreKind::Vanilla:
+			contract = EuropeanOption(S, K, T, r, sig, b, type);
+			break;
+		case StoreKind::Barrier:
+			contract = BarrierOption(S, 0.8 * S, K, 1.0, T, r, sig, b, type, (u(generator) < 0.5) ? BarrierType::Out : BarrierType::In);
+			break;
+		case StoreKind::Digital:
+			contract = DigitalOption(S, K, T, r, sig, b, type);
+			break;
+		case StoreKind::CashOrNothing:
+			contract = CashOrNothingOption(S, K, 10.0, T, r, sig, b, type);
+			break;
+		case StoreKind::AssetOrNothing:
+			contract = AssetOrNothingOption(S, K, T, r, sig, b, type);
+			break;
+		case StoreKind::Gap:
+			contract = GapOption(S, K, 0.95 * K, T, r, sig, b, type);
+			break;
+		case StoreKind::Chooser:
+			contract = ChooserOption(S, K, T, 0.5 * T, r, sig, b);
+			break;
+		case StoreKind::Asian:
+			contract = AsianGeometricOption(S, K, T, r, sig, b, type);
+			break;
+		case StoreKind::Perpetual:
+			contract = PerpetualAmericanOption(S, K, r, sig, r - 0.03, type);
+			break;
+		}
+		store.Add(contract, floor(-50.0 + 100.0 * u(generator)), i + 1);
+	}
+	return store;
+}
+
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		if (argc == 4 && string(argv[1]) == "--sample")
+		{
+			const size_t n = strtoull(argv[2], nullptr, 10);
+			double seconds = Time([&]() { WritePortfolioCsv(Sample(n), argv[3]); });
+			cout << "Wrote " << n << " positions to " << argv[3] << " in " << fixed << setprecision(2) << seconds << " s" << endl;
+			return 0;
+		}
+		if (argc != 3)
+		{
+			cerr << "Usage: " << argv[0] << " book.csv book.bin" << endl << "       " << argv[0] << " --sample n book.csv" << endl;
+			return 2;
+		}
+
+		PortfolioStore store;
+		double read = Time([&]() { store = ReadPortfolioCsv(argv[1]); });
+		double write = Time([&]() { WritePortfolioFile(store, argv[2]); });
+
+		cout << left << setw(20) << "partition" << "positions" << right << endl;
+		for (size_t k = 0; k < StoreKinds; ++k)
+		{
+			const StoreKind kind = static_cast<StoreKind>(k);
+			cout << left << setw(20) << StoreKindName(kind) << store.Partition(kind).Size() << right << endl;
+		}
+
+		PortfolioPricer pricer;
+		MappedPortfolio* mapped = nullptr;
+		double value = 0.0;
+		double open = Time([&]() { mapped = new MappedPortfolio(argv[2]); });
+		double price = Time([&]() { value = pricer.Value(mapped->Views()); });
+
+		cout << endl << fixed << setprecision(3) << "Read CSV: " << read << " s, wrote " << argv[2] << ": " << write << " s ("
+			<< mapped->Header().FileBytes << " bytes)" << endl;
+		cout << "Mapped: " << 1e3 * open << " ms, valued on " << pricer.Threads() << " threads: " << 1e3 * price << " ms, value "
+			<< setprecision(4) << value << endl;
+
+		delete mapped;
+	}
+	catch (const exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+// Columnar PortfolioStore against a vector<Product>, partition by partition
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/PortfolioStoreBenchmark.cpp PortfolioPricer.cpp PortfolioStore.cpp ScenarioKernels.cpp
+//			Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp BarrierOption.cpp DigitalOption.cpp
+//			AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp AmericanApproxOption.cpp
+//			ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o PortfolioStoreBenchmark
+//
+//	A book of 2,016,000 random positions, an equal number of each of the nine products the store partitions, is held
+//	both as a vector<Product> and as a PortfolioStore. Each partition is priced on the calling thread through the
+//	variant (one Price call per position) and through its batch kernel; the report gives the time per position, the
+//	bytes per position of each layout and the largest relative difference. A last line values the whole book on a
+//	pool with one thread per hardware thread.
+
+
+#include "PortfolioStore.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//	Bytes of the columns a partition fills, per row
+static double BytesPerRow(const StorePartition& p)
+{
+	size_t bytes = 0;
+	for (const DoubleColumn* column : { &p.S, &p.K, &p.T, &p.r, &p.sig, &p.b, &p.K2, &p.H, &p.cr, &p.t, &p.Quantity })
+	{
+		bytes += column->size() * sizeof(double);
+	}
+	bytes += (p.isCall.size() + p.isOut.size()) * sizeof(int) + p.TradeId.size() * sizeof(uint64_t);
+	return static_cast<double>(bytes) / p.Size();
+}
+
+
+int main()
+{
+	const size_t perKind = 224000;
+
+	mt19937_64 generator(23);
+	uniform_real_distribution<double> u(0.0, 1.0);
+
+	vector<Product> books[StoreKinds];
+	vector<Product> portfolio;
+	vector<double> quantities;
+	PortfolioStore store;
+	uint64_t id = 0;
+
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		store.Partition(static_cast<StoreKind>(k)).Reserve(perKind);
+		books[k].reserve(perKind);
+		for (size_t i = 0; i < perKind; ++i)
+		{
+			const double S = 60.0 + 80.0 * u(generator), K = 80.0 + 40.0 * u(generator), T = 0.1 + 1.9 * u(generator);
+			const double r = 0.01 + 0.05 * u(generator), sig = 0.1 + 0.4 * u(generator), b = r - 0.03 * u(generator);
+			const OptionType type = (u(generator) < 0.5) ? OptionType::Call : OptionType::Put;
+
+			Product contract;
+			switch (static_cast<StoreKind>(k))
+			{
+			case StoreKind::Vanilla:
+				contract = EuropeanOption(S, K, T, r, sig, b, type);
+				break;
+			case StoreKind::Barrier:
+				contract = BarrierOption(S, 0.8 * S * (0.9 + 0.1 * u(generator)), K, 2.0 * u(generator), T, r, sig, b, type,
+					(u(generator) < 0.5) ? BarrierType::Out : BarrierType::In);
+				break;
+			case StoreKind::Digital:
+				contract = DigitalOption(S, K, T, r, sig, b, type);
+				break;
+			case StoreKind::CashOrNothing:
+				contract = CashOrNothingOption(S, K, 10.0, T, r, sig, b, type);
+				break;
+			case StoreKind::AssetOrNothing:
+				contract = AssetOrNothingOption(S, K, T, r, sig, b, type);
+				break;
+			case StoreKind::Gap:
+				contract = GapOption(S, K, K * (0.9 + 0.2 * u(generator)), T, r, sig, b, type);
+				break;
+			case StoreKind::Chooser:
+				contract = ChooserOption(S, K, T, T * u(generator), r, sig, b);
+				break;
+			case StoreKind::Asian:
+				contract = AsianGeometricOption(S, K, T, r, sig, b, type);
+				break;
+			case StoreKind::Perpetual:
+				contract = PerpetualAmericanOption(S, K, r, sig, r - 0.02 - 0.03 * u(generator), type);
+				break;
+			}
+
+			const double quantity = floor(-50.0 + 100.0 * u(generator));
+			books[k].push_back(contract);
+			portfolio.push_back(contract);
+			quantities.push_back(quantity);
+			store.Add(contract, quantity, ++id);
+		}
+	}
+
+	PortfolioPricer serial(0, 256);
+	cout << "Positions: " << store.Size() << ", sizeof(Product) = " << sizeof(Product) << " bytes" << endl << endl;
+	cout << left << setw(20) << "partition" << setw(14) << "variant ns" << setw(12) << "batch ns" << setw(10) << "speedup"
+		<< setw(14) << "variant B" << setw(10) << "store B" << "max rel. difference" << right << endl;
+
+	for (size_t k = 0; k < StoreKinds; ++k)
+	{
+		const StoreKind kind = static_cast<StoreKind>(k);
+		vector<double> variant(perKind), batch(perKind);
+		double variantTime = Time([&]() { serial.Price(books[k].data(), variant.data(), perKind); });
+		double batchTime = Time([&]() { serial.Price(store, kind, batch.data()); });
+
+		double difference = 0.0;
+		for (size_t i = 0; i < perKind; ++i)
+		{
+			difference = max(difference, fabs(batch[i] - variant[i]) / max(1.0, fabs(variant[i])));
+		}
+
+		cout << left << fixed << setprecision(1) << setw(20) << StoreKindName(kind) << setw(14) << 1e9 * variantTime / perKind << setw(12)
+			<< 1e9 * batchTime / perKind << setprecision(2) << setw(10) << variantTime / batchTime << setprecision(0) << setw(14)
+			<< static_cast<double>(sizeof(Product)) + sizeof(double) << setw(10) << BytesPerRow(store.Partition(kind))
+			<< scientific << setprecision(2) << difference << right << endl;
+	}
+
+	PortfolioPricer pricer;
+	double variantValue = 0.0, storeValue = 0.0;
+	double variantTime = Time([&]() { variantValue = pricer.Value(portfolio, quantities); });
+	double storeTime = Time([&]() { storeValue = pricer.Value(store); });
+
+	cout << endl << fixed << setprecision(1) << "Book value on " << pricer.Threads() << " threads: variant " << setprecision(4)
+		<< variantValue << " in " << setprecision(1) << 1e3 * variantTime << " ms, store " << setprecision(4) << storeValue << " in "
+		<< setprecision(1) << 1e3 * storeTime << " ms" << endl;
+
+	return 0;
+}
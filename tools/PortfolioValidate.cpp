@@ -0,0 +1,172 @@
+// Validates a binary portfolio file
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/PortfolioValidate.cpp PortfolioFile.cpp PortfolioCsv.cpp PortfolioStore.cpp
+//			ScenarioKernels.cpp PortfolioPricer.cpp Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp
+//			BarrierOption.cpp DigitalOption.cpp AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp
+//			AmericanApproxOption.cpp ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o PortfolioValidate
+//
+//	Usage:
+//		PortfolioValidate book.bin [book.csv]
+//
+//	Opens the file (which checks the header, its checksum and the section table), prints the header and the section
+//	table, and checks every section: its checksum, finite terms with positive S, K and sig and non-negative T, flags
+//	of 0 or 1 and trade IDs that are unique across the file. With a CSV, every column must also equal the book read
+//	from it, and both must have the same value. Exits with 0 if the file is valid and 1 otherwise.
+
+
+#include "PortfolioFile.hpp"
+#include "PortfolioCsv.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+
+//	Faults found in one partition; each is printed
+static size_t CheckTerms(const PartitionView& view)
+{
+	size_t faults = 0;
+	auto fault = [&faults, &view](const string& what, const size_t i)
+	{
+		if (++faults <= 5)
+		{
+			cout << "  " << StoreKindName(view.Kind) << " row " << i << ": " << what << endl;
+		}
+	};
+
+	for (size_t i = 0; i < view.Rows; ++i)
+	{
+		const double* terms[] = { view.S, view.K, view.T, view.r, view.sig, view.b, view.K2, view.H, view.cr, view.t, view.Quantity };
+		bool finite = true;
+		for (const double* column : terms)
+		{
+			finite = finite && (column == nullptr || isfinite(column[i]));
+		}
+		if (!finite)
+		{
+			fault("term not finite", i);
+		}
+		if (!(view.S[i] > 0.0 && view.K[i] > 0.0 && view.sig[i] > 0.0))
+		{
+			fault("S, K and sig must be positive", i);
+		}
+		if (view.T != nullptr && !(view.T[i] >= 0.0))
+		{
+			fault("negative T", i);
+		}
+		if ((view.isCall != nullptr && (view.isCall[i] & ~1)) || (view.isOut != nullptr && (view.isOut[i] & ~1)))
+		{
+			fault("flag other than 0 or 1", i);
+		}
+	}
+	return faults;
+}
+
+//	Faults between a column of the file and the same column of the store
+template <class T, class Column>
+static size_t Compare(const T* mapped, const Column& column, const size_t rows)
+{
+	if (column.size() != rows)
+	{
+		return (mapped == nullptr && column.empty()) ? 0 : 1;
+	}
+	return (rows == 0 || memcmp(mapped, column.data(), rows * sizeof(T)) == 0) ? 0 : 1;
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc != 2 && argc != 3)
+	{
+		cerr << "Usage: " << argv[0] << " book.bin [book.csv]" << endl;
+		return 2;
+	}
+
+	try
+	{
+		MappedPortfolio portfolio(argv[1]);
+		const PortfolioFileHeader& header = portfolio.Header();
+
+		cout << argv[1] << ": version " << header.Version << ", " << header.Positions << " positions, " << header.FileBytes
+			<< " bytes, header checksum " << hex << setw(16) << setfill('0') << header.Checksum << dec << setfill(' ') << " ok" << endl;
+		cout << left << setw(20) << "section" << setw(12) << "rows" << setw(14) << "offset" << setw(14) << "bytes"
+			<< "checksum" << right << endl;
+
+		size_t faults = 0;
+		vector<uint64_t> ids;
+		ids.reserve(portfolio.Size());
+
+		for (size_t k = 0; k < StoreKinds; ++k)
+		{
+			const StoreKind kind = static_cast<StoreKind>(k);
+			const PortfolioFileSection& section = portfolio.Section(kind);
+			const bool verified = portfolio.Verify(kind);
+
+			cout << left << setw(20) << StoreKindName(kind) << setw(12) << section.Rows << setw(14) << section.Offset << setw(14)
+				<< section.Bytes << hex << setw(16) << setfill('0') << right << section.Checksum << dec << setfill(' ')
+				<< (verified ? " ok" : " MISMATCH") << endl;
+
+			faults += verified ? 0 : 1;
+			faults += CheckTerms(portfolio.Partition(kind));
+
+			const PartitionView& view = portfolio.Partition(kind);
+			ids.insert(ids.end(), view.TradeId, view.TradeId + view.Rows);
+		}
+
+		sort(ids.begin(), ids.end());
+		const size_t duplicates = ids.size() - (unique(ids.begin(), ids.end()) - ids.begin());
+		if (duplicates > 0)
+		{
+			cout << duplicates << " duplicate trade IDs" << endl;
+			faults += duplicates;
+		}
+
+		PortfolioPricer pricer;
+		const double value = pricer.Value(portfolio.Views());
+		cout << "Value: " << fixed << setprecision(6) << value << endl;
+
+		if (argc == 3)
+		{
+			PortfolioStore store = ReadPortfolioCsv(argv[2]);
+			size_t differences = 0;
+			for (size_t k = 0; k < StoreKinds; ++k)
+			{
+				const StoreKind kind = static_cast<StoreKind>(k);
+				const PartitionView& v = portfolio.Partition(kind);
+				const StorePartition& p = store.Partition(kind);
+				const size_t n = v.Rows;
+
+				size_t different = (p.Size() != n) ? 1 : Compare(v.S, p.S, n) + Compare(v.K, p.K, n) + Compare(v.T, p.T, n)
+					+ Compare(v.r, p.r, n) + Compare(v.sig, p.sig, n) + Compare(v.b, p.b, n) + Compare(v.K2, p.K2, n) + Compare(v.H, p.H, n)
+					+ Compare(v.cr, p.cr, n) + Compare(v.t, p.t, n) + Compare(v.isCall, p.isCall, n) + Compare(v.isOut, p.isOut, n)
+					+ Compare(v.Quantity, p.Quantity, n) + Compare(v.TradeId, p.TradeId, n);
+				if (different > 0)
+				{
+					cout << "  " << StoreKindName(kind) << ": " << different << " columns differ from " << argv[2] << endl;
+				}
+				differences += different;
+			}
+
+			const double csvValue = pricer.Value(store);
+			cout << "CSV value: " << csvValue << ((csvValue == value) ? " (same)" : " (DIFFERENT)") << endl;
+			faults += differences + ((csvValue == value) ? 0 : 1);
+		}
+
+		cout << ((faults == 0) ? "Valid" : "Invalid: " + to_string(faults) + " faults") << endl;
+		return (faults == 0) ? 0 : 1;
+	}
+	catch (const exception& e)
+	{
+		cout << e.what() << endl << "Invalid" << endl;
+		return 1;
+	}
+}
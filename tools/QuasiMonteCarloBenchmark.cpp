@@ -0,0 +1,131 @@
+// Root mean square error against time of quasi-Monte Carlo (Sobol) and plain Monte Carlo
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/QuasiMonteCarloBenchmark.cpp AsianArithmeticOption.cpp AsianGeometricOption.cpp
+//			BarrierMonteCarlo.cpp BarrierOption.cpp Option.cpp MonteCarlo.cpp Numerics.cpp Random.cpp Sobol.cpp
+//			BrownianBridge.cpp ThreadPool.cpp -o QuasiMonteCarloBenchmark
+//	and run as QuasiMonteCarloBenchmark [threads] [replications] (one thread per hardware thread and 16 by default).
+//
+//	Two path-dependent products with 64 time steps, the first consumers of the Sobol sampling:
+//	->	an arithmetic Asian call with 64 fixings
+//	->	an up-and-out call monitored on 64 dates (BarrierMonitoring::Discrete)
+//	each priced with 2^10 to 2^18 paths by
+//	->	plain Monte Carlo (Philox)
+//	->	scrambled Sobol points with the paths built step by step
+//	->	scrambled Sobol points with the paths built by Brownian bridge
+//	Antithetic variates and control variates are off, so that only the sampling differs. Every estimator is
+//	unbiased, and its RMSE is measured over independent replications (seeds) against a reference price from
+//	replications of the Sobol bridge estimator with 2^20 paths. Speedup is the ratio of the times the plain Monte
+//	Carlo and the Sobol bridge estimators need for the same RMSE, (rmse_MC / rmse_QMC)^2 time_MC / time_QMC.
+
+
+#include "AsianArithmeticOption.hpp"
+#include "BarrierMonteCarlo.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+using namespace std;
+
+
+//	RMSE against reference, and seconds per estimate, of replications of price(settings)
+struct Measurement
+{
+	double Rmse;
+	double Seconds;
+};
+
+static Measurement Measure(const function<double(const MonteCarloSettings&)>& price, MonteCarloSettings settings,
+	const size_t replications, const double reference)
+{
+	double squares = 0.0;
+	auto start = chrono::steady_clock::now();
+	for (size_t rep = 0; rep < replications; ++rep)
+	{
+		settings.Seed = 1000 + rep;
+		double error = price(settings) - reference;
+		squares += error * error;
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	Measurement m = { sqrt(squares / static_cast<double>(replications)), seconds / static_cast<double>(replications) };
+	return m;
+}
+
+static void Report(const string& name, const function<double(const MonteCarloSettings&)>& price, const size_t replications)
+{
+	MonteCarloSettings plain;
+	plain.Antithetic = false;
+	plain.ControlVariate = false;
+
+	MonteCarloSettings sobol = plain;
+	sobol.Sampling = SamplingMethod::Sobol;
+	sobol.Bridge = false;
+
+	MonteCarloSettings bridge = sobol;
+	bridge.Bridge = true;
+
+	//	Reference: replications of the best estimator with 2^20 paths, seeds apart from those measured
+	double reference = 0.0;
+	bridge.Paths = size_t(1) << 20;
+	for (size_t rep = 0; rep < replications; ++rep)
+	{
+		bridge.Seed = 1 + rep;
+		reference += price(bridge);
+	}
+	reference /= static_cast<double>(replications);
+
+	cout << endl << name << ", reference " << setprecision(6) << reference << endl;
+	cout << left << setw(10) << "paths" << setw(24) << "Monte Carlo" << setw(24) << "Sobol" << setw(24) << "Sobol + bridge"
+		<< "speedup" << endl;
+	cout << setw(10) << "" << setw(12) << "rmse" << setw(12) << "ms" << setw(12) << "rmse" << setw(12) << "ms"
+		<< setw(12) << "rmse" << setw(12) << "ms" << right << endl;
+
+	for (size_t log2 = 10; log2 <= 18; ++log2)
+	{
+		plain.Paths = sobol.Paths = bridge.Paths = size_t(1) << log2;
+
+		Measurement mc = Measure(price, plain, replications, reference);
+		Measurement qmc = Measure(price, sobol, replications, reference);
+		Measurement bb = Measure(price, bridge, replications, reference);
+
+		double ratio = mc.Rmse / bb.Rmse;
+		cout << left << setw(10) << plain.Paths << scientific << setprecision(2)
+			<< setw(12) << mc.Rmse << fixed << setprecision(3) << setw(12) << 1e3 * mc.Seconds << scientific << setprecision(2)
+			<< setw(12) << qmc.Rmse << fixed << setprecision(3) << setw(12) << 1e3 * qmc.Seconds << scientific << setprecision(2)
+			<< setw(12) << bb.Rmse << fixed << setprecision(3) << setw(12) << 1e3 * bb.Seconds << setprecision(1)
+			<< ratio * ratio * mc.Seconds / bb.Seconds << right << endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	ThreadPool pool((argc > 1) ? static_cast<size_t>(atoi(argv[1])) : thread::hardware_concurrency());
+	const size_t replications = (argc > 2) ? static_cast<size_t>(atoi(argv[2])) : 16;
+
+	cout << fixed;
+	cout << "Quasi-Monte Carlo against plain Monte Carlo, " << pool.Size() << " worker thread(s), " << replications
+		<< " replications, no antithetic or control variates" << endl;
+
+	AsianArithmeticOption asian(100.0, 100.0, 1.0, 0.05, 0.2, 0.05, 64, OptionType::Call);
+	Report("Arithmetic Asian call, S = 100, K = 100, T = 1, r = b = 0.05, sig = 0.2, 64 fixings",
+		[&](const MonteCarloSettings& settings) { return asian.Price(settings, pool).Price; }, replications);
+
+	BarrierOption barrier(100.0, 120.0, 100.0, 0.0, 1.0, 0.05, 0.2, 0.05, OptionType::Call, BarrierType::Out);
+	Report("Up-and-out call, S = 100, H = 120, K = 100, T = 1, r = b = 0.05, sig = 0.2, 64 monitoring dates",
+		[&](const MonteCarloSettings& settings)
+		{
+			return BarrierMonteCarloPrice(barrier, BarrierMonitoring::Discrete, 64, settings, pool).Price;
+		}, replications);
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+// Tick-to-price latency of the repricing service
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/RepricingBenchmark.cpp RepricingService.cpp PortfolioPricer.cpp PortfolioStore.cpp
+//			ScenarioKernels.cpp Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp BarrierOption.cpp
+//			DigitalOption.cpp AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp
+//			AmericanApproxOption.cpp ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o RepricingBenchmark
+//
+//	Usage:
+//		RepricingBenchmark [producers]		(default 2)
+//
+//	20,000 positions (vanilla, digital, barrier and gap options) over 200 underlyings. Each producer thread
+//	publishes spot moves (one in ten also moves the vol) for random underlyings: for two seconds at each of two paced
+//	rates, then 200,000 as fast as it can. One consumer thread polls the prices. The report gives the updates
+//	published and rejected (retried), how many were coalesced, the repricings and prices dropped, and the
+//	tick-to-price latency percentiles. A last check compares the final price of every position with a full
+//	repricing of its contract.
+
+
+#include "RepricingService.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+
+int main(int argc, char* argv[])
+{
+	const size_t producers = (argc > 1) ? max<size_t>(1, strtoul(argv[1], nullptr, 10)) : 2;
+	const size_t positionCount = 20000, underlyingCount = 200;
+
+	//	Positions, round robin over the underlyings, which all start at 100
+	mt19937_64 generator(31);
+	uniform_real_distribution<double> u(0.0, 1.0);
+	vector<Position> positions;
+	vector<uint32_t> underlying;
+	for (size_t i = 0; i < positionCount; ++i)
+	{
+		const double K = 80.0 + 40.0 * u(generator), T = 0.1 + 1.9 * u(generator);
+		const OptionType type = (u(generator) < 0.5) ? OptionType::Call : OptionType::Put;
+		Product contract;
+		switch (i % 4)
+		{
+		case 0:
+			contract = EuropeanOption(100.0, K, T, 0.05, 0.2, 0.03, type);
+			break;
+		case 1:
+			contract = DigitalOption(100.0, K, T, 0.05, 0.2, 0.03, type);
+			break;
+		case 2:
+			contract = BarrierOption(100.0, 70.0, K, 1.0, T, 0.05, 0.2, 0.03, type, BarrierType::Out);
+			break;
+		default:
+			contract = GapOption(100.0, K, 0.95 * K, T, 0.05, 0.2, 0.03, type);
+			break;
+		}
+		positions.push_back(Position{ contract, 1.0, "Flow" });
+		underlying.push_back(static_cast<uint32_t>(i % underlyingCount));
+	}
+
+	cout << positionCount << " positions over " << underlyingCount << " underlyings, " << producers << " producers, "
+		<< thread::hardware_concurrency() << " hardware threads" << endl << endl;
+	cout << left << setw(10) << "rate/s" << setw(12) << "published" << setw(10) << "rejected" << setw(11) << "coalesced"
+		<< setw(11) << "repriced" << setw(9) << "dropped" << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us"
+		<< setw(10) << "p99.9 us" << "max us" << right << endl;
+
+	//	0 = as fast as possible
+	for (const double rate : { 2000.0, 20000.0, 0.0 })
+	{
+		const size_t updatesPerProducer = (rate > 0.0) ? static_cast<size_t>(2.0 * rate) : 200000;
+		RepricingService service(positions, underlying, 1 << 16);
+		vector<double> last(positionCount, nan(""));
+		atomic<bool> done(false);
+
+		service.Start();
+		thread consumer([&]()
+		{
+			PriceUpdate price;
+			for (;;)
+			{
+				const bool finished = done.load();
+				bool any = false;
+				while (service.Poll(price))
+				{
+					last[price.Position] = price.Price;
+					any = true;
+				}
+				if (finished && !any)
+				{
+					return;
+				}
+				if (!any)
+				{
+					this_thread::yield();
+				}
+			}
+		});
+
+		vector<thread> threads;
+		for (size_t p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&service, p, rate, updatesPerProducer, underlyingCount]()
+			{
+				mt19937_64 random(100 + p);
+				uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(underlyingCount - 1));
+				normal_distribution<double> z(0.0, 1.0);
+				vector<double> spots(underlyingCount, 100.0);
+
+				const int64_t start = RepricingService::Now();
+				const double interval = (rate > 0.0) ? 1e9 / rate : 0.0;
+				for (size_t i = 0; i < updatesPerProducer; ++i)
+				{
+					//	paced: wait for the due time of update i
+					while (interval > 0.0 && RepricingService::Now() - start < static_cast<int64_t>(i * interval))
+					{
+						this_thread::yield();
+					}
+
+					MarketUpdate update{ pick(random), MarketSpot, 0.0, 0.0, 0.0, 0 };
+					spots[update.Underlying] *= exp(1e-3 * z(random));
+					update.Spot = spots[update.Underlying];
+					if (i % 10 == 0)
+					{
+						update.Fields |= MarketVol;
+						update.Vol = 0.2 + 0.02 * z(random);
+					}
+					while (!service.Publish(update))
+					{
+						this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (thread& t : threads)
+		{
+			t.join();
+		}
+		service.Stop();
+		done.store(true);
+		consumer.join();
+
+		//	The last price of each position against its contract as the service left it
+		double difference = 0.0;
+		for (size_t i = 0; i < positionCount; ++i)
+		{
+			if (!isnan(last[i]))
+			{
+				difference = max(difference, fabs(last[i] - Price(service.Contract(i))));
+			}
+		}
+
+		const ServiceStats stats = service.Stats();
+		const LatencyHistogram latency = service.Latency();
+		cout << left << setw(10) << ((rate > 0.0) ? to_string(static_cast<int>(rate * producers)) : string("max")) << setw(12)
+			<< stats.Received << setw(10) << stats.Rejected << setw(11) << stats.Coalesced << setw(11) << stats.Repriced << setw(9)
+			<< stats.Dropped << fixed << setprecision(1) << setw(10) << 1e-3 * latency.Percentile(50.0) << setw(10)
+			<< 1e-3 * latency.Percentile(90.0) << setw(10) << 1e-3 * latency.Percentile(99.0) << setw(10) << 1e-3 * latency.Percentile(99.9)
+			<< 1e-3 * latency.Max() << right << "   (last prices within " << scientific << setprecision(1) << difference << ")"
+			<< defaultfloat << endl;
+	}
+
+	return 0;
+}
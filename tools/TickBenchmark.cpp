@@ -0,0 +1,118 @@
+// Tick repricing from cached Greeks against a full Price() on every tick
+//
+// (c) Sudhansh Dua
+//
+//	Build from the repository root:
+//		g++ -std=c++17 -O3 -pthread -I. tools/TickBenchmark.cpp TickRepricer.cpp PortfolioPricer.cpp PortfolioStore.cpp
+//			ScenarioKernels.cpp Option.cpp EuropeanOption.cpp PerpetualAmericanOption.cpp ChooserOption.cpp BarrierOption.cpp
+//			DigitalOption.cpp AssetOrNothingOption.cpp CashOrNothingOption.cpp AsianGeometricOption.cpp GapOption.cpp
+//			AmericanApproxOption.cpp ImpliedVolatility.cpp Numerics.cpp ThreadPool.cpp -o TickBenchmark
+//
+//	Each product follows 200,000 ticks of a random walk of the spot from 100, with a standard deviation of 1 basis
+//	point per tick, through TickRepricer under a range of settings. The report gives the share of ticks answered from
+//	the cache, the time per tick against Price() on every tick, and the largest and the mean absolute error against
+//	Price(), to choose MaxMove and ErrorBound for a latency budget.
+
+
+#include "TickRepricer.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+
+//	Seconds taken by f()
+template <class F>
+static double Time(F f)
+{
+	auto start = chrono::steady_clock::now();
+	f();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+int main()
+{
+	//	The ticks
+	const size_t ticks = 200000;
+	vector<double> spots(ticks);
+	mt19937_64 generator(42);
+	normal_distribution<double> z(0.0, 1.0);
+	double S = 100.0;
+	for (size_t i = 0; i < ticks; ++i)
+	{
+		S *= exp(1e-4 * z(generator));
+		spots[i] = S;
+	}
+
+	vector<pair<string, Product>> products =
+	{
+		{ "European call", EuropeanOption(100.0, 100.0, 0.5, 0.05, 0.2, 0.03, OptionType::Call) },
+		{ "Digital call", DigitalOption(100.0, 100.0, 0.5, 0.05, 0.2, 0.03, OptionType::Call) },
+		{ "Gap put", GapOption(100.0, 95.0, 100.0, 0.5, 0.05, 0.2, 0.03, OptionType::Put) },
+		{ "Down-and-out call", BarrierOption(100.0, 97.0, 100.0, 0.0, 0.5, 0.05, 0.2, 0.03, OptionType::Call, BarrierType::Out) },
+		{ "Chooser", ChooserOption(100.0, 100.0, 0.5, 0.25, 0.05, 0.2, 0.03) },
+		{ "American put (BAW)", AmericanApproxOption(100.0, 100.0, 0.5, 0.05, 0.2, 0.03,
+			AmericanApproximation::BaroneAdesiWhaley, OptionType::Put) },
+	};
+
+	const vector<TickSettings> settings = { TickSettings(0.001, 1e-6), TickSettings(0.005, 1e-5), TickSettings(0.01, 1e-4),
+		TickSettings(0.02, 1e-3) };
+
+	cout << ticks << " ticks of 1bp standard deviation from S = 100" << endl;
+	cout << fixed;
+
+	for (const auto& product : products)
+	{
+		//	Full repricing on every tick
+		vector<double> exact(ticks);
+		Product contract = product.second;
+		double fullSeconds = Time([&]()
+		{
+			for (size_t i = 0; i < ticks; ++i)
+			{
+				visit([&](auto& option) { option.S = spots[i]; }, contract);
+				exact[i] = ::Price(contract);
+			}
+		});
+
+		cout << endl << product.first << ": Price() " << setprecision(1) << 1e9 * fullSeconds / ticks << " ns per tick" << endl;
+		cout << left << setw(10) << "MaxMove" << setw(12) << "ErrorBound" << setw(10) << "hit rate" << setw(10) << "ns/tick"
+			<< setw(10) << "speedup" << setw(12) << "max error" << "mean error" << right << endl;
+
+		for (const TickSettings& setting : settings)
+		{
+			vector<double> prices(ticks);
+			TickRepricer repricer(product.second, setting);
+			repricer.ResetCounters();
+
+			double seconds = Time([&]()
+			{
+				for (size_t i = 0; i < ticks; ++i)
+				{
+					prices[i] = repricer.Tick(spots[i]);
+				}
+			});
+
+			double maxError = 0.0, meanError = 0.0;
+			for (size_t i = 0; i < ticks; ++i)
+			{
+				double error = fabs(prices[i] - exact[i]);
+				maxError = max(maxError, error);
+				meanError += error / ticks;
+			}
+
+			cout << left << setprecision(3) << setw(10) << setting.MaxMove << scientific << setprecision(0) << setw(12) << setting.ErrorBound
+				<< fixed << setprecision(3) << setw(10) << repricer.HitRate() << setprecision(1) << setw(10) << 1e9 * seconds / ticks
+				<< setw(10) << fullSeconds / seconds << scientific << setprecision(2) << setw(12) << maxError << meanError << fixed
+				<< right << endl;
+		}
+	}
+
+	return 0;
+}